@@ -19,7 +19,7 @@ void AssembledMinion::assemble(Collective* col, Item* item, Position pos) const
     col->addCreature(*c, traits);
     auto factory = (*c)->getGame()->getContentFactory();
     item->upgrade((*c)->getAttributes().automatonParts.transform(
-        [&](const ItemType& t) { return t.get(factory); }), factory);
+        [&](const ItemType& t) { return t.get((*c)->getRandom(), factory); }), factory);
     for (auto& e : effects)
       e.apply((*c)->getPosition(), nullptr);
     for (auto& a : (*c)->getAttributes().getAllAttr())
@@ -42,7 +42,7 @@ void AssembledMinion::assemble(Collective* col, Item* item, Position pos) const
             withoutPrefix.push_back(a.item.get());
           else
             withPrefix.push_back(a.item.get());
-      return Random.choose(!withoutPrefix.empty() ? withoutPrefix : withPrefix);
+      return (*c)->getRandom().choose(!withoutPrefix.empty() ? withoutPrefix : withPrefix);
     };
     for (auto& effect : item->getWeaponInfo().attackerEffect)
       getRandomPart()->applyPrefix(ItemPrefixes::AttackerEffect{effect}, factory);
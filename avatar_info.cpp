@@ -45,7 +45,7 @@ variant<AvatarInfo, AvatarMenuOption> getAvatarInfo(View* view,
   auto& creatureFactory = contentFactory->getCreatures();
   auto keeperCreatures = keeperCreatureInfos.transform([&](auto& elem) {
     return elem.second.creatureId.transform([&](auto& id) {
-      auto ret = creatureFactory.fromId(id, getPlayerTribeId(elem.second.tribeAlignment));
+      auto ret = creatureFactory.fromId(Random, id, getPlayerTribeId(elem.second.tribeAlignment));
       for (auto& trait : elem.second.specialTraits)
         applySpecialTrait(0_global, trait, ret.get(), contentFactory);
       return ret;
@@ -244,7 +244,7 @@ AvatarInfo getQuickGameAvatar(View* view, const vector<pair<string, KeeperCreatu
     CreatureFactory* creatureFactory) {
   AvatarInfo ret;
   auto& myKeeper = keeperCreatures[0].second;
-  ret.playerCreature = creatureFactory->fromId(myKeeper.creatureId[0], TribeId::getDarkKeeper());
+  ret.playerCreature = creatureFactory->fromId(Random, myKeeper.creatureId[0], TribeId::getDarkKeeper());
   if (!myKeeper.noLeader)
     ret.playerCreature->getName().setBare("Keeper");
   ret.playerCreature->getName().setFirst("Jollibrond"_s);
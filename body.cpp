@@ -109,10 +109,10 @@ void Body::setBodyParts(const EnumMap<BodyPart, int>& p) {
   bodyParts[BodyPart::BACK] = 1;
 }
 
-void Body::initializeIntrinsicAttack(const ContentFactory* factory) {
+void Body::initializeIntrinsicAttack(RandomGen& random, const ContentFactory* factory) {
   for (auto bodyPart : ENUM_ALL(BodyPart))
     for (auto& attack : intrinsicAttacks[bodyPart])
-      attack.initializeItem(factory);
+      attack.initializeItem(random, factory);
 }
 
 void Body::addIntrinsicAttack(BodyPart part, IntrinsicAttack attack) {
@@ -131,13 +131,13 @@ void Body::setHumanoid(bool h) {
   xhumanoid = h;
 }
 
-vector<pair<Item*, double>> Body::chooseRandomWeapon(vector<Item*> weapons, vector<double> multipliers) const {
+vector<pair<Item*, double>> Body::chooseRandomWeapon(RandomGen& random, vector<Item*> weapons, vector<double> multipliers) const {
   vector<pair<Item*, double>> ret;
   for (auto part : ENUM_ALL(BodyPart))
     for (auto& attack : intrinsicAttacks[part])
       if (numGood(part) > 0 && !attack.isExtraAttack && weapons.size() < multipliers.size())
         weapons.push_back(attack.item.get());
-  weapons = Random.permutation(weapons);
+  weapons = random.permutation(weapons);
   for (auto i : All(weapons))
     if (i < multipliers.size())
       ret.push_back({weapons[i], multipliers[i]});
@@ -213,7 +213,7 @@ bool Body::hasHealth(HealthType type, const ContentFactory* factory) const {
   return !noHealth && factory->bodyMaterials.at(material).healthType == type;
 }
 
-bool Body::isPartDamaged(BodyPart part, double damage, const ContentFactory* factory) const {
+bool Body::isPartDamaged(RandomGen& random, BodyPart part, double damage, const ContentFactory* factory) const {
   double strength = [&] {
     switch (part) {
       case BodyPart::WING: return 0.3;
@@ -225,19 +225,19 @@ bool Body::isPartDamaged(BodyPart part, double damage, const ContentFactory* fac
     }
   }();
   if (!hasAnyHealth(factory))
-    return Random.chance(damage / strength);
+    return random.chance(damage / strength);
   if (factory->bodyMaterials.at(material).canLoseBodyParts)
     return damage >= strength;
   else
     return false;
 }
 
-BodyPart Body::armOrWing() const {
+BodyPart Body::armOrWing(RandomGen& random) const {
   if (numGood(BodyPart::ARM) == 0)
     return BodyPart::WING;
   if (numGood(BodyPart::WING) == 0)
     return BodyPart::ARM;
-  return Random.choose({ BodyPart::WING, BodyPart::ARM }, {1, 1});
+  return random.choose({ BodyPart::WING, BodyPart::ARM }, {1, 1});
 }
 
 bool Body::isCritical(BodyPart part, const ContentFactory* factory) const {
@@ -283,20 +283,20 @@ void Body::clearLost(BodyPart part) {
   lostBodyParts[part] = 0;
 }
 
-optional<BodyPart> Body::getAnyGoodBodyPart() const {
+optional<BodyPart> Body::getAnyGoodBodyPart(RandomGen& random) const {
   vector<BodyPart> good;
   for (auto part : ENUM_ALL(BodyPart))
     if (numGood(part) > 0)
       good.push_back(part);
   if (good.empty())
     return none;
-  return Random.choose(good);
+  return random.choose(good);
 }
 
-optional<BodyPart> Body::getBodyPart(AttackLevel attack, bool flying, bool collapsed) const {
+optional<BodyPart> Body::getBodyPart(RandomGen& random, AttackLevel attack, bool flying, bool collapsed) const {
   auto best = [&] {
     if (flying)
-      return Random.choose({BodyPart::TORSO, BodyPart::HEAD, BodyPart::LEG, BodyPart::WING, BodyPart::ARM},
+      return random.choose({BodyPart::TORSO, BodyPart::HEAD, BodyPart::LEG, BodyPart::WING, BodyPart::ARM},
           {1, 1, 1, 2, 1});
     switch (attack) {
       case AttackLevel::HIGH:
@@ -305,12 +305,12 @@ optional<BodyPart> Body::getBodyPart(AttackLevel attack, bool flying, bool colla
          if (size == Size::SMALL || size == Size::MEDIUM || collapsed)
            return BodyPart::HEAD;
          else
-           return Random.choose({BodyPart::TORSO, armOrWing()}, {1, 1});
+           return random.choose({BodyPart::TORSO, armOrWing(random)}, {1, 1});
       case AttackLevel::LOW:
          if (size == Size::SMALL || collapsed)
-           return Random.choose({BodyPart::TORSO, armOrWing(), BodyPart::HEAD, BodyPart::LEG}, {1, 1, 1, 1});
+           return random.choose({BodyPart::TORSO, armOrWing(random), BodyPart::HEAD, BodyPart::LEG}, {1, 1, 1, 1});
          if (size == Size::MEDIUM)
-           return Random.choose({BodyPart::TORSO, armOrWing(), BodyPart::LEG}, {1, 1, 3});
+           return random.choose({BodyPart::TORSO, armOrWing(random), BodyPart::LEG}, {1, 1, 3});
          else
            return BodyPart::LEG;
     }
@@ -318,7 +318,7 @@ optional<BodyPart> Body::getBodyPart(AttackLevel attack, bool flying, bool colla
   if (numGood(best) > 0)
     return best;
   else
-    return getAnyGoodBodyPart();
+    return getAnyGoodBodyPart(random);
 }
 
 bool Body::healBodyParts(Creature* creature, int max) {
@@ -387,7 +387,8 @@ bool Body::injureBodyPart(Creature* creature, BodyPart part, bool drop) {
       game->getStatistics().add(StatId::CHOPPED_LIMB);
     else if (part == BodyPart::HEAD)
       game->getStatistics().add(StatId::CHOPPED_HEAD);
-    if (auto item = getBodyPartItem(creature->getAttributes().getName().bare(), part, factory)) {
+    if (auto item = getBodyPartItem(creature->getRandom(), creature->getAttributes().getName().bare(), part,
+        factory)) {
       if (material == BodyMaterialId("FLESH") && game->effectFlags.count("abomination_upgrades")) {
         auto upgrade = droppedPartUpgrade.value_or_f(&getDefaultBodyPartUpgrade);
         setBodyPartUpgrade(item.get(), part, std::move(upgrade), factory);
@@ -534,20 +535,21 @@ bool Body::canPickUpItems() const {
   return xCanPickUpItems || isHumanoid();
 }
 
-static int numCorpseItems(Body::Size size) {
+static int numCorpseItems(RandomGen& random, Body::Size size) {
   switch (size) {
-    case Body::Size::LARGE: return Random.get(30, 50);
-    case Body::Size::HUGE: return Random.get(80, 120);
-    case Body::Size::MEDIUM: return Random.get(15, 30);
-    case Body::Size::SMALL: return Random.get(1, 8);
+    case Body::Size::LARGE: return random.get(30, 50);
+    case Body::Size::HUGE: return random.get(80, 120);
+    case Body::Size::MEDIUM: return random.get(15, 30);
+    case Body::Size::SMALL: return random.get(1, 8);
   }
 }
 
-PItem Body::getBodyPartItem(const string& name, BodyPart part, const ContentFactory* factory) const {
+PItem Body::getBodyPartItem(RandomGen& random, const string& name, BodyPart part,
+    const ContentFactory* factory) const {
   if (material == BodyMaterialId("FLESH") || material == BodyMaterialId("UNDEAD_FLESH"))
     return ItemType::severedLimb(name, part, weight / 8, isFarmAnimal() ? ItemClass::FOOD : ItemClass::CORPSE, factory);
   if (auto& t = factory->bodyMaterials.at(material).bodyPartItem)
-    return t->get(factory);
+    return t->get(random, factory);
   return nullptr;
 }
 
@@ -564,7 +566,7 @@ static bool bodyPartCanBeDropped(BodyPart part) {
   }
 }
 
-vector<PItem> Body::getCorpseItems(const string& name, Creature::Id id, bool instantlyRotten, const ContentFactory* factory,
+vector<PItem> Body::getCorpseItems(RandomGen& random, const string& name, Creature::Id id, bool instantlyRotten, const ContentFactory* factory,
     Game* game) const {
   vector<PItem> ret = [&] {
     if (material == BodyMaterialId("FLESH") || material == BodyMaterialId("UNDEAD_FLESH"))
@@ -575,16 +577,16 @@ vector<PItem> Body::getCorpseItems(const string& name, Creature::Id id, bool ins
                 numBodyParts(BodyPart::HEAD) > 0, false},
             corpseIngredientType));
     if (auto& t = factory->bodyMaterials.at(material).bodyPartItem)
-      return t->get(numCorpseItems(size), factory);
+      return t->get(random, numCorpseItems(random, size), factory);
     return vector<PItem>();
   }();
   if (!drops.empty())
-    if (auto item = Random.choose(drops))
-      ret.push_back(item->get(factory));
+    if (auto item = random.choose(drops))
+      ret.push_back(item->get(random, factory));
   if (game && droppedPartUpgrade && game->effectFlags.count("abomination_upgrades"))
-    for (auto part : Random.permutation<BodyPart>())
+    for (auto part : random.permutation<BodyPart>())
       if (numGood(part) > 0 && bodyPartCanBeDropped(part))
-        if (auto item = getBodyPartItem(name, part, game->getContentFactory())) {
+        if (auto item = getBodyPartItem(random, name, part, game->getContentFactory())) {
           setBodyPartUpgrade(item.get(), part, std::move(*droppedPartUpgrade), factory);
           ret.push_back(std::move(item));
           break;
@@ -610,14 +612,14 @@ static void youHit(const Creature* c, BodyPart part, const Attack& attack, const
             case AttackType::CRUSH: c->you(MsgType::YOUR, "spine is crushed!"); break;
             case AttackType::HIT: c->you(MsgType::YOUR, "neck is broken!"); break;
             case AttackType::STAB: c->you(MsgType::ARE, "stabbed in the "_s +
-                                       Random.choose("back"_s, "neck"_s)); break;
+                                       c->getRandom().choose("back"_s, "neck"_s)); break;
             case AttackType::SPELL: c->you(MsgType::ARE, "ripped to pieces!"); break;
           }
           break;
       case BodyPart::HEAD:
           switch (attack.type) {
             case AttackType::SHOOT: c->you(MsgType::ARE, "shot in the " +
-                                        Random.choose("eye"_s, "neck"_s, "forehead"_s) + "!"); break;
+                                        c->getRandom().choose("eye"_s, "neck"_s, "forehead"_s) + "!"); break;
             case AttackType::BITE: c->you(MsgType::YOUR, "head is bitten off!"); break;
             case AttackType::CUT: c->you(MsgType::YOUR, "head is chopped off!"); break;
             case AttackType::CRUSH: c->you(MsgType::YOUR, "skull is shattered!"); break;
@@ -632,7 +634,7 @@ static void youHit(const Creature* c, BodyPart part, const Attack& attack, const
             case AttackType::BITE: c->you(MsgType::YOUR, "internal organs are ripped out!"); break;
             case AttackType::CUT: c->you(MsgType::ARE, "cut in half!"); break;
             case AttackType::STAB: c->you(MsgType::ARE, "stabbed in the " +
-                                       Random.choose("stomach"_s, "heart"_s) + "!"); break;
+                                       c->getRandom().choose("stomach"_s, "heart"_s) + "!"); break;
             case AttackType::CRUSH: c->you(MsgType::YOUR, "ribs and internal organs are crushed!"); break;
             case AttackType::HIT: c->you(MsgType::YOUR, "stomach receives a deadly blow!"); break;
             case AttackType::SPELL: c->you(MsgType::ARE, "ripped to pieces!"); break;
@@ -678,9 +680,9 @@ Body::DamageResult Body::takeDamage(const Attack& attack, Creature* creature, do
   PROFILE;
   bleed(creature, damage);
   auto factory = creature->getGame()->getContentFactory();
-  if (auto part = getBodyPart(attack.level, creature->isAffected(LastingEffect::FLYING),
+  if (auto part = getBodyPart(creature->getRandom(), attack.level, creature->isAffected(LastingEffect::FLYING),
       creature->isAffected(LastingEffect::COLLAPSED)))
-    if (isPartDamaged(*part, damage, factory)) {
+    if (isPartDamaged(creature->getRandom(), *part, damage, factory)) {
       youHit(creature, *part, attack, factory);
       if (injureBodyPart(creature, *part,
           contains({AttackType::CUT, AttackType::BITE}, attack.type) && bodyPartCanBeDropped(*part))) {
@@ -886,8 +888,8 @@ optional<Sound> Body::getDeathSound() const {
     return Sound(*deathSound).setPitch(getDeathSoundPitch());
 }
 
-optional<Sound> Body::rollAmbientSound() const {
-  if (ambientSound && Random.chance(ambientSound->first))
+optional<Sound> Body::rollAmbientSound(RandomGen& random) const {
+  if (ambientSound && random.chance(ambientSound->first))
     return ambientSound->second;
   return none;
 }
@@ -49,7 +49,7 @@ class Body {
   void setBirdBodyParts(int intrinsicDamage);
   void setDeathSound(optional<SoundId>);
   void addIntrinsicAttack(BodyPart, IntrinsicAttack);
-  void initializeIntrinsicAttack(const ContentFactory*);
+  void initializeIntrinsicAttack(RandomGen&, const ContentFactory*);
   void setMinPushSize(Size);
   void setHumanoid(bool);
   void affectPosition(Position);
@@ -81,7 +81,7 @@ class Body {
   bool canPush(const Body& other);
   bool canPerformRituals(const ContentFactory*) const;
   bool canBeCaptured(const ContentFactory*) const;
-  vector<PItem> getCorpseItems(const string& name, UniqueEntity<Creature>::Id, bool instantlyRotten,
+  vector<PItem> getCorpseItems(RandomGen&, const string& name, UniqueEntity<Creature>::Id, bool instantlyRotten,
       const ContentFactory* factory, Game*) const;
   vector<AttackLevel> getAttackLevels() const;
   BodySize getSize() const;
@@ -92,7 +92,7 @@ class Body {
   void getBadAdjectives(vector<AdjectiveInfo>&) const;
   optional<Sound> getDeathSound() const;
   double getDeathSoundPitch() const;
-  optional<Sound> rollAmbientSound() const;
+  optional<Sound> rollAmbientSound(RandomGen&) const;
   optional<AnimationId> getDeathAnimation(const ContentFactory*) const;
   bool injureBodyPart(Creature*, BodyPart, bool drop);
 
@@ -115,7 +115,7 @@ class Body {
   void updateViewObject(ViewObject&, const ContentFactory*) const;
   int getCarryLimit() const;
   void bleed(Creature*, double amount);
-  vector<pair<Item*, double>> chooseRandomWeapon(vector<Item*> weapons, vector<double> multipliers) const;
+  vector<pair<Item*, double>> chooseRandomWeapon(RandomGen&, vector<Item*> weapons, vector<double> multipliers) const;
   Item* chooseFirstWeapon() const;
   const EnumMap<BodyPart, vector<IntrinsicAttack> >& getIntrinsicAttacks() const;
   EnumMap<BodyPart, vector<IntrinsicAttack> >& getIntrinsicAttacks();
@@ -129,16 +129,16 @@ class Body {
 
   private:
   friend class Test;
-  optional<BodyPart> getBodyPart(AttackLevel attack, bool flying, bool collapsed) const;
-  BodyPart armOrWing() const;
+  optional<BodyPart> getBodyPart(RandomGen&, AttackLevel attack, bool flying, bool collapsed) const;
+  BodyPart armOrWing(RandomGen&) const;
   void clearInjured(BodyPart);
   void clearLost(BodyPart);
   bool looseBodyPart(BodyPart, const ContentFactory*);
   bool injureBodyPart(BodyPart, const ContentFactory*);
   void decreaseHealth(double amount);
-  bool isPartDamaged(BodyPart, double damage, const ContentFactory*) const;
+  bool isPartDamaged(RandomGen&, BodyPart, double damage, const ContentFactory*) const;
   bool isCritical(BodyPart, const ContentFactory*) const;
-  PItem getBodyPartItem(const string& creatureName, BodyPart, const ContentFactory*) const;
+  PItem getBodyPartItem(RandomGen&, const string& creatureName, BodyPart, const ContentFactory*) const;
   string getMaterialAndSizeAdjectives(const ContentFactory*) const;
   bool SERIAL(xhumanoid) = false;
   bool SERIAL(xCanPickUpItems) = false;
@@ -156,7 +156,7 @@ class Body {
   Size SERIAL(minPushSize);
   bool SERIAL(noHealth) = false;
   bool SERIAL(fallsApart) = true;
-  optional<BodyPart> getAnyGoodBodyPart() const;
+  optional<BodyPart> getAnyGoodBodyPart(RandomGen&) const;
   void dropUnsupportedEquipment(const Creature*) const;
   vector<pair<optional<ItemType>, double>> SERIAL(drops);
   optional<bool> SERIAL(canCapture);
@@ -66,6 +66,7 @@
 #include "dancing.h"
 #include "assembled_minion.h"
 #include "creature_experience_info.h"
+#include "sim_benchmark.h"
 
 template <class Archive>
 void Collective::serialize(Archive& ar, const unsigned int version) {
@@ -78,6 +79,8 @@ void Collective::serialize(Archive& ar, const unsigned int version) {
   ar(credit, model, immigration, teams, name, minionActivities, attackedByPlayer, furnace, stunnedMinions);
   ar(config, warnings, knownVillains, knownVillainLocations, banished, positionMatching, steedAssignments);
   ar(villainType, enemyId, workshops, zones, discoverable, populationIncrease, dungeonLevel);
+  if (Archive::is_loading::value)
+    territory->setOwner(this);
 }
 
 SERIALIZABLE(Collective)
@@ -88,6 +91,7 @@ Collective::Collective(Private, Model* model, TribeId t, const optional<Collecti
     const ContentFactory* contentFactory)
     : positionMatching(makeOwner<PositionMatching>()), tribe(t), model(NOTNULL(model)), name(to_heap_optional(n)),
       villainType(VillainType::NONE), minionActivities(contentFactory) {
+  territory->setOwner(this);
 }
 
 PCollective Collective::create(Model* model, TribeId tribe, const optional<CollectiveName>& name, bool discoverable,
@@ -119,6 +123,8 @@ const heap_optional<CollectiveName>& Collective::getName() const {
 
 void Collective::setVillainType(VillainType t) {
   villainType = t;
+  for (auto& pos : territory->getAll())
+    pos.getLevel()->updateTerritoryOwner(pos.getCoord());
 }
 
 bool Collective::isDiscoverable() const {
@@ -240,7 +246,7 @@ void Collective::banishCreature(Creature* c) {
     if (!items.empty())
       tasks.push_back(Task::dropItemsAnywhere(items));
     if (!exitTiles.empty())
-      tasks.push_back(Task::goToTryForever(Random.choose(exitTiles)));
+      tasks.push_back(Task::goToTryForever(getRandom().choose(exitTiles)));
     tasks.push_back(Task::disappear());
     c->setController(makeOwner<Monster>(c, MonsterAIFactory::singleTask(Task::chain(std::move(tasks)))));
   }
@@ -320,6 +326,10 @@ Model* Collective::getModel() const {
   return model;
 }
 
+RandomGen& Collective::getRandom() const {
+  return model->getRandom();
+}
+
 const vector<Creature*>& Collective::getCreatures() const {
   return creatures;
 }
@@ -459,10 +469,10 @@ void Collective::makeConqueredRetired(Collective* conqueror) {
   if (getLeaders().empty()) {
     auto fighters = getCreatures(MinionTrait::FIGHTER);
     if (!fighters.empty())
-      setTrait(Random.choose(fighters), MinionTrait::LEADER);
+      setTrait(getRandom().choose(fighters), MinionTrait::LEADER);
     else {
       CHECK(!getCreatures().empty());
-      setTrait(Random.choose(getCreatures()), MinionTrait::LEADER);
+      setTrait(getRandom().choose(getCreatures()), MinionTrait::LEADER);
     }
   }
 }
@@ -535,9 +545,9 @@ double Collective::getRebellionProbability() const {
 }
 
 void Collective::considerRebellion() {
-  if (Random.chance(getRebellionProbability() / 1000)) {
+  if (getRandom().chance(getRebellionProbability() / 1000)) {
     Position escapeTarget = model->getGroundLevel()->getLandingSquare(StairKey::transferLanding(),
-        Random.choose(Vec2::directions8()));
+        getRandom().choose(Vec2::directions8()));
     for (auto c : copyOf(getCreatures(MinionTrait::PRISONER))) {
       removeCreature(c);
       c->setController(makeOwner<Monster>(c, MonsterAIFactory::singleTask(
@@ -612,6 +622,7 @@ void Collective::updateMinionPromotions() {
 
 void Collective::tick() {
   PROFILE_BLOCK("Collective::tick");
+  SIM_TIMER(COLLECTIVE_TICK);
   updateBorderTiles();
   considerRebellion();
   updateGuardTasks();
@@ -621,10 +632,10 @@ void Collective::tick() {
   zones->tick();
   taskMap->tick();
   constructions->clearUnsupportedFurniturePlans();
-  dancing->setArea(zones->getPositions(ZoneId::LEISURE), getModel()->getLocalTime());
-  if (config->getWarnings() && Random.roll(5))
+  dancing->setArea(getRandom(), zones->getPositions(ZoneId::LEISURE), getModel()->getLocalTime());
+  if (config->getWarnings() && getRandom().roll(5))
     warnings->considerWarnings(this);
-  if (config->getEnemyPositions() && Random.roll(5)) {
+  if (config->getEnemyPositions() && getRandom().roll(5)) {
     vector<Position> enemyPos = getEnemyPositions();
     if (!enemyPos.empty())
       delayDangerousTasks(enemyPos, getLocalTime() + 20_visible);
@@ -635,7 +646,7 @@ void Collective::tick() {
     updateConstructions();
   for (auto& workshop : workshops->types)
     workshop.second.updateState(this);
-  if (Random.roll(5)) {
+  if (getRandom().roll(5)) {
     for (Position pos : territory->getAll())
       if (!isDelayed(pos) && pos.canEnterEmpty(MovementTrait::WALK) && !pos.getItems().empty())
         fetchItems(pos);
@@ -647,7 +658,7 @@ void Collective::tick() {
         fetchItems(pos);
   }
 
-  if (config->getManageEquipment() && Random.roll(40)) {
+  if (config->getManageEquipment() && getRandom().roll(40)) {
     minionEquipment->updateOwners(getCreatures());
     minionEquipment->updateItems(getAllItems(ItemIndex::MINION_EQUIPMENT, true));
     for (auto c : getCreatures())
@@ -780,7 +791,7 @@ void Collective::onEvent(const GameEvent& event) {
       [&](const CreatureTortured& info) {
         auto victim = info.victim;
         if (getCreatures().contains(victim)) {
-          if (Random.roll(30)) {
+          if (getRandom().roll(30)) {
             addRecordedEvent("the torturing of " + victim->getName().aOrTitle());
             if (victim->getUniqueId().getGenericId() % 2 == 0) {
               victim->dieWithReason("killed by torture");
@@ -872,10 +883,11 @@ void Collective::onMinionKilled(Creature* victim, Creature* killer) {
     getGame()->addEvent(EventInfo::ConqueredEnemy{this, attackedByPlayer});
   }
   if (auto& guardianInfo = getConfig().getGuardianInfo())
-    if (Random.chance(guardianInfo->probability)) {
+    if (getRandom().chance(guardianInfo->probability)) {
       auto& extended = territory->getStandardExtended();
       if (!extended.empty())
-        Random.choose(extended).landCreature(factory->getCreatures().fromId(guardianInfo->creature, getTribeId()));
+        getRandom().choose(extended).landCreature(factory->getCreatures().fromId(getRandom(), guardianInfo->creature,
+            getTribeId()));
     }
 }
 
@@ -1044,10 +1056,10 @@ void Collective::returnResource(const CostInfo& amount) {
   CHECK(amount.value > 0);
   auto& info = getResourceInfo(amount.id);
   if (info.itemId) {
-    auto items = info.itemId->get(amount.value, getGame()->getContentFactory());
+    auto items = info.itemId->get(getRandom(), amount.value, getGame()->getContentFactory());
     const auto& destination = getStoragePositions(items[0]->getStorageIds());
     if (!destination.empty()) {
-      Random.choose(destination.asVector()).dropItems(std::move(items));
+      getRandom().choose(destination.asVector()).dropItems(std::move(items));
       return;
     }
   }
@@ -1400,7 +1412,7 @@ const StoragePositions& Collective::getStoragePositions(const vector<StorageId>&
 
 void Collective::fetchItems(Position pos) {
   PROFILE;
-  if (!Random.roll(30) && constructions->getAllStoragePositions().contains(pos))
+  if (!getRandom().roll(30) && constructions->getAllStoragePositions().contains(pos))
     return;
   auto items = pos.getItems();
   if (!items.empty()) {
@@ -1430,10 +1442,10 @@ void Collective::fetchItems(Position pos) {
 
 void Collective::handleSurprise(Position pos) {
   Vec2 rad(8, 8);
-  for (Position v : Random.permutation(pos.getRectangle(Rectangle(-rad, rad + Vec2(1, 1)))))
+  for (Position v : getRandom().permutation(pos.getRectangle(Rectangle(-rad, rad + Vec2(1, 1)))))
     if (Creature* other = v.getCreature())
       if (hasTrait(other, MinionTrait::FIGHTER) && *v.dist8(pos) > 1) {
-        for (Position dest : pos.neighbors8(Random))
+        for (Position dest : pos.neighbors8(getRandom()))
           if (v.canMoveCreature(dest)) {
             v.moveCreature(dest, true);
             break;
@@ -1472,7 +1484,7 @@ bool Collective::addKnownTile(Position pos) {
 }
 
 void Collective::summonDemon(Creature* c) {
-  auto id = Random.choose(CreatureId("SPECIAL_BLGN"), CreatureId("SPECIAL_BLGW"), CreatureId("SPECIAL_HLGN"), CreatureId("SPECIAL_HLGW"));
+  auto id = getRandom().choose(CreatureId("SPECIAL_BLGN"), CreatureId("SPECIAL_BLGW"), CreatureId("SPECIAL_HLGN"), CreatureId("SPECIAL_HLGW"));
   Effect::summon(c, id, 1, 500_visible);
   auto message = PlayerMessage(c->getName().the() + " has summoned a friendly demon!", MessagePriority::CRITICAL);
   c->thirdPerson(message);
@@ -1524,13 +1536,13 @@ void Collective::onAppliedSquare(Creature* c, pair<Position, FurnitureLayer> pos
       taskMap->addTask(Task::kill(c), pos.first, MinionActivity::WORKING);
     if (furniture->getType() == FurnitureType("TORTURE_TABLE"))
       taskMap->addTask(Task::torture(c), pos.first, MinionActivity::WORKING);
-    if (furniture->getType() == FurnitureType("POETRY_TABLE") && Random.chance(0.01 * efficiency)) {
-      auto poem = ItemType(ItemTypes::Poem{}).get(contentFactory);
-      bool demon = Random.roll(500);
-      if (!recordedEvents.empty() && Random.roll(3)) {
-        auto event = Random.choose(recordedEvents);
+    if (furniture->getType() == FurnitureType("POETRY_TABLE") && getRandom().chance(0.01 * efficiency)) {
+      auto poem = ItemType(ItemTypes::Poem{}).get(getRandom(), contentFactory);
+      bool demon = getRandom().roll(500);
+      if (!recordedEvents.empty() && getRandom().roll(3)) {
+        auto event = getRandom().choose(recordedEvents);
         recordedEvents.erase(event);
-        poem = ItemType(ItemTypes::EventPoem{event}).get(contentFactory);
+        poem = ItemType(ItemTypes::EventPoem{event}).get(getRandom(), contentFactory);
         demon = false;
       }
       control->addMessage(c->getName().a() + " writes " + poem->getAName());
@@ -1538,19 +1550,19 @@ void Collective::onAppliedSquare(Creature* c, pair<Position, FurnitureLayer> pos
       if (demon)
         summonDemon(c);
     }
-    if (Random.chance(0.01 * efficiency) &&
+    if (getRandom().chance(0.01 * efficiency) &&
         (furniture->getType() == FurnitureType("PAINTING_N") ||
          furniture->getType() == FurnitureType("PAINTING_S") ||
          furniture->getType() == FurnitureType("PAINTING_E") ||
          furniture->getType() == FurnitureType("PAINTING_W"))) {
-      bool demon = Random.roll(500);
+      bool demon = getRandom().roll(500);
       if (!recordedEvents.empty()|| demon) {
         string name = "painting depicting " + [&] {
           if (demon) {
             summonDemon(c);
             return "a demon"_s;
           } else {
-            auto event = Random.choose(recordedEvents);
+            auto event = getRandom().choose(recordedEvents);
             recordedEvents.erase(event);
             return event;
           }
@@ -1703,7 +1715,7 @@ void Collective::onCopulated(Creature* who, Creature* with) {
   PROFILE;
   control->addMessage(who->getName().a() + " makes love to " + with->getName().a());
   with->addEffect(BuffId("HIGH_MORALE"), 200_visible);
-  if (!who->isAffected(LastingEffect::PREGNANT) && Random.roll(2)) {
+  if (!who->isAffected(LastingEffect::PREGNANT) && getRandom().roll(2)) {
     who->addEffect(LastingEffect::PREGNANT, getConfig().getImmigrantTimeout());
     control->addMessage(who->getName().a() + " becomes pregnant.");
   }
@@ -73,6 +73,7 @@ class Collective : public TaskCallback, public UniqueEntity<Collective>, public
   Tribe* getTribe() const;
   Model* getModel() const;
   Game* getGame() const;
+  RandomGen& getRandom() const;
   typedef CollectiveResourceId ResourceId;
   const ResourceInfo& getResourceInfo(ResourceId) const;
   void addNewCreatureMessage(const vector<Creature*>&);
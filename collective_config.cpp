@@ -81,7 +81,7 @@ static optional<BedType> getBedType(const Creature* c, const ContentFactory* fac
 
 void CollectiveConfig::addBedRequirementToImmigrants(vector<ImmigrantInfo>& immigrantInfo, ContentFactory* factory) {
   for (auto& info : immigrantInfo) {
-    PCreature c = factory->getCreatures().fromId(info.getId(0), TribeId::getDarkKeeper());
+    PCreature c = factory->getCreatures().fromId(Random, info.getId(Random, 0), TribeId::getDarkKeeper());
     if (info.getInitialRecruitment() == 0)
       if (auto bedType = getBedType(c.get(), factory)) {
         bool hasBed = false;
@@ -40,7 +40,7 @@ bool CollectiveWarnings::isWarning(Warning w) const {
 
 void CollectiveWarnings::considerWeaponWarning(Collective* col) {
   int numWeapons = col->getNumItems(ItemIndex::WEAPON);
-  PItem genWeapon = ItemType(CustomItemId("Sword")).get(col->getGame()->getContentFactory());
+  PItem genWeapon = ItemType(CustomItemId("Sword")).get(col->getRandom(), col->getGame()->getContentFactory());
   int numNeededWeapons = 0;
   for (Creature* c : col->getCreatures(MinionTrait::FIGHTER))
     if (col->usesEquipment(c) && col->getMinionEquipment().needsItem(c, genWeapon.get(), true))
@@ -182,8 +182,8 @@ optional<string> ContentFactory::readPlayerCreatures(const GameConfig* config, K
     for (auto& elem : merged)
       for (auto& item : elem.second)
         if (item.tech && !technology.techs.count(*item.tech))
-          return "Technology prerequisite \""_s + item.tech->data() + "\" of workshop item \"" + item.item.get(this)->getName()
-              + "\" is not available " + " for keeper " + keeperInfo.first;
+          return "Technology prerequisite \""_s + item.tech->data() + "\" of workshop item \""
+              + item.item.get(Random, this)->getName() + "\" is not available " + " for keeper " + keeperInfo.first;
     for (auto elem : keeperInfo.second.immigrantGroups)
       if (!immigrantsData.count(elem))
         return "Undefined immigrant group: \"" + elem + "\"";
@@ -624,6 +624,10 @@ Level* Creature::getLevel() const {
   return getPosition().getLevel();
 }
 
+RandomGen& Creature::getRandom() const {
+  return position.getRandom();
+}
+
 Game* Creature::getGame() const {
   if (!gameCache)
     gameCache = getPosition().getGame();
@@ -1151,12 +1155,25 @@ int simulAttackPen(int attackers) {
   return max(0, (attackers - 1) * 2);
 }
 
+int Creature::getEquipmentModifier(AttrType type) const {
+  auto generation = equipment->getEquippedGeneration();
+  if (!equipmentModifiers || equipmentModifiers->first != generation)
+    equipmentModifiers = make_pair(generation, HashMap<AttrType, int>());
+  auto& modifiers = equipmentModifiers->second;
+  if (auto res = getValueMaybe(modifiers, type))
+    return *res;
+  int ret = 0;
+  for (auto& item : equipment->getAllEquipped())
+    if (item->getClass() != ItemClass::WEAPON || type != item->getWeaponInfo().meleeAttackAttr)
+      ret += item->getModifier(type);
+  modifiers[type] = ret;
+  return ret;
+}
+
 int Creature::getAttrBonus(AttrType type, int rawAttr, bool includeWeapon) const {
   PROFILE
   int def = min(killTitles.size(), rawAttr);
-  for (auto& item : equipment->getAllEquipped())
-    if (item->getClass() != ItemClass::WEAPON || type != item->getWeaponInfo().meleeAttackAttr)
-      def += item->getModifier(type);
+  def += getEquipmentModifier(type);
   if (includeWeapon)
     if (auto item = getFirstWeapon())
       if (type == item->getWeaponInfo().meleeAttackAttr)
@@ -1317,7 +1334,7 @@ bool Creature::isEnemy(const Creature* c) const {
   PROFILE;
   if (c == this || c->statuses.contains(CreatureStatus::PRISONER) || statuses.contains(CreatureStatus::PRISONER))
     return false;
-  if (duelInfo && duelInfo->timeout > *globalTime && c->tribe == duelInfo->enemy &&
+  if (duelInfo && duelInfo->timeout > *getGlobalTime() && c->tribe == duelInfo->enemy &&
       c->getUniqueId() != duelInfo->opponent)
     return false;
   auto result = getTribe()->isEnemy(c) || c->getTribe()->isEnemy(this) ||
@@ -1360,6 +1377,10 @@ optional<LocalTime> Creature::getLocalTime() const {
 
 optional<GlobalTime> Creature::getGlobalTime() const {
   PROFILE;
+  // Once the creature has been given a time it follows the clock of the game that it's in.
+  if (globalTime)
+    if (auto game = getGame())
+      return game->getGlobalTime();
   return globalTime;
 }
 
@@ -1369,7 +1390,7 @@ void Creature::considerMovingFromInaccessibleSquare() {
   auto forced = movement;
   forced.setForced();
   if (!position.canEnterEmpty(forced))
-    for (auto neighbor : position.neighbors8(Random))
+    for (auto neighbor : position.neighbors8(getRandom()))
       if (neighbor.canEnter(movement)) {
         displace(position.getDir(neighbor));
         CHECK(getPosition().getCreature() == this);
@@ -1401,18 +1422,21 @@ void Creature::tick() {
     tryToDismount();
   const auto privateEnemyTimeout = 50_visible;
   for (auto c : privateEnemies.getKeys())
-    if (privateEnemies.getOrFail(c) < *globalTime - privateEnemyTimeout)
+    if (privateEnemies.getOrFail(c) < *getGlobalTime() - privateEnemyTimeout)
       privateEnemies.erase(c);
   considerMovingFromInaccessibleSquare();
   auto time = *getGlobalTime();
   vision->update(this, time);
-  if (Random.roll(30))
+  if (getRandom().roll(30))
     getDifficultyPoints();
   equipment->tick(position, this);
   if (isDead())
     return;
   tickCompanions();
   for (LastingEffect effect : ENUM_ALL(LastingEffect)) {
+    // Effects inherited from the steed are checked on the steed's attributes.
+    if (!attributes->getActiveEffects().contains(effect) && (!steed || !LastingEffects::inheritsFromSteed(effect)))
+      continue;
     if (attributes->considerTimeout(effect, time))
       LastingEffects::onTimedOut(this, effect, true);
     if (isDead())
@@ -1429,7 +1453,7 @@ void Creature::tick() {
   }
   if (steed)
     steed->tick();
-  if (auto sound = getBody().rollAmbientSound())
+  if (auto sound = getBody().rollAmbientSound(getRandom()))
     position.addSound(*sound);
 }
 
@@ -1494,7 +1518,7 @@ static vector<Creature*> summonPersonal(Creature* c, CreatureId id, optional<int
 static optional<Position> getCompanionPosition(Creature* c) {
   auto level = c->getLevel();
   for (int i : Range(100)) {
-    Position pos(level->getBounds().random(Random), level);
+    Position pos(level->getBounds().random(level->getRandom()), level);
     if (pos.isCovered() || c->canSee(pos) || !pos.canEnter(MovementTrait::WALK))
       continue;
     return pos;
@@ -1534,8 +1558,8 @@ void Creature::tickCompanions() {
         attributes->companions[companions.size()].getsKillCredit});
   for (int i : All(attributes->companions)) {
     auto& summonsInfo = attributes->companions[i];
-    if (companions[i].creatures.size() < summonsInfo.count && Random.chance(summonsInfo.summonFreq))
-      append(companions[i].creatures, summonPersonal(this, Random.choose(summonsInfo.creatures),
+    if (companions[i].creatures.size() < summonsInfo.count && getRandom().chance(summonsInfo.summonFreq))
+      append(companions[i].creatures, summonPersonal(this, getRandom().choose(summonsInfo.creatures),
           summonsInfo.statsBase ? optional<int>(getAttr(*summonsInfo.statsBase)) : optional<int>(),
           summonsInfo.spawnAway ? getCompanionPosition(this) : none));
     if (summonsInfo.hostile)
@@ -1654,11 +1678,11 @@ CreatureAction Creature::attack(Creature* other) const {
       auto damageAttr = weaponInfo.meleeAttackAttr;
       const int damage = max(1, int(weapon.second * (getAttr(damageAttr, false) +
           getSpecialAttr(damageAttr, other) + weapon.first->getModifier(damageAttr))));
-      AttackLevel attackLevel = Random.choose(getBody().getAttackLevels());
+      AttackLevel attackLevel = getRandom().choose(getBody().getAttackLevels());
       damageAttr = modifyDamageAttr(damageAttr, getGame()->getContentFactory());
       vector<Effect> victimEffects;
       for (auto& e : weaponInfo.victimEffect)
-        if (Random.chance(e.chance))
+        if (getRandom().chance(e.chance))
           victimEffects.push_back(e.effect);
       Attack attack(self, attackLevel, weaponInfo.attackType, damage, damageAttr, std::move(victimEffects));
       string enemyName = other->getController()->getMessageGenerator().getEnemyName(other);
@@ -1689,10 +1713,11 @@ CreatureAction Creature::attack(Creature* other) const {
 void Creature::onAttackedBy(Creature* attacker) {
   if (!canSee(attacker))
     unknownAttackers.insert(attacker);
-  if (attacker->tribe != tribe && globalTime)
+  if (attacker->tribe != tribe)
     // This attack may be accidental, so only do this for creatures from another tribe.
     // To handle intended attacks within one tribe, private enemy will be added in addCombatIntent
-    privateEnemies.set(attacker, *globalTime);
+    if (auto time = getGlobalTime())
+      privateEnemies.set(attacker, *time);
   lastAttacker = attacker;
   addCombatIntent(attacker, CombatIntentInfo::Type::ATTACK);
   if (hasAlternativeViewId())
@@ -1768,7 +1793,7 @@ double Creature::getFlankedMod() const {
 }
 
 bool Creature::takeDamage(const Attack& attack) {
-  if (steed && Random.roll(10))
+  if (steed && getRandom().roll(10))
     return steed->takeDamage(attack);
   PROFILE;
   const double hitPenalty = 0.95;
@@ -1959,7 +1984,7 @@ void Creature::dieWithLastAttacker(DropType drops) {
 }
 
 vector<PItem> Creature::generateCorpse(const ContentFactory* factory, Game* game, bool instantlyRotten) {
-  auto ret = getBody().getCorpseItems(getName().bare(), getUniqueId(), instantlyRotten, factory, game);
+  auto ret = getBody().getCorpseItems(getRandom(), getName().bare(), getUniqueId(), instantlyRotten, factory, game);
   append(ret, std::move(drops));
   return ret;
 }
@@ -1981,7 +2006,7 @@ static optional<Position> findInaccessiblePos(Position startingPos) {
   auto notVisited = startingPos.getLevel()->getAllPositions().filter(
       [&](auto& pos) { return pos.canEnter({MovementTrait::WALK}) && !visited.count(pos); });
   if (!notVisited.empty())
-    return Random.choose(notVisited);
+    return startingPos.getRandom().choose(notVisited);
   return none;
 }
 
@@ -2089,7 +2114,7 @@ void Creature::dieWithAttacker(Creature* attacker, DropType drops) {
         return false;
       };
       if (!addBlood(position))
-        for (auto v : Random.permutation(position.getRectangle(Rectangle::centered(4))))
+        for (auto v : getRandom().permutation(position.getRectangle(Rectangle::centered(4))))
           if (v != position && addBlood(v))
             break;
     }
@@ -2148,7 +2173,7 @@ CreatureAction Creature::torture(Creature* other) const {
   return CreatureAction(this, [=](Creature* self) {
     thirdPerson(getName().the() + " tortures " + other->getName().the());
     secondPerson("You torture " + other->getName().the());
-    if (Random.roll(4)) {
+    if (getRandom().roll(4)) {
       other->thirdPerson(other->getName().the() + " screams!");
       other->getPosition().unseenMessage("You hear a horrible scream");
       position.addSound(getTortureSound(other).setVolume(0.3).setPitch(other->getBody().getDeathSoundPitch()));
@@ -2282,18 +2307,18 @@ CreatureAction Creature::whip(const Position& pos, double animChance) const {
   return CreatureAction(this, [=](Creature* self) {
     thirdPerson(PlayerMessage(getName().the() + " whips " + whipped->getName().the()));
     auto moveInfo = *self->spendTime();
-    if (Random.chance(animChance)) {
+    if (getRandom().chance(animChance)) {
       position.addSound(SoundId("WHIP"));
       self->addMovementInfo(moveInfo
           .setDirection(position.getDir(pos))
           .setType(MovementInfo::ATTACK)
           .setVictim(whipped->getUniqueId()));
     }
-    if (Random.roll(5)) {
+    if (getRandom().roll(5)) {
       whipped->thirdPerson(whipped->getName().the() + " screams!");
       whipped->getPosition().unseenMessage("You hear a horrible scream!");
     }
-    if (Random.roll(20))
+    if (getRandom().roll(20))
       whipped->addEffect(BuffId("HIGH_MORALE"), 400_visible);
   });
 }
@@ -2353,7 +2378,7 @@ void Creature::forceMount(Creature* whom) {
     steed = whom->position.getModel()->extractCreature(whom);
     steed->position = position;
     for (auto& summon : steed->getCompanions())
-      getGame()->transferCreature(summon, position.getModel(), position.neighbors8(Random));
+      getGame()->transferCreature(summon, position.getModel(), position.neighbors8(getRandom()));
     steed->modViewObject().setModifier(ViewObjectModifier::FLIPX,
         getViewObject().hasModifier(ViewObjectModifier::FLIPX));
   }
@@ -2402,7 +2427,7 @@ void Creature::forceDismount(Vec2 v) {
 
 void Creature::tryToDismount() {
   CHECK(!!steed);
-  for (auto v : position.neighbors8(Random))
+  for (auto v : position.neighbors8(getRandom()))
     if (v.canEnter(getSelfMovementType(getGame(), false))) {
       verb("fall off", "falls off", steed->getName().the());
       forceDismount(position.getDir(v));
@@ -2413,7 +2438,7 @@ void Creature::tryToDismount() {
 CreatureAction Creature::dismount() const {
   if (!steed)
     return CreatureAction();
-  for (auto v : position.neighbors8(Random))
+  for (auto v : position.neighbors8(getRandom()))
     if (v.canEnter(getSelfMovementType(getGame(), false)))
       return CreatureAction(this, [=](Creature* self) {
         auto dir = position.getDir(v);
@@ -2514,7 +2539,7 @@ int Creature::getMaxSimultaneousWeapons() const {
 vector<pair<Item*, double>> Creature::getRandomWeapons() const {
   vector<double> multipliers;
   visitMaxSimultaneousWeapons(this, [&](double m) { multipliers.push_back(m); });
-  return getBody().chooseRandomWeapon(equipment->getSlotItems(EquipmentSlot::WEAPON), multipliers);
+  return getBody().chooseRandomWeapon(getRandom(), equipment->getSlotItems(EquipmentSlot::WEAPON), multipliers);
 }
 
 Item* Creature::getFirstWeapon() const {
@@ -2567,7 +2592,7 @@ CreatureAction Creature::throwItem(Item* item, Position target, bool isFriendlyA
     return CreatureAction(item->getTheName() + " is too heavy!");
   int damage = getAttr(AttrType("RANGED_DAMAGE")) + item->getModifier(AttrType("RANGED_DAMAGE"));
   return CreatureAction(this, [=](Creature* self) {
-    Attack attack(isFriendlyAI ? nullptr : self, Random.choose(getBody().getAttackLevels()),
+    Attack attack(isFriendlyAI ? nullptr : self, getRandom().choose(getBody().getAttackLevels()),
         item->getWeaponInfo().attackType, damage, AttrType("DAMAGE"));
     secondPerson("You throw " + item->getAName(false, this));
     thirdPerson(getName().the() + " throws " + item->getAName());
@@ -2747,11 +2772,21 @@ CreatureAction Creature::moveTowards(Position pos, bool away, NavigationFlags fl
     return CreatureAction();
   if (!away && !canNavigateToOrNeighbor(pos))
     return CreatureAction();
+  auto& pathService = position.getLevel()->getPathService();
   auto currentPath = shortestPath;
-  for (int i : Range(2)) {
+  if (!away)
+    if (auto path = pathService.getResult(this, pos))
+      if (path->isReachable(position))
+        currentPath = std::move(*path);
+  bool repaired = false;
+  for (int i : Range(3)) {
     bool wasNew = false;
-    if (!currentPath || Random.roll(10) || currentPath->isReversed() != away ||
-        currentPath->getTarget().dist8(pos).value_or(10000000) > *position.dist8(pos) / 10) {
+    optional<Position> blocked;
+    bool needsRefresh = !!currentPath && ((!repaired && getRandom().roll(10)) ||
+        currentPath->getTarget().dist8(pos).value_or(10000000) > *position.dist8(pos) / 10);
+    // The current path is followed while the new one is searched for together with other creatures' paths.
+    bool refreshLater = needsRefresh && !away && !currentPath->isReversed() && currentPath->isReachable(position);
+    if (!currentPath || currentPath->isReversed() != away || (needsRefresh && !refreshLater)) {
       INFO << "Calculating new path";
       currentPath = LevelShortestPath(this, pos, away ? -1.5 : 0);
       wasNew = true;
@@ -2765,10 +2800,19 @@ CreatureAction Creature::moveTowards(Position pos, bool away, NavigationFlags fl
             return applySquare(position, FurnitureLayer::MIDDLE);
       if (auto action = move(pos2, currentPath->getNextNextMove(position))) {
         if (flags.swapPosition || !pos2.getCreature())
-          return action.append([path = *currentPath](Creature* c) { c->shortestPath = path; });
-        else
+          return action.append([path = *currentPath, refreshLater, pos](Creature* c) {
+            c->shortestPath = path;
+            if (refreshLater && c->getPosition().isSameLevel(pos))
+              c->getPosition().getLevel()->getPathService().request(c, c->getPosition(), pos);
+          });
+        else if (!repaired && currentPath->repair(position, getMovementType(), pos2)) {
+          INFO << "Repaired path around " << pos2.getCreature()->identify();
+          repaired = true;
+          continue;
+        } else
           return CreatureAction();
       } else {
+        blocked = pos2;
         INFO << "Trying to destroy";
         if (!pos2.canEnterEmpty(this) && flags.destroy) {
           if (auto destroyAction = pos2.getBestDestroyAction(getMovementType()))
@@ -2784,6 +2828,11 @@ CreatureAction Creature::moveTowards(Position pos, bool away, NavigationFlags fl
       }
     } else
       INFO << "Position unreachable";
+    if (!wasNew && !repaired && blocked && currentPath->repair(position, getMovementType(), *blocked)) {
+      INFO << "Repaired path";
+      repaired = true;
+      continue;
+    }
     shortestPath = none;
     currentPath = none;
     if (wasNew)
@@ -2806,7 +2855,7 @@ CreatureAction Creature::moveAway(Position pos, bool pathfinding) {
   if (auto action = move(dirs.second))
     moves.push_back(action);
   if (moves.size() > 0)
-    return moves[Random.get(moves.size())];
+    return moves[getRandom().get(moves.size())];
   return CreatureAction();
 }
 
@@ -2989,9 +3038,10 @@ bool Creature::CombatIntentInfo::isHostile() const {
 void Creature::addCombatIntent(Creature* attacker, CombatIntentInfo::Type type) {
   if (attacker != this) {
     lastCombatIntent = CombatIntentInfo{type, attacker, *getGlobalTime()};
-    if (globalTime && type == CombatIntentInfo::Type::ATTACK && (!attacker->isAffected(LastingEffect::INSANITY) ||
+    if (type == CombatIntentInfo::Type::ATTACK && (!attacker->isAffected(LastingEffect::INSANITY) ||
         attacker->getAttributes().isAffectedPermanently(LastingEffect::INSANITY)))
-      privateEnemies.set(attacker, *globalTime);
+      if (auto time = getGlobalTime())
+        privateEnemies.set(attacker, *time);
   }
 }
 
@@ -84,6 +84,7 @@ class Creature : public Renderable, public UniqueEntity<Creature>, public OwnedO
   optional<GlobalTime> getGlobalTime() const;
   Level* getLevel() const;
   Game* getGame() const;
+  RandomGen& getRandom() const;
   const vector<Creature*>& getVisibleEnemies() const;
   Creature* getClosestEnemy(bool meleeOnly = false) const;
   const vector<Creature*>& getVisibleCreatures() const;
@@ -409,6 +410,9 @@ class Creature : public Renderable, public UniqueEntity<Creature>, public OwnedO
   MoveId getCurrentMoveId() const;
   mutable optional<pair<MoveId, vector<Creature*>>> visibleEnemies;
   mutable optional<pair<MoveId, vector<Creature*>>> visibleCreatures;
+  // Sums of equipped item modifiers per attribute, excluding weapons' own attack attribute.
+  mutable optional<pair<int, HashMap<AttrType, int>>> equipmentModifiers;
+  int getEquipmentModifier(AttrType) const;
   HeapAllocated<Vision> SERIAL(vision);
   bool forceMovement = false;
   void setForceMovement(bool value);
@@ -36,10 +36,24 @@
 void CreatureAttributes::initializeLastingEffects() {
   for (LastingEffect effect : ENUM_ALL(LastingEffect))
     lastingEffects[effect] = GlobalTime(-500);
+  updateActiveEffects();
 }
 
-void CreatureAttributes::randomize() {
-  int chosen = Random.get(genderAlternatives.size() + 1);
+void CreatureAttributes::updateActiveEffect(LastingEffect effect) {
+  activeEffects.set(effect, lastingEffects[effect] > GlobalTime(0) || permanentEffects[effect] > 0);
+}
+
+void CreatureAttributes::updateActiveEffects() {
+  for (LastingEffect effect : ENUM_ALL(LastingEffect))
+    updateActiveEffect(effect);
+}
+
+const EnumSet<LastingEffect>& CreatureAttributes::getActiveEffects() const {
+  return activeEffects;
+}
+
+void CreatureAttributes::randomize(RandomGen& random) {
+  int chosen = random.get(genderAlternatives.size() + 1);
   if (chosen > 0) {
     gender = genderAlternatives[chosen - 1].first;
     viewId = genderAlternatives[chosen - 1].second;
@@ -83,6 +97,8 @@ void CreatureAttributes::serializeImpl(Archive& ar, const unsigned int version)
 template <class Archive>
 void CreatureAttributes::serialize(Archive& ar, const unsigned int version) {
   serializeImpl(ar, version);
+  if (Archive::is_loading::value)
+    updateActiveEffects();
 }
 
 SERIALIZABLE(CreatureAttributes);
@@ -217,6 +233,7 @@ void CreatureAttributes::add(BodyPart p, int count, const ContentFactory* factor
   for (auto effect : ENUM_ALL(LastingEffect))
     if (body->isIntrinsicallyAffected(effect, factory))
       ++permanentEffects[effect];
+  updateActiveEffects();
 }
 
 optional<string> CreatureAttributes::getPetReaction(const Creature* me) const {
@@ -260,6 +277,7 @@ GlobalTime CreatureAttributes::getTimeOut(LastingEffect effect) const {
 void CreatureAttributes::copyLastingEffects(const CreatureAttributes& attr) {
   lastingEffects = attr.lastingEffects;
   permanentEffects[LastingEffect::STEED] = attr.permanentEffects[LastingEffect::STEED];
+  updateActiveEffects();
 }
 
 bool CreatureAttributes::considerTimeout(LastingEffect effect, GlobalTime current) {
@@ -272,8 +290,10 @@ bool CreatureAttributes::considerTimeout(LastingEffect effect, GlobalTime curren
 }
 
 void CreatureAttributes::addLastingEffect(LastingEffect effect, GlobalTime endTime) {
-  if (lastingEffects[effect] < endTime)
+  if (lastingEffects[effect] < endTime) {
     lastingEffects[effect] = endTime;
+    updateActiveEffect(effect);
+  }
 }
 
 static bool consumeProb() {
@@ -364,14 +384,17 @@ bool CreatureAttributes::isAffectedPermanently(LastingEffect effect) const {
 
 void CreatureAttributes::clearLastingEffect(LastingEffect effect) {
   lastingEffects[effect] = GlobalTime(0);
+  updateActiveEffect(effect);
 }
 
 void CreatureAttributes::addPermanentEffect(LastingEffect effect, int count) {
   permanentEffects[effect] += count;
+  updateActiveEffect(effect);
 }
 
 void CreatureAttributes::removePermanentEffect(LastingEffect effect, int count) {
   permanentEffects[effect] -= count;
+  updateActiveEffect(effect);
 }
 
 const MinionActivityMap& CreatureAttributes::getMinionActivities() const {
@@ -105,6 +105,8 @@ class CreatureAttributes {
   void removePermanentEffect(LastingEffect, int count);
   bool considerTimeout(LastingEffect, GlobalTime current);
   void addLastingEffect(LastingEffect, GlobalTime endtime);
+  // Effects that have a pending timeout or a permanent count, a superset of those the creature is affected by.
+  const EnumSet<LastingEffect>& getActiveEffects() const;
   optional<GlobalTime> getLastAffected(LastingEffect, GlobalTime currentGlobalTime) const;
   bool canSleep() const;
   bool isInnocent() const;
@@ -115,7 +117,7 @@ class CreatureAttributes {
   void setCanJoinCollective(bool);
   void increaseExpFromCombat(double attackDiff);
   optional<BuffId> getHatedByEffect() const;
-  void randomize();
+  void randomize(RandomGen&);
   bool isInstantPrisoner() const;
 
   friend class ContentFactory;
@@ -161,6 +163,9 @@ class CreatureAttributes {
   vector<SpellId> SERIAL(spells);
   EnumMap<LastingEffect, int> SERIAL(permanentEffects);
   EnumMap<LastingEffect, GlobalTime> SERIAL(lastingEffects);
+  EnumSet<LastingEffect> activeEffects;
+  void updateActiveEffect(LastingEffect);
+  void updateActiveEffects();
   MinionActivityMap SERIAL(minionActivities);
   HashMap<AttrType, double> SERIAL(expLevel);
   HashMap<AttrType, int> SERIAL(maxLevelIncrease);
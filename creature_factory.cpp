@@ -137,7 +137,8 @@ PCreature CreatureFactory::getRollingBoulder(Vec2 direction) {
   return ret;
 }
 
-PCreature CreatureFactory::getAnimatedItem(const ContentFactory* factory, PItem item, TribeId tribe, int attrBonus) {
+PCreature CreatureFactory::getAnimatedItem(RandomGen& random, const ContentFactory* factory, PItem item, TribeId tribe,
+    int attrBonus) {
   auto ret = makeOwner<Creature>(tribe, CATTR(
             c.viewId = item->getViewObject().id();
             c.attr[AttrType("DEFENSE")] = item->getModifier(AttrType("DEFENSE")) + attrBonus;
@@ -156,7 +157,7 @@ PCreature CreatureFactory::getAnimatedItem(const ContentFactory* factory, PItem
             ), SpellMap{});
   ret->setController(Monster::getFactory(MonsterAIFactory::monster()).get(ret.get()));
   ret->take(std::move(item), factory);
-  initializeAttributes(none, ret->getAttributes());
+  initializeAttributes(random, none, ret->getAttributes());
   return ret;
 }
 
@@ -351,7 +352,7 @@ class KrakenController : public Monster {
   }
 
   void pullEnemy(Creature* held) {
-    if (Random.roll(3)) {
+    if (creature->getRandom().roll(3)) {
       held->you(MsgType::HAPPENS_TO, creature->getName().the() + " pulls");
       if (father) {
         held->setHeld(father->creature);
@@ -392,7 +393,7 @@ class KrakenController : public Monster {
     if (v.length8() == 1) {
       c->you(MsgType::HAPPENS_TO, creature->getName().the() + " swings itself around");
       c->setHeld(creature);
-    } else if (length < maxKrakenLength && Random.roll(2)) {
+    } else if (length < maxKrakenLength && creature->getRandom().roll(2)) {
       pair<Vec2, Vec2> dirs = v.approxL1();
       vector<Vec2> moves;
       if (creature->getPosition().plus(dirs.first).canEnter(
@@ -402,7 +403,7 @@ class KrakenController : public Monster {
             {{MovementTrait::WALK, MovementTrait::SWIM}}))
         moves.push_back(dirs.second);
       if (!moves.empty()) {
-        Vec2 move = Random.choose(moves);
+        Vec2 move = creature->getRandom().choose(moves);
         ViewId viewId = creature->getPosition().plus(move).canEnter({MovementTrait::SWIM})
           ? ViewId("kraken_water") : ViewId("kraken_land");
         auto spawn = makeOwner<Creature>(creature->getTribeId(),
@@ -426,7 +427,7 @@ class KrakenController : public Monster {
         pullEnemy(held);
       } else if (auto c = getVisibleEnemy()) {
         considerAttacking(c);
-      } else if (father && Random.roll(5)) {
+      } else if (father && creature->getRandom().roll(5)) {
         creature->dieNoReason(Creature::DropType::NOTHING);
         return;
       }
@@ -579,9 +580,9 @@ class ShopkeeperController : public Monster, public EventListener<ShopkeeperCont
 };
 }
 
-void CreatureFactory::addInventory(Creature* c, const vector<ItemType>& items) {
+void CreatureFactory::addInventory(RandomGen& random, Creature* c, const vector<ItemType>& items) {
   for (ItemType item : items)
-    c->take(item.get(contentFactory), contentFactory);
+    c->take(item.get(random, contentFactory), contentFactory);
 }
 
 PController CreatureFactory::getShopkeeper(vector<Vec2> shopArea, Creature* c) {
@@ -628,7 +629,7 @@ PCreature CreatureFactory::getIllusion(Creature* creature) {
           c.canJoinCollective = false;
           c.name = creature->getName();), SpellMap{});
   ret->setController(makeOwner<IllusionController>(ret.get(), *creature->getGlobalTime()
-      + TimeInterval(Random.get(5, 10))));
+      + TimeInterval(creature->getRandom().get(5, 10))));
   return ret;
 }
 
@@ -708,13 +709,14 @@ static vector<BuffId> getResistanceAndVulnerability(RandomGen& random) {
       BuffId("RANGED_VULNERABILITY")
   };
   vector<BuffId> ret;
-  ret.push_back(Random.choose(resistances));
+  ret.push_back(random.choose(resistances));
   vulnerabilities.removeIndex(*resistances.findElement(ret[0]));
-  ret.push_back(Random.choose(vulnerabilities));
+  ret.push_back(random.choose(vulnerabilities));
   return ret;
 }
 
-PCreature CreatureFactory::getSpecial(CreatureId id, TribeId tribe, SpecialParams p, const ControllerFactory& factory) {
+PCreature CreatureFactory::getSpecial(RandomGen& random, CreatureId id, TribeId tribe, SpecialParams p,
+    const ControllerFactory& factory) {
   Body body = Body(p.humanoid, p.living ? BodyMaterialId("FLESH") : BodyMaterialId("SPIRIT"),
       p.large ? Body::Size::LARGE : Body::Size::MEDIUM);
   if (p.wings)
@@ -724,12 +726,12 @@ PCreature CreatureFactory::getSpecial(CreatureId id, TribeId tribe, SpecialParam
         c.viewId = getSpecialViewId(p.humanoid, p.large, p.living, p.wings);
         c.isSpecial = true;
         c.body = std::move(body);
-        c.attr[AttrType("DAMAGE")] = Random.get(28, 34);
-        c.attr[AttrType("DEFENSE")] = Random.get(28, 34);
-        c.attr[AttrType("SPELL_DAMAGE")] = Random.get(28, 34);
-        c.attr[AttrType("MULTI_WEAPON")] = Random.get(0, 50);
+        c.attr[AttrType("DAMAGE")] = random.get(28, 34);
+        c.attr[AttrType("DEFENSE")] = random.get(28, 34);
+        c.attr[AttrType("SPELL_DAMAGE")] = random.get(28, 34);
+        c.attr[AttrType("MULTI_WEAPON")] = random.get(0, 50);
         c.permanentEffects[p.humanoid ? LastingEffect::RIDER : LastingEffect::STEED] = true;
-        for (auto effect : getResistanceAndVulnerability(Random))
+        for (auto effect : getResistanceAndVulnerability(random))
           c.permanentBuffs.push_back(effect);
         if (p.large) {
           c.attr[AttrType("DAMAGE")] += 6;
@@ -738,7 +740,7 @@ PCreature CreatureFactory::getSpecial(CreatureId id, TribeId tribe, SpecialParam
         }
         if (p.humanoid) {
           for (auto& elem : contentFactory->workshopInfo)
-            c.attr[elem.second.attr] = Random.get(0, 50);
+            c.attr[elem.second.attr] = random.get(0, 50);
           c.maxLevelIncrease[AttrType("DAMAGE")] = 10;
           c.maxLevelIncrease[AttrType("SPELL_DAMAGE")] = 10;
           c.spellSchools = LIST(SpellSchoolId("mage"));
@@ -764,32 +766,32 @@ PCreature CreatureFactory::getSpecial(CreatureId id, TribeId tribe, SpecialParam
                 [&](BuffId e) { c.permanentBuffs.push_back(e); }
             );
         }
-        if (Random.roll(3))
+        if (random.roll(3))
           c.permanentBuffs.push_back(BuffId("SWIMMING_SKILL"));
         );
-  initializeAttributes(id, attributes);
+  initializeAttributes(random, id, attributes);
   auto spells = getSpellMap(attributes);
   PCreature c = get(std::move(attributes), tribe, factory, std::move(spells));
   if (body.isHumanoid()) {
-    if (Random.roll(4))
-      c->take(ItemType(CustomItemId("Bow")).get(contentFactory), contentFactory);
-    c->take(Random.choose(
+    if (random.roll(4))
+      c->take(ItemType(CustomItemId("Bow")).get(random, contentFactory), contentFactory);
+    c->take(random.choose(
           ItemType(CustomItemId("Sword")).setPrefixChance(1),
           ItemType(CustomItemId("BattleAxe")).setPrefixChance(1),
           ItemType(CustomItemId("WarHammer")).setPrefixChance(1))
-        .get(contentFactory), contentFactory);
+        .get(random, contentFactory), contentFactory);
   }
   return c;
 }
 
-void CreatureFactory::initializeAttributes(optional<CreatureId> id, CreatureAttributes& attr) {
+void CreatureFactory::initializeAttributes(RandomGen& random, optional<CreatureId> id, CreatureAttributes& attr) {
   if (id)
     attr.setCreatureId(*id);
-  attr.randomize();
-  attr.getBody().initializeIntrinsicAttack(contentFactory);
+  attr.randomize(random);
+  attr.getBody().initializeIntrinsicAttack(random, contentFactory);
 }
 
-CreatureAttributes CreatureFactory::getAttributesFromId(CreatureId id) {
+CreatureAttributes CreatureFactory::getAttributesFromId(RandomGen& random, CreatureId id) {
   auto ret = [this, id] {
     if (auto ret = getValueMaybe(attributes, id)) {
       ret->name.generateFirst(&*nameGenerator);
@@ -802,7 +804,7 @@ CreatureAttributes CreatureFactory::getAttributesFromId(CreatureId id) {
     FATAL << "Unrecognized creature type: \"" << id << "\"";
     fail();
   }();
-  initializeAttributes(id, ret);
+  initializeAttributes(random, id, ret);
   return ret;
 }
 
@@ -849,17 +851,17 @@ SpellMap CreatureFactory::getSpellMap(const CreatureAttributes& attr) {
   return spellMap;
 }
 
-PCreature CreatureFactory::getSpirit(TribeId tribe, MonsterAIFactory aiFactory) {
+PCreature CreatureFactory::getSpirit(RandomGen& random, TribeId tribe, MonsterAIFactory aiFactory) {
   auto orig = [&] {
-    for (auto id : Random.permutation(getAllCreatures())) {
-      auto orig = fromId(id, tribe);
+    for (auto id : random.permutation(getAllCreatures())) {
+      auto orig = fromId(random, id, tribe);
       if (orig->getBody().hasBrain(contentFactory))
         return orig;
     }
     fail();
   }();
   auto id = CreatureId("SPIRIT");
-  auto attr = getAttributesFromId(id);
+  auto attr = getAttributesFromId(random, id);
   auto spells = getSpellMap(attr);
   auto ret = get(std::move(attr), tribe, getController(id, aiFactory), std::move(spells));
   ret->modViewObject().setModifier(ViewObject::Modifier::ILLUSION);
@@ -871,11 +873,11 @@ PCreature CreatureFactory::getSpirit(TribeId tribe, MonsterAIFactory aiFactory)
   return ret;
 }
 
-PCreature CreatureFactory::get(CreatureId id, TribeId tribe, MonsterAIFactory aiFactory) {
+PCreature CreatureFactory::get(RandomGen& random, CreatureId id, TribeId tribe, MonsterAIFactory aiFactory) {
   ControllerFactory factory = Monster::getFactory(aiFactory);
   auto& special = getSpecialParams();
   if (special.count(id))
-    return getSpecial(id, tribe, special.at(id), factory);
+    return getSpecial(random, id, tribe, special.at(id), factory);
   else if (id == "SOKOBAN_BOULDER")
     return getSokobanBoulder(tribe);
   else if (id == "ROLLING_BOULDER_N")
@@ -887,9 +889,9 @@ PCreature CreatureFactory::get(CreatureId id, TribeId tribe, MonsterAIFactory ai
   else if (id == "ROLLING_BOULDER_W")
     return getRollingBoulder(Vec2(1, 0));
   else if (id == "SPIRIT")
-    return getSpirit(tribe, aiFactory);
+    return getSpirit(random, tribe, aiFactory);
   else {
-    auto attr = getAttributesFromId(id);
+    auto attr = getAttributesFromId(random, id);
     auto spells = getSpellMap(attr);
     return get(std::move(attr), tribe, getController(id, aiFactory), std::move(spells));
   }
@@ -905,12 +907,13 @@ const Spell* CreatureFactory::getSpell(SpellId id) const {
 PCreature CreatureFactory::getGhost(Creature* creature) {
   ViewObject viewObject(creature->getViewObject().id(), ViewLayer::CREATURE, "Ghost");
   viewObject.setModifier(ViewObject::Modifier::ILLUSION);
-  auto ret = makeOwner<Creature>(viewObject, creature->getTribeId(), getAttributesFromId(CreatureId("LOST_SOUL")), SpellMap{});
+  auto ret = makeOwner<Creature>(viewObject, creature->getTribeId(),
+      getAttributesFromId(creature->getRandom(), CreatureId("LOST_SOUL")), SpellMap{});
   ret->setController(Monster::getFactory(MonsterAIFactory::monster()).get(ret.get()));
   return ret;
 }
 
-vector<ItemType> CreatureFactory::getDefaultInventory(CreatureId id) const {
+vector<ItemType> CreatureFactory::getDefaultInventory(RandomGen& random, CreatureId id) const {
   CreatureInventory empty;
   auto& inventoryGen = getSpecialParams().count(id)
       ? getSpecialParams().at(id).inventory
@@ -918,21 +921,21 @@ vector<ItemType> CreatureFactory::getDefaultInventory(CreatureId id) const {
       : empty;
   vector<ItemType> items;
   for (auto& elem : inventoryGen)
-    if (Random.chance(elem.chance)) {
+    if (random.chance(elem.chance)) {
       CHECK(elem.countMin <= elem.countMax) << id.data();
-      for (int i : Range(Random.get(elem.countMin, elem.countMax + 1)))
+      for (int i : Range(random.get(elem.countMin, elem.countMax + 1)))
         items.push_back(ItemType(elem.type).setPrefixChance(elem.prefixChance));
     }
   return items;
 }
 
-PCreature CreatureFactory::fromId(CreatureId id, TribeId t) {
-  return fromId(id, t, MonsterAIFactory::monster());
+PCreature CreatureFactory::fromId(RandomGen& random, CreatureId id, TribeId t) {
+  return fromId(random, id, t, MonsterAIFactory::monster());
 }
 
 PCreature CreatureFactory::makeCopy(Creature* c, const MonsterAIFactory& aiFactory) {
   auto attributes = c->getAttributes();
-  initializeAttributes(*c->getAttributes().getCreatureId(), attributes);
+  initializeAttributes(c->getRandom(), *c->getAttributes().getCreatureId(), attributes);
   auto ret = makeOwner<Creature>(c->getTribeId(), std::move(attributes), c->getSpellMap());
   ret->modViewObject() = c->getViewObject();
   ret->setController(Monster::getFactory(aiFactory).get(ret.get()));
@@ -944,18 +947,19 @@ PCreature CreatureFactory::makeCopy(Creature* c) {
 }
 
 
-PCreature CreatureFactory::fromId(CreatureId id, TribeId t, const MonsterAIFactory& f) {
-  return fromId(id, t, f, {});
+PCreature CreatureFactory::fromId(RandomGen& random, CreatureId id, TribeId t, const MonsterAIFactory& f) {
+  return fromId(random, id, t, f, {});
 }
 
-PCreature CreatureFactory::fromIdNoInventory(CreatureId id, TribeId t, const MonsterAIFactory& f) {
-  return get(id, t, f);
+PCreature CreatureFactory::fromIdNoInventory(RandomGen& random, CreatureId id, TribeId t, const MonsterAIFactory& f) {
+  return get(random, id, t, f);
 }
 
-PCreature CreatureFactory::fromId(CreatureId id, TribeId t, const MonsterAIFactory& factory, const vector<ItemType>& inventory) {
-  auto ret = get(id, t, factory);
-  addInventory(ret.get(), inventory);
-  addInventory(ret.get(), getDefaultInventory(id));
+PCreature CreatureFactory::fromId(RandomGen& random, CreatureId id, TribeId t, const MonsterAIFactory& factory,
+    const vector<ItemType>& inventory) {
+  auto ret = get(random, id, t, factory);
+  addInventory(random, ret.get(), inventory);
+  addInventory(random, ret.get(), getDefaultInventory(random, id));
   return ret;
 }
 
@@ -37,14 +37,14 @@ class ContentFactory;
 
 class CreatureFactory {
   public:
-  PCreature fromId(CreatureId, TribeId, const MonsterAIFactory&);
-  PCreature fromId(CreatureId, TribeId, const MonsterAIFactory&, const vector<ItemType>& inventory);
-  PCreature fromId(CreatureId, TribeId);
-  PCreature fromIdNoInventory(CreatureId, TribeId, const MonsterAIFactory&);
+  PCreature fromId(RandomGen&, CreatureId, TribeId, const MonsterAIFactory&);
+  PCreature fromId(RandomGen&, CreatureId, TribeId, const MonsterAIFactory&, const vector<ItemType>& inventory);
+  PCreature fromId(RandomGen&, CreatureId, TribeId);
+  PCreature fromIdNoInventory(RandomGen&, CreatureId, TribeId, const MonsterAIFactory&);
   PCreature makeCopy(Creature*, const MonsterAIFactory&);
   PCreature makeCopy(Creature*);
   static PController getShopkeeper(vector<Vec2> shopArea, Creature*);
-  PCreature getAnimatedItem(const ContentFactory*, PItem, TribeId, int attrBonus);
+  PCreature getAnimatedItem(RandomGen&, const ContentFactory*, PItem, TribeId, int attrBonus);
   static PCreature getHumanForTests();
   PCreature getGhost(Creature*);
   static PCreature getIllusion(Creature*);
@@ -81,25 +81,25 @@ class CreatureFactory {
     CreatureInventory inventory;
   };
   static const map<CreatureId, SpecialParams>& getSpecialParams();
-  void initializeAttributes(optional<CreatureId>, CreatureAttributes&);
+  void initializeAttributes(RandomGen&, optional<CreatureId>, CreatureAttributes&);
   SpellMap getSpellMap(const CreatureAttributes&);
-  CreatureAttributes getAttributesFromId(CreatureId);
+  CreatureAttributes getAttributesFromId(RandomGen&, CreatureId);
 
   private:
   void initSplash(TribeId);
   static PCreature getSokobanBoulder(TribeId);
   static PCreature getRollingBoulder(Vec2 direction);
-  PCreature getSpecial(CreatureId, TribeId, SpecialParams, const ControllerFactory&);
-  PCreature get(CreatureId, TribeId, MonsterAIFactory);
+  PCreature getSpecial(RandomGen&, CreatureId, TribeId, SpecialParams, const ControllerFactory&);
+  PCreature get(RandomGen&, CreatureId, TribeId, MonsterAIFactory);
   static PCreature get(CreatureAttributes, TribeId, const ControllerFactory&, SpellMap);
   HeapAllocated<NameGenerator> SERIAL(nameGenerator);
   map<CreatureId, CreatureAttributes> SERIAL(attributes);
-  vector<ItemType> getDefaultInventory(CreatureId) const;
+  vector<ItemType> getDefaultInventory(RandomGen&, CreatureId) const;
   map<SpellSchoolId, SpellSchool> SERIAL(spellSchools);
   vector<Spell> SERIAL(spells);
-  void addInventory(Creature*, const vector<ItemType>& items);
+  void addInventory(RandomGen&, Creature*, const vector<ItemType>& items);
   mutable const ContentFactory* contentFactory = nullptr;
-  PCreature getSpirit(TribeId, MonsterAIFactory);
+  PCreature getSpirit(RandomGen&, TribeId, MonsterAIFactory);
 };
 
 static_assert(std::is_nothrow_move_constructible<CreatureFactory>::value, "T should be noexcept MoveConstructible");
@@ -18,18 +18,19 @@ TribeId CreatureGroup::getTribeFor(CreatureId id) {
     return *tribe;
 }
 
-PCreature CreatureGroup::random(CreatureFactory* f) {
-  return random(f, MonsterAIFactory::monster());
+PCreature CreatureGroup::random(RandomGen& random, CreatureFactory* f) {
+  return this->random(random, f, MonsterAIFactory::monster());
 }
 
-PCreature CreatureGroup::random(CreatureFactory* creatureFactory, const MonsterAIFactory& actorFactory) {
+PCreature CreatureGroup::random(RandomGen& random, CreatureFactory* creatureFactory,
+    const MonsterAIFactory& actorFactory) {
   CreatureId id;
   if (unique.size() > 0) {
     id = unique.back();
     unique.pop_back();
   } else
-    id = Random.choose(creatures, weights);
-  PCreature ret = creatureFactory->fromId(id, getTribeFor(id), actorFactory);
+    id = random.choose(creatures, weights);
+  PCreature ret = creatureFactory->fromId(random, id, getTribeFor(id), actorFactory);
   ret->setCombatExperience(combatExperience);
   return ret;
 }
@@ -10,8 +10,8 @@ class CreatureGroup {
   static CreatureGroup waterCreatures(TribeId tribe);
   static CreatureGroup iceCreatures(TribeId tribe);
 
-  PCreature random(CreatureFactory*, const MonsterAIFactory&);
-  PCreature random(CreatureFactory*);
+  PCreature random(RandomGen&, CreatureFactory*, const MonsterAIFactory&);
+  PCreature random(RandomGen&, CreatureFactory*);
 
   CreatureGroup& setCombatExperience(int);
 
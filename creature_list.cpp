@@ -89,7 +89,7 @@ vector<PCreature> CreatureList::generate(RandomGen& random, CreatureFactory* fac
       uniquesCopy.pop_back();
     } else
       id = random.choose(all);
-    auto creature = factory->fromId(*id, tribe, aiFactory, inventory);
+    auto creature = factory->fromId(random, *id, tribe, aiFactory, inventory);
     creature->setCombatExperience(combatExperience);
     for (auto& elem : expLevelIncrease)
       creature->increaseExpLevel(elem.first, elem.second);
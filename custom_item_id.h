@@ -7,5 +7,5 @@ class ContentFactory;
 class CustomItemId : public ContentId<CustomItemId> {
   public:
   using ContentId::ContentId;
-  SItemAttributes getAttributes(const ContentFactory*) const;
+  SItemAttributes getAttributes(RandomGen&, const ContentFactory*) const;
 };
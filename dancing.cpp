@@ -23,12 +23,12 @@ SERIALIZABLE(Dancing)
 
 SERIALIZATION_CONSTRUCTOR_IMPL(Dancing)
 
-void Dancing::initializeCurrentDance(LocalTime startTime) {
+void Dancing::initializeCurrentDance(RandomGen& random, LocalTime startTime) {
   vector<int> indexes = [&] {
     vector<int> res;
     for (int i : Range(0, positions.size()))
       res.push_back(i);
-    return Random.permutation(res);
+    return random.permutation(res);
   }();
   for (int index : indexes) {
     auto& candidatePositions = positions[index];
@@ -58,11 +58,11 @@ void Dancing::initializeCurrentDance(LocalTime startTime) {
 Dancing::Dancing(const ContentFactory* f) : positions(f->dancePositions) {
 }
 
-void Dancing::setArea(PositionSet p, LocalTime time) {
+void Dancing::setArea(RandomGen& random, PositionSet p, LocalTime time) {
   if (p != area) {
     area = std::move(p);
     currentDanceInfo = none;
-    initializeCurrentDance(time);
+    initializeCurrentDance(random, time);
   }
 }
 
@@ -92,7 +92,7 @@ optional<Position> Dancing::getTarget(Creature* creature) {
   auto time = currentDanceInfo->origin.getModel()->getLocalTime();
   if (currentDanceInfo->startTime < time - 100_visible) {
     currentDanceInfo = none;
-    initializeCurrentDance(time);
+    initializeCurrentDance(creature->getRandom(), time);
     if (!currentDanceInfo)
       return none;
   }
@@ -21,7 +21,7 @@ class Dancing {
   };
   Dancing(const ContentFactory*);
 
-  void setArea(PositionSet, LocalTime);
+  void setArea(RandomGen&, PositionSet, LocalTime);
   optional<Position> getTarget(Creature*);
 
   SERIALIZATION_DECL(Dancing)
@@ -35,7 +35,7 @@ class Dancing {
     SERIALIZE_ALL(index, origin, startTime)
   };
   optional<CurrentDanceInfo> SERIAL(currentDanceInfo);
-  void initializeCurrentDance(LocalTime);
+  void initializeCurrentDance(RandomGen&, LocalTime);
   optional<int> assignCreatureIndex(Creature*, LocalTime);
   int getNumActive(LocalTime);
   vector<UniqueEntity<Creature>::Id> SERIAL(assignments);
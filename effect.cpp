@@ -109,7 +109,7 @@ vector<Creature*> Effect::summon(Creature* c, CreatureId id, int num, optional<T
     optional<Position> position) {
   vector<PCreature> creatures;
   for (int i : Range(num))
-    creatures.push_back(c->getGame()->getContentFactory()->getCreatures().fromId(id, c->getTribeId(),
+    creatures.push_back(c->getGame()->getContentFactory()->getCreatures().fromId(c->getRandom(), id, c->getTribeId(),
         MonsterAIFactory::summoned(c)));
   auto ret = summonCreatures(position.value_or(c->getPosition()), std::move(creatures), delay);
   for (auto c : ret)
@@ -122,7 +122,8 @@ vector<Creature*> Effect::summon(Position pos, CreatureGroup& factory, int num,
     TimeInterval delay) {
   vector<PCreature> creatures;
   for (int i : Range(num))
-    creatures.push_back(factory.random(&pos.getGame()->getContentFactory()->getCreatures(), MonsterAIFactory::monster()));
+    creatures.push_back(factory.random(pos.getRandom(), &pos.getGame()->getContentFactory()->getCreatures(),
+        MonsterAIFactory::monster()));
   auto ret = summonCreatures(pos, std::move(creatures), delay);
   for (auto c : ret)
     if (ttl)
@@ -131,12 +132,13 @@ vector<Creature*> Effect::summon(Position pos, CreatureGroup& factory, int num,
 }
 
 static bool enhanceArmor(Creature* c, int mod, const string& msg) {
-  for (EquipmentSlot slot : Random.permutation(getKeys(Equipment::slotTitles)))
+  for (EquipmentSlot slot : c->getRandom().permutation(getKeys(Equipment::slotTitles)))
     for (Item* item : c->getEquipment().getSlotItems(slot))
       if (item->getClass() == ItemClass::ARMOR) {
         c->you(MsgType::YOUR, item->getName() + " " + msg);
         if (item->getModifier(AttrType("DEFENSE")) > 0 || mod > 0)
           item->addModifier(AttrType("DEFENSE"), mod);
+        c->getEquipment().onItemModifiersChanged();
         return true;
       }
   return false;
@@ -146,6 +148,7 @@ static bool enhanceWeapon(Creature* c, int mod, const string& msg) {
   if (auto item = c->getFirstWeapon()) {
     c->you(MsgType::YOUR, item->getName() + " " + msg);
     item->addModifier(item->getWeaponInfo().meleeAttackAttr, mod);
+    c->getEquipment().onItemModifiersChanged();
     return true;
   }
   return false;
@@ -154,9 +157,9 @@ static bool enhanceWeapon(Creature* c, int mod, const string& msg) {
 static bool summon(Creature* summoner, CreatureId id, Range count, bool hostile, optional<TimeInterval> ttl) {
   if (hostile) {
     CreatureGroup f = CreatureGroup::singleType(TribeId::getHostile(), id);
-    return !Effect::summon(summoner->getPosition(), f, Random.get(count), ttl, 1_visible).empty();
+    return !Effect::summon(summoner->getPosition(), f, summoner->getRandom().get(count), ttl, 1_visible).empty();
   } else
-    return !Effect::summon(summoner, id, Random.get(count), ttl, 1_visible).empty();
+    return !Effect::summon(summoner, id, summoner->getRandom().get(count), ttl, 1_visible).empty();
 }
 
 static int getPrice(const Effects::Escape&, const ContentFactory*) {
@@ -220,7 +223,7 @@ static bool applyToCreature(const Effects::Escape& e, Creature* c, Creature*) {
   }
   CHECK(!good.empty());
   c->you(MsgType::TELE_DISAPPEAR, "");
-  c->getPosition().moveCreature(Random.choose(good), true);
+  c->getPosition().moveCreature(c->getRandom().choose(good), true);
   c->you(MsgType::TELE_APPEAR, "");
   return true;
 }
@@ -593,7 +596,7 @@ static bool apply(const Effects::Summon& e, Position pos, Creature* attacker) {
     return TribeId::getHostile();
   }();
   CreatureGroup f = CreatureGroup::singleType(tribe, e.creature);
-  return !Effect::summon(pos, f, Random.get(e.count), e.ttl.map([](int v) { return TimeInterval(v); }), 1_visible).empty();
+  return !Effect::summon(pos, f, pos.getRandom().get(e.count), e.ttl.map([](int v) { return TimeInterval(v); }), 1_visible).empty();
 }
 
 static EffectAIIntent shouldAIApplyToCreature(const Effects::Summon&, const Creature* victim, bool isEnemy) {
@@ -649,7 +652,7 @@ static string getDescription(const Effects::SummonEnemy& e, const ContentFactory
 
 static bool apply(const Effects::SummonEnemy& summon, Position pos, Creature*) {
   CreatureGroup f = CreatureGroup::singleType(TribeId::getHostile(), summon.creature);
-  auto ret = Effect::summon(pos, f, Random.get(summon.count),
+  auto ret = Effect::summon(pos, f, pos.getRandom().get(summon.count),
       summon.ttl.map([](int v) { return TimeInterval(v); }), 1_visible);
   for (auto c : ret)
     c->setCombatExperience(pos.getModelDifficulty());
@@ -683,7 +686,7 @@ static EffectAIIntent shouldAIApplyToCreature(const Effects::SummonElement&, con
 
 static bool applyToCreature(const Effects::Deception&, Creature* c, Creature*) {
   vector<PCreature> creatures;
-  for (int i : Range(Random.get(3, 7)))
+  for (int i : Range(c->getRandom().get(3, 7)))
     creatures.push_back(CreatureFactory::getIllusion(c));
   return !Effect::summonCreatures(c->getPosition(), std::move(creatures)).empty();
 }
@@ -735,7 +738,7 @@ static void airBlast(Creature* attacker, Position origin, Position position, Pos
   for (auto& stack : Item::stackItems(origin.getGame()->getContentFactory(), position.getItems())) {
     position.throwItem(
         position.removeItems(stack),
-        Attack(attacker, Random.choose<AttackLevel>(),
+        Attack(attacker, position.getRandom().choose<AttackLevel>(),
           stack[0]->getWeaponInfo().attackType, 15, AttrType("DAMAGE")), maxDistance,
           position.plus(trajectory.back()), VisionId::NORMAL);
   }
@@ -745,7 +748,7 @@ static void airBlast(Creature* attacker, Position origin, Position position, Pos
 }
 
 static bool applyToCreature(const Effects::CircularBlast&, Creature* c, Creature* attacker) {
-  for (Vec2 v : Vec2::directions8(Random))
+  for (Vec2 v : Vec2::directions8(c->getRandom()))
     airBlast(attacker, c->getPosition(), c->getPosition().plus(v), c->getPosition().plus(v * 10));
   c->addFX({FXName::CIRCULAR_BLAST});
   return true;
@@ -796,7 +799,7 @@ static string getDescription(const Effects::Enhance& e, const ContentFactory*) {
 static bool applyToCreature(const Effects::DestroyEquipment&, Creature* c, Creature*) {
   auto equipped = c->getEquipment().getAllEquipped();
   if (!equipped.empty()) {
-    Item* dest = Random.choose(equipped);
+    Item* dest = c->getRandom().choose(equipped);
     c->you(MsgType::YOUR, dest->getName() + " crumbles to dust.");
     c->steal({dest});
     return true;
@@ -1177,7 +1180,8 @@ static string getDescription(const Effects::DropItems&, const ContentFactory* c)
 }
 
 static bool apply(const Effects::DropItems& effect, Position pos, Creature*) {
-  pos.dropItems(effect.type.get(Random.get(effect.count), pos.getGame()->getContentFactory()));
+  auto& random = pos.getRandom();
+  pos.dropItems(effect.type.get(random, random.get(effect.count), pos.getGame()->getContentFactory()));
   return true;
 }
 
@@ -1192,7 +1196,7 @@ static string getDescription(const Effects::DropItemList&, const ContentFactory*
 static bool apply(const Effects::DropItemList& listId, Position pos, Creature*) {
   auto factory = pos.getGame()->getContentFactory();
   auto list = factory->itemFactory.get(listId);
-  pos.dropItems(list.random(factory, pos.getModelDifficulty()));
+  pos.dropItems(list.random(pos.getRandom(), factory, pos.getModelDifficulty()));
   return true;
 }
 
@@ -1204,7 +1208,7 @@ double getSteedChance<Effects::Damage>() {
 static bool applyToCreature(const Effects::Damage& e, Creature* c, Creature* attacker) {
   CHECK(attacker) << "Unknown attacker";
   int value = attacker->getAttr(e.attr) + attacker->getSpecialAttr(e.attr, c);
-  bool result = c->takeDamage(Attack(attacker, Random.choose<AttackLevel>(), e.attackType, value, e.attr));
+  bool result = c->takeDamage(Attack(attacker, c->getRandom().choose<AttackLevel>(), e.attackType, value, e.attr));
   if (auto& fx = c->getGame()->getContentFactory()->attrInfo.at(e.attr).meleeFX)
     c->addFX(*fx);
   return result;
@@ -1244,7 +1248,7 @@ double getSteedChance<Effects::FixedDamage>() {
 }
 
 static bool applyToCreature(const Effects::FixedDamage& e, Creature* c, Creature*) {
-  bool result = c->takeDamage(Attack(nullptr, Random.choose<AttackLevel>(), e.attackType, e.value, e.attr));
+  bool result = c->takeDamage(Attack(nullptr, c->getRandom().choose<AttackLevel>(), e.attackType, e.value, e.attr));
   if (auto& fx = c->getGame()->getContentFactory()->attrInfo.at(e.attr).meleeFX)
     c->addFX(*fx);
   return result;
@@ -1306,7 +1310,7 @@ static bool applyToCreature(const Effects::AddBodyPart& p, Creature* c, Creature
   c->getBody().addBodyPart(p.part, p.count);
   if (p.attack) {
     c->getBody().addIntrinsicAttack(p.part, IntrinsicAttack{*p.attack, true});
-    c->getBody().initializeIntrinsicAttack(c->getGame()->getContentFactory());
+    c->getBody().initializeIntrinsicAttack(c->getRandom(), c->getGame()->getContentFactory());
   }
   return true;
 }
@@ -1321,7 +1325,7 @@ static string getDescription(const Effects::AddBodyPart& e, const ContentFactory
 
 static bool applyToCreature(const Effects::AddIntrinsicAttack& p, Creature* c, Creature* attacker) {
   c->getBody().addIntrinsicAttack(p.part, IntrinsicAttack{p.attack, true});
-  c->getBody().initializeIntrinsicAttack(c->getGame()->getContentFactory());
+  c->getBody().initializeIntrinsicAttack(c->getRandom(), c->getGame()->getContentFactory());
   return true;
 }
 
@@ -1596,7 +1600,7 @@ static string getDescription(const Effects::ChooseRandom& e, const ContentFactor
 }
 
 static bool apply(const Effects::ChooseRandom& r, Position pos, Creature* attacker) {
-  return r.effects[Random.get(r.effects.size())].apply(pos, attacker);
+  return r.effects[pos.getRandom().get(r.effects.size())].apply(pos, attacker);
 }
 
 static string getName(const Effects::Message&, const ContentFactory*) {
@@ -1689,9 +1693,9 @@ static bool applyToCreature(const Effects::Polymorph& e, Creature* c, Creature*)
   auto& factory = c->getGame()->getContentFactory()->getCreatures();
   auto attributes = [&] {
     if (e.into)
-      return factory.getAttributesFromId(*e.into);
-    for (auto id : Random.permutation(factory.getAllCreatures())) {
-      auto attr = factory.getAttributesFromId(id);
+      return factory.getAttributesFromId(c->getRandom(), *e.into);
+    for (auto id : c->getRandom().permutation(factory.getAllCreatures())) {
+      auto attr = factory.getAttributesFromId(c->getRandom(), id);
       if (attr.getBody().getMaterial() == BodyMaterialId("FLESH") && !attr.isAffectedPermanently(LastingEffect::PLAGUE))
         return attr;
     }
@@ -1854,7 +1858,7 @@ static string getDescription(const Effects::Chance& e, const ContentFactory* f)
 }
 
 static bool apply(const Effects::Chance& e, Position pos, Creature* attacker) {
-  if (Random.chance(e.value))
+  if (pos.getRandom().chance(e.value))
     return e.effect->apply(pos, attacker);
   return false;
 }
@@ -2109,15 +2113,15 @@ static bool apply(const Effects::AnimateItems& m, Position pos, Creature* attack
   for (auto v : pos.getRectangle(Rectangle::centered(m.radius)))
     for (auto item : getItemsToAnimate(m, v))
       candidates.push_back(make_pair(v, item));
-  candidates = Random.permutation(candidates);
+  candidates = pos.getRandom().permutation(candidates);
   bool res = false;
   for (int i : Range(min(m.maxCount, candidates.size()))) {
     auto v = candidates[i].first;
     auto creature = pos.getGame()->getContentFactory()->getCreatures().
-        getAnimatedItem(pos.getGame()->getContentFactory(), v.removeItem(candidates[i].second), attacker->getTribeId(),
-            attacker->getAttr(AttrType("SPELL_DAMAGE")));
+        getAnimatedItem(pos.getRandom(), pos.getGame()->getContentFactory(), v.removeItem(candidates[i].second),
+            attacker->getTribeId(), attacker->getAttr(AttrType("SPELL_DAMAGE")));
     for (auto c : Effect::summonCreatures(v, makeVec(std::move(creature)))) {
-      c->addEffect(LastingEffect::SUMMONED, TimeInterval{Random.get(m.time)}, false);
+      c->addEffect(LastingEffect::SUMMONED, TimeInterval{pos.getRandom().get(m.time)}, false);
       c->effectFlags.insert("animated");
       res = true;
     }
@@ -2543,7 +2547,7 @@ template <typename T, REQUIRE(applyToCreature(TVALUE(const T&), TVALUE(Creature*
 static bool apply1(const T& t, Position pos, Creature* attacker, int) {
   if (auto c = pos.getCreature()) {
     if (auto steed = c->getSteed())
-      if (Random.chance(getSteedChance<T>()))
+      if (pos.getRandom().chance(getSteedChance<T>()))
         return applyToCreature(t, steed, attacker);
     return applyToCreature(t, c, attacker);
   }
@@ -35,7 +35,7 @@
 static vector<PlayerInfo> getBestiary(ContentFactory* f) {
   vector<PlayerInfo> ret;
   for (auto& id : f->getCreatures().getAllCreatures()) {
-    auto c = f->getCreatures().fromId(id, TribeId::getMonster());
+    auto c = f->getCreatures().fromId(Random, id, TribeId::getMonster());
     ret.push_back(PlayerInfo(c.get(), f));
     ret.back().name = c->getName().groupOf(1);
   }
@@ -52,7 +52,7 @@ static vector<SpellSchoolInfo> getSpellSchools(ContentFactory* f) {
 static vector<ItemInfo> getItems(const ContentFactory *f, const Workshops* workshops) {
   vector<ItemInfo> ret;
   auto getItemInfo = [&] (const ItemType type) {
-    return ItemInfo::get(nullptr, {type.get(f).get()}, f);
+    return ItemInfo::get(nullptr, {type.get(Random, f).get()}, f);
   };
   for (auto& elem : f->items)
     ret.push_back(getItemInfo(ItemType(elem.first)));
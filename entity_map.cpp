@@ -205,3 +205,4 @@ SERIALIZABLE_TMPL(EntityMap, Task, Creature*);
 SERIALIZABLE_TMPL(EntityMap, Item, Creature::Id);
 SERIALIZABLE_TMPL(EntityMap, Item, WeakPointer<const Task>);
 template class EntityMap<Creature, milliseconds>;
+template class EntityMap<Creature, TimeQueue::Entry>;
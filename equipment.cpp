@@ -97,6 +97,7 @@ bool Equipment::canEquip(const Item* item, const Creature* c) const {
 void Equipment::equip(Item* item, EquipmentSlot slot, Creature* c, const ContentFactory* factory) {
   items[slot].push_back(item);
   equipped.push_back(item);
+  ++equippedGeneration;
   item->onEquip(c, true, factory);
   CHECK(inventory.hasItem(item));
 }
@@ -104,9 +105,18 @@ void Equipment::equip(Item* item, EquipmentSlot slot, Creature* c, const Content
 void Equipment::unequip(Item* item, Creature* c, const ContentFactory* factory) {
   items[item->getEquipmentSlot()].removeElement(item);
   equipped.removeElement(item);
+  ++equippedGeneration;
   item->onUnequip(c, true, factory);
 }
 
+void Equipment::onItemModifiersChanged() {
+  ++equippedGeneration;
+}
+
+int Equipment::getEquippedGeneration() const {
+  return equippedGeneration;
+}
+
 void Equipment::onRemoved(Item* item, Creature* c, const ContentFactory* factory) {
   if (isEquipped(item))
     unequip(item, c, factory);
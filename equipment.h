@@ -45,6 +45,10 @@ class Equipment {
   const ItemCounts& getCounts() const;
   void tick(Position, Creature*);
   bool containsAnyOf(const EntitySet<Item>&) const;
+  // Changes every time an item is equipped or unequipped, or onItemModifiersChanged() is called.
+  int getEquippedGeneration() const;
+  // Must be called after changing the modifiers of an equipped item.
+  void onItemModifiersChanged();
 
   SERIALIZATION_DECL(Equipment)
 
@@ -54,6 +58,7 @@ class Equipment {
   Inventory SERIAL(inventory);
   EnumMap<EquipmentSlot, vector<Item*>> SERIAL(items);
   vector<Item*> SERIAL(equipped);
+  int equippedGeneration = 0;
   void onRemoved(Item*, Creature*, const ContentFactory*);
 };
 
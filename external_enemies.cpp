@@ -70,7 +70,7 @@ PTask ExternalEnemies::getAttackTask(Collective* enemy, AttackBehaviour behaviou
         return Task::stealFrom(enemy, r);
       },
       [&](CampAndSpawn t) {
-        return Task::campAndSpawn(enemy, t, Random.get(3, 7));
+        return Task::campAndSpawn(enemy, t, enemy->getRandom().get(3, 7));
       },
       [&](HalloweenKids) {
         auto nextToDoor = enemy->getTerritory().getExtended(2, 4);
@@ -80,7 +80,7 @@ PTask ExternalEnemies::getAttackTask(Collective* enemy, AttackBehaviour behaviou
           else
             return Task::idle();
         } else
-          return Task::goToTryForever(Random.choose(nextToDoor));
+          return Task::goToTryForever(enemy->getRandom().choose(nextToDoor));
       }
   );
 }
@@ -111,10 +111,10 @@ void ExternalEnemies::update(Level* level, LocalTime localTime) {
   auto& creatureFactory = level->getGame()->getContentFactory()->getCreatures();
   if (auto nextWave = popNextWave(localTime)) {
     vector<Creature*> attackers;
-    Vec2 landingDir(Random.choose<Dir>());
+    Vec2 landingDir(level->getRandom().choose<Dir>());
     auto attackTask = getAttackTask(target, nextWave->enemy.behaviour);
     auto attackTaskRef = attackTask.get();
-    auto creatures = nextWave->enemy.creatures.generate(Random, &creatureFactory,
+    auto creatures = nextWave->enemy.creatures.generate(level->getRandom(), &creatureFactory,
         TribeId::getMonster(), MonsterAIFactory::singleTask(std::move(attackTask),
             !nextWave->enemy.behaviour.contains<HalloweenKids>()));
     for (auto& c : creatures) {
@@ -24,62 +24,163 @@
 template <class Archive>
 void FieldOfView::serialize(Archive& ar, const unsigned int) {
   ar(level, vision, blocking);
-  if (Archive::is_loading::value)
-    visibility = Table<unique_ptr<Visibility>>(level->getBounds());
-}
-
-#ifdef MEM_USAGE_TEST
-template <>
-void FieldOfView::serialize(MemUsageArchive& ar1, const unsigned int) {
-  ar1(level, vision, blocking, visibility);
+  if (Archive::is_loading::value) {
+    cacheIndex = Table<int>(level->getBounds(), -1);
+    blockingBits = BlockingBits(blocking);
+  }
 }
-#endif
 
 template void FieldOfView::serialize(InputArchive&, unsigned);
 template void FieldOfView::serialize(OutputArchive&, unsigned);
 
 SERIALIZATION_CONSTRUCTOR_IMPL(FieldOfView)
 
-template <typename Archive>
-void FieldOfView::Visibility::serialize(Archive& ar, const unsigned int) {
-  ar(visibleTiles);
+FieldOfViewCacheStats& FieldOfViewCacheStats::operator += (const FieldOfViewCacheStats& other) {
+  hits += other.hits;
+  misses += other.misses;
+  evictions += other.evictions;
+  bytes += other.bytes;
+  return *this;
 }
 
-SERIALIZABLE(FieldOfView::Visibility)
-
-SERIALIZATION_CONSTRUCTOR_IMPL2(FieldOfView::Visibility, Visibility)
-
 FieldOfView::FieldOfView(Level* l, VisionId v, const ContentFactory* factory)
-    : level(l), visibility(l->getBounds()), vision(v), blocking(l->getBounds().minusMargin(-1), true) {
+    : level(l), cacheIndex(l->getBounds(), -1), vision(v), blocking(l->getBounds().minusMargin(-1), true) {
   for (auto v : blocking.getBounds())
     blocking[v] = !Position(v, level).canSeeThru(vision, factory);
+  blockingBits = BlockingBits(blocking);
+}
+
+int FieldOfView::allocateCacheEntry() {
+  if (!freeCacheEntries.empty()) {
+    int ret = freeCacheEntries.back();
+    freeCacheEntries.pop_back();
+    return ret;
+  }
+  if (cache.size() < cacheCapacity) {
+    cache.emplace_back();
+    return cache.size() - 1;
+  }
+  // Clock eviction: entries used since the hand last passed them get a second chance.
+  while (1) {
+    auto& entry = cache[clockHand];
+    int index = clockHand;
+    clockHand = (clockHand + 1) % cache.size();
+    if (entry.referenced)
+      entry.referenced = false;
+    else {
+      cacheIndex[entry.pos] = -1;
+      ++cacheStats.evictions;
+      return index;
+    }
+  }
+}
+
+FieldOfView::Visibility& FieldOfView::getVisibility(Vec2 from) {
+  int index = cacheIndex[from];
+  if (index >= 0)
+    ++cacheStats.hits;
+  else {
+    ++cacheStats.misses;
+    index = allocateCacheEntry();
+    cache[index].pos = from;
+    cache[index].visibility.compute(level->getBounds(), blockingBits, from.x, from.y);
+    cacheIndex[from] = index;
+  }
+  cache[index].referenced = true;
+  return cache[index].visibility;
 }
 
 bool FieldOfView::canSee(Vec2 from, Vec2 to) {
   PROFILE;;
   if ((from - to).lengthD() > sightRange)
     return false;
-  if (!visibility[from])
-    visibility[from].reset(new Visibility(level->getBounds(), blocking, from.x, from.y));
-  return visibility[from]->checkVisible(to.x - from.x, to.y - from.y);
+  return getVisibility(from).checkVisible(to.x - from.x, to.y - from.y);
 }
 
 void FieldOfView::squareChanged(Vec2 pos) {
   PROFILE;
   blocking[pos] = !Position(pos, level).canSeeThru(vision);
-  vector<Vec2> updateList;
-  if (!visibility[pos])
-    visibility[pos].reset(new Visibility(level->getBounds(), blocking, pos.x, pos.y));
+  blockingBits.set(pos, blocking[pos]);
   for (Vec2 v : Rectangle::centered(pos, sightRange))
-    if (v.inRectangle(visibility.getBounds()) && visibility[v] && visibility[v]->checkVisible(pos.x - v.x, pos.y - v.y)) {
-      visibility[v].reset();
+    if (v.inRectangle(cacheIndex.getBounds())) {
+      int index = cacheIndex[v];
+      if (index >= 0 && cache[index].visibility.checkVisible(pos.x - v.x, pos.y - v.y)) {
+        cacheIndex[v] = -1;
+        cache[index].referenced = false;
+        freeCacheEntries.push_back(index);
+      }
     }
 }
 
+FieldOfViewCacheStats FieldOfView::getCacheStats() const {
+  auto ret = cacheStats;
+  ret.bytes = sizeof(*this) + cacheIndex.getWidth() * cacheIndex.getHeight() * sizeof(int) +
+      blocking.getWidth() * blocking.getHeight() * sizeof(bool) + blockingBits.getMemoryUsage() + freeCacheEntries.capacity() * sizeof(int);
+  for (auto& entry : cache)
+    ret.bytes += sizeof(CacheEntry) - sizeof(Visibility) + entry.visibility.getMemoryUsage();
+  return ret;
+}
+
+FieldOfView::BlockingBits::BlockingBits(const Table<bool>& blocking) : bounds(blocking.getBounds()),
+    // One word of padding on each side, so that reads starting up to 64 squares outside of the table stay in memory.
+    rowStride((bounds.width() + 63) / 64 + 3), columnStride((bounds.height() + 63) / 64 + 3),
+    rows(bounds.height() * rowStride, ~uint64_t(0)), columns(bounds.width() * columnStride, ~uint64_t(0)) {
+  for (Vec2 v : bounds)
+    set(v, blocking[v]);
+}
+
+void FieldOfView::BlockingBits::set(vector<uint64_t>& lines, int stride, int line, int offset, bool value) {
+  offset += 64;
+  auto& word = lines[line * stride + offset / 64];
+  if (value)
+    word |= uint64_t(1) << (offset % 64);
+  else
+    word &= ~(uint64_t(1) << (offset % 64));
+}
+
+uint64_t FieldOfView::BlockingBits::get(const vector<uint64_t>& lines, int stride, int line, int offset) {
+  offset += 64;
+  CHECK(offset >= 0 && offset / 64 + 1 < stride);
+  auto word = &lines[line * stride + offset / 64];
+  int shift = offset % 64;
+  if (shift == 0)
+    return word[0];
+  return (word[0] >> shift) | (word[1] << (64 - shift));
+}
+
+void FieldOfView::BlockingBits::set(Vec2 v, bool value) {
+  set(rows, rowStride, v.y - bounds.top(), v.x - bounds.left(), value);
+  set(columns, columnStride, v.x - bounds.left(), v.y - bounds.top(), value);
+}
+
+uint64_t FieldOfView::BlockingBits::getRow(int x, int y) const {
+  if (y < bounds.top() || y >= bounds.bottom())
+    return ~uint64_t(0);
+  return get(rows, rowStride, y - bounds.top(), x - bounds.left());
+}
+
+uint64_t FieldOfView::BlockingBits::getColumn(int x, int y) const {
+  if (x < bounds.left() || x >= bounds.right())
+    return ~uint64_t(0);
+  return get(columns, columnStride, x - bounds.left(), y - bounds.top());
+}
+
+int FieldOfView::BlockingBits::getMemoryUsage() const {
+  return (rows.capacity() + columns.capacity()) * sizeof(uint64_t);
+}
+
+void FieldOfView::Visibility::reset(int x, int y) {
+  px = x;
+  py = y;
+  visibleRows.fill(0);
+  visibleColumns.fill(0);
+  visibleTiles.clear();
+}
+
 void FieldOfView::Visibility::setVisible(Rectangle bounds, int x, int y) {
-  if (Vec2(px + x, py + y).inRectangle(bounds) &&
-      !visible[x + sightRange][y + sightRange] && x * x + y * y <= sightRange * sightRange) {
-    visible[x + sightRange][y + sightRange] = 1;
+  if (Vec2(px + x, py + y).inRectangle(bounds) && !checkVisible(x, y) && x * x + y * y <= sightRange * sightRange) {
+    visibleRows[y + sightRange] |= uint64_t(1) << (x + sightRange);
+    visibleColumns[x + sightRange] |= uint64_t(1) << (y + sightRange);
     visibleTiles.push_back(SVec2{short(px + x), short(py + y)});
   }
 }
@@ -123,8 +224,8 @@ static void calculate(int left, int right, int up, int h, int x1, int y1, int x2
   calculate(left, right, up, h + 2, leftx, lefty, rightx, righty, isBlocking, setVisible);
 }
 
-FieldOfView::Visibility::Visibility(Rectangle bounds, const Table<bool>& blocking, int x, int y) : px(x), py(y) {
-  PROFILE;
+void FieldOfView::Visibility::computeScalar(Rectangle bounds, const Table<bool>& blocking, int x, int y) {
+  reset(x, y);
   calculate(2 * sightRange, 2 * sightRange,2 * sightRange, 2,-1,1,1,1,
       [&](int px, int py) { return blocking[Vec2(x + px, y + py)]; },
       [&](int px, int py) { setVisible(bounds, px, py); });
@@ -138,27 +239,197 @@ FieldOfView::Visibility::Visibility(Rectangle bounds, const Table<bool>& blockin
       [&](int px, int py) { return blocking[Vec2(x - py, y + px)]; },
       [&](int px, int py) { setVisible(bounds, -py, px); });
   setVisible(bounds, 0, 0);
-  visibleTiles.shrink_to_fit();
-/*  ++numSamples;
-  totalIter += visibleTiles.size();
-  if (numSamples%100 == 0)
-    INFO << numSamples << " iterations " << totalIter / numSamples << " avg";*/
+}
+
+// The bitboard kernel works on the same quadrants as the scalar one. Row r of a quadrant holds the squares at
+// distance r from the viewer, and bit i + sightRange of it is the square at offset i along the row. Quadrants 1
+// and 2 are mirrored compared to the level's rows and columns.
+
+static constexpr int rowBits = 2 * FieldOfView::sightRange + 1;
+
+static uint64_t reverseRow(uint64_t v) {
+  v = ((v >> 1) & 0x5555555555555555ull) | ((v & 0x5555555555555555ull) << 1);
+  v = ((v >> 2) & 0x3333333333333333ull) | ((v & 0x3333333333333333ull) << 2);
+  v = ((v >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((v & 0x0F0F0F0F0F0F0F0Full) << 4);
+  v = ((v >> 8) & 0x00FF00FF00FF00FFull) | ((v & 0x00FF00FF00FF00FFull) << 8);
+  v = ((v >> 16) & 0x0000FFFF0000FFFFull) | ((v & 0x0000FFFF0000FFFFull) << 16);
+  v = (v >> 32) | (v << 32);
+  return v >> (64 - rowBits);
+}
+
+// Bits from offset 'from' to 'to' inclusive.
+static uint64_t getRowMask(int from, int to) {
+  from = max(from, -FieldOfView::sightRange);
+  to = min(to, FieldOfView::sightRange);
+  if (from > to)
+    return 0;
+  return (~uint64_t(0) >> (63 - (to - from))) << (from + FieldOfView::sightRange);
+}
+
+static int lowestBit(uint64_t v) {
+  return __builtin_ctzll(v) - FieldOfView::sightRange;
+}
+
+static int highestBit(uint64_t v) {
+  return 63 - __builtin_clzll(v) - FieldOfView::sightRange;
+}
+
+// Same beam recursion as calculate(), but every row is handled with a few word operations: setVisible gets
+// runs of squares and the recursion only happens at the starts of blocking runs.
+template <typename Fun1, typename Fun2>
+static void calculateBits(int h, int x1, int y1, int x2, int y2, Fun1 getBlockingRow, Fun2 setVisible) {
+  const int range = 2 * FieldOfView::sightRange;
+  if (y2*x1>=y1*x2) return;
+  if (h>range) return;
+  int leftx=x1, lefty=y1, rightx=x2, righty=y2;
+  int left_v=(int)floor((double)x1/y1*(h)),
+      right_v=(int)ceil((double)x2/y2*(h)),
+      left_b=(int)floor((double)x1/y1*(h-1));
+  if (left_v % 2)
+    ++left_v;
+  if (right_v % 2)
+    --right_v;
+  if(left_b % 2)
+    ++left_b;
+  uint64_t rowBlocking = getBlockingRow(h / 2);
+  if(left_b>=-range && left_b<=range && ((rowBlocking >> (left_b / 2 + FieldOfView::sightRange)) & 1)){
+    leftx=left_b+1;
+    lefty=h+(left_b>=0?-1:1);
+  }
+  if(left_v<-range) left_v=-range;
+  if(right_v>range) right_v=range;
+  int first = left_v / 2;
+  int last = right_v / 2;
+  if (first <= last) {
+    uint64_t blocking = rowBlocking & getRowMask(first, last);
+    uint64_t runStarts = blocking & ~(blocking << 1) & ~getRowMask(first, first);
+    int segmentStart = first;
+    while (runStarts) {
+      int i = lowestBit(runStarts);
+      runStarts &= runStarts - 1;
+      setVisible(h / 2, getRowMask(segmentStart, i));
+      int beamLeftx = leftx, beamLefty = lefty;
+      if (uint64_t before = blocking & getRowMask(first, i - 1)) {
+        int j = highestBit(before);
+        beamLeftx = j * 2 + 1;
+        beamLefty = h + (j >= 0 ? -1 : 1);
+      }
+      calculateBits(h + 2, beamLeftx, beamLefty, i * 2 - 1, h + (i<=0 ? -1:1), getBlockingRow, setVisible);
+      segmentStart = i + 1;
+    }
+    setVisible(h / 2, getRowMask(segmentStart, last));
+    if (blocking) {
+      int j = highestBit(blocking);
+      leftx = j * 2 + 1;
+      lefty = h + (j >= 0 ? -1 : 1);
+    }
+  }
+  calculateBits(h + 2, leftx, lefty, rightx, righty, getBlockingRow, setVisible);
+}
+
+void FieldOfView::Visibility::setVisibleBits(int quadrant, int distance, uint64_t bits) {
+  auto push = [&](int x, int y) {
+    visibleRows[y + sightRange] |= uint64_t(1) << (x + sightRange);
+    visibleColumns[x + sightRange] |= uint64_t(1) << (y + sightRange);
+    visibleTiles.push_back(SVec2{short(px + x), short(py + y)});
+  };
+  // Squares are added in the order of increasing offset along the quadrant row, like in the scalar kernel.
+  // In quadrants 1 and 2 that is the order of decreasing level coordinates.
+  auto popHighest = [](uint64_t& bits) {
+    int ret = highestBit(bits);
+    bits &= ~(uint64_t(1) << (ret + sightRange));
+    return ret;
+  };
+  switch (quadrant) {
+    case 0:
+      for (bits &= ~visibleRows[distance + sightRange]; bits; bits &= bits - 1)
+        push(lowestBit(bits), distance);
+      break;
+    case 1:
+      for (bits = reverseRow(bits) & ~visibleColumns[distance + sightRange]; bits;)
+        push(distance, popHighest(bits));
+      break;
+    case 2:
+      for (bits = reverseRow(bits) & ~visibleRows[sightRange - distance]; bits;)
+        push(popHighest(bits), -distance);
+      break;
+    case 3:
+      for (bits &= ~visibleColumns[sightRange - distance]; bits; bits &= bits - 1)
+        push(-distance, lowestBit(bits));
+      break;
+  }
+}
+
+void FieldOfView::Visibility::compute(Rectangle bounds, const BlockingBits& blocking, int x, int y) {
+  PROFILE;
+  reset(x, y);
+  const uint64_t rowMask = getRowMask(-sightRange, sightRange);
+  // Squares within sight range, by distance from the viewer.
+  static const auto circle = [] {
+    array<uint64_t, sightRange + 1> ret;
+    for (int r : Range(sightRange + 1)) {
+      int width = 0;
+      while ((width + 1) * (width + 1) + r * r <= sightRange * sightRange)
+        ++width;
+      ret[r] = getRowMask(-width, width);
+    }
+    return ret;
+  }();
+  for (int quadrant : Range(4)) {
+    uint64_t blockingRows[sightRange + 1];
+    uint64_t allowed[sightRange + 1];
+    // Rows are only read when a beam reaches them, which in enclosed places is just a few of them.
+    int numRows = 1;
+    auto getRows = [&](int distance) {
+      for (; numRows <= distance; ++numRows) {
+        int r = numRows;
+        switch (quadrant) {
+          case 0:
+            blockingRows[r] = blocking.getRow(x - sightRange, y + r);
+            allowed[r] = y + r < bounds.bottom() ? getRowMask(bounds.left() - x, bounds.right() - 1 - x) : 0;
+            break;
+          case 1:
+            blockingRows[r] = reverseRow(blocking.getColumn(x + r, y - sightRange));
+            allowed[r] = x + r < bounds.right() ? getRowMask(y - bounds.bottom() + 1, y - bounds.top()) : 0;
+            break;
+          case 2:
+            blockingRows[r] = reverseRow(blocking.getRow(x - sightRange, y - r));
+            allowed[r] = y - r >= bounds.top() ? getRowMask(x - bounds.right() + 1, x - bounds.left()) : 0;
+            break;
+          case 3:
+            blockingRows[r] = blocking.getColumn(x - r, y - sightRange);
+            allowed[r] = x - r >= bounds.left() ? getRowMask(bounds.top() - y, bounds.bottom() - 1 - y) : 0;
+            break;
+        }
+        blockingRows[r] &= rowMask;
+        allowed[r] &= circle[r];
+      }
+    };
+    calculateBits(2, -1, 1, 1, 1,
+        [&](int distance) { getRows(distance); return blockingRows[distance]; },
+        [&](int distance, uint64_t bits) {
+          if (bits &= allowed[distance])
+            setVisibleBits(quadrant, distance, bits);
+        });
+  }
+  setVisible(bounds, 0, 0);
 }
 
 const vector<SVec2>& FieldOfView::Visibility::getVisibleTiles() const {
   return visibleTiles;
 }
 
+int FieldOfView::Visibility::getMemoryUsage() const {
+  return sizeof(*this) + visibleTiles.capacity() * sizeof(SVec2);
+}
+
 const vector<SVec2>& FieldOfView::getVisibleTiles(Vec2 from) {
-  if (!visibility[from]) {
-    visibility[from].reset(new Visibility(level->getBounds(), blocking, from.x, from.y));
-  }
-  return visibility[from]->getVisibleTiles();
+  return getVisibility(from).getVisibleTiles();
 }
 
 bool FieldOfView::Visibility::checkVisible(int x, int y) const {
   return x >= -sightRange && y >= -sightRange && x <= sightRange && y <= sightRange &&
-    visible[sightRange + x][sightRange + y] == 1;
+    ((visibleRows[sightRange + y] >> (sightRange + x)) & 1);
 }
 
 
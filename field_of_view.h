@@ -21,19 +21,51 @@ class Square;
 class SquareArray;
 class ContentFactory;
 
+struct FieldOfViewCacheStats {
+  long long hits = 0;
+  long long misses = 0;
+  long long evictions = 0;
+  long long bytes = 0;
+  FieldOfViewCacheStats& operator += (const FieldOfViewCacheStats&);
+};
+
 class FieldOfView {
   public:
   FieldOfView(Level*, VisionId, const ContentFactory*);
   bool canSee(Vec2 from, Vec2 to);
+  // The returned reference is only valid until the next call, which may evict it from the cache.
   const vector<SVec2>& getVisibleTiles(Vec2 from);
   void squareChanged(Vec2 pos);
+  FieldOfViewCacheStats getCacheStats() const;
 
   SERIALIZATION_DECL(FieldOfView)
 
   static constexpr int sightRange = 30;
+  // Maximum number of positions whose visibility is kept. The least recently used ones are evicted first.
+  static constexpr int cacheCapacity = 1024;
 
-  private:
+  // The blocking table packed into 64-bit words, both along rows and along columns, so that a whole row
+  // of a quadrant can be read at once. Squares outside of the table are blocking.
+  class BlockingBits {
+    public:
+    BlockingBits() {}
+    BlockingBits(const Table<bool>&);
+    void set(Vec2, bool);
+    // Bit k is the square (x + k, y).
+    uint64_t getRow(int x, int y) const;
+    // Bit k is the square (x, y + k).
+    uint64_t getColumn(int x, int y) const;
+    int getMemoryUsage() const;
 
+    private:
+    static void set(vector<uint64_t>& lines, int stride, int line, int offset, bool);
+    static uint64_t get(const vector<uint64_t>& lines, int stride, int line, int offset);
+    Rectangle bounds;
+    int rowStride = 0;
+    int columnStride = 0;
+    vector<uint64_t> rows;
+    vector<uint64_t> columns;
+  };
 
   class Visibility {
     public:
@@ -41,22 +73,45 @@ class FieldOfView {
     bool checkVisible(int x,int y) const;
     const vector<SVec2>& getVisibleTiles() const;
 
-    Visibility(Rectangle bounds, const Table<bool>& blocking, int x, int y);
-
-    SERIALIZATION_DECL(Visibility)
+    // Reuses the memory of the previous calculation.
+    void compute(Rectangle bounds, const BlockingBits& blocking, int x, int y);
+    // The original per-square shadowcasting. Gives exactly the same tiles in the same order as compute(),
+    // kept to test and benchmark it against.
+    void computeScalar(Rectangle bounds, const Table<bool>& blocking, int x, int y);
+    int getMemoryUsage() const;
 
     private:
-    array<bitset<sightRange * 2 + 1>, sightRange * 2 + 1> visible;
-    vector<SVec2> SERIAL(visibleTiles);
+    void reset(int x, int y);
     void setVisible(Rectangle bounds, int, int);
+    void setVisibleBits(int quadrant, int distance, uint64_t bits);
+    // Bit x + sightRange of visibleRows[y + sightRange] and bit y + sightRange of visibleColumns[x + sightRange]
+    // are both set when the square is visible.
+    array<uint64_t, sightRange * 2 + 1> visibleRows;
+    array<uint64_t, sightRange * 2 + 1> visibleColumns;
+    vector<SVec2> visibleTiles;
 
     int px;
     int py;
   };
 
+  private:
+  struct CacheEntry {
+    Visibility visibility;
+    Vec2 pos;
+    bool referenced;
+  };
+
+  Visibility& getVisibility(Vec2 from);
+  int allocateCacheEntry();
   Level* SERIAL(level) = nullptr;
-  Table<unique_ptr<Visibility>> visibility;
+  // Index into cache for every position, or -1.
+  Table<int> cacheIndex;
+  // A deque, so that growing it doesn't invalidate references returned by getVisibleTiles().
+  deque<CacheEntry> cache;
+  vector<int> freeCacheEntries;
+  int clockHand = 0;
+  FieldOfViewCacheStats cacheStats;
   VisionId SERIAL(vision);
   Table<bool> SERIAL(blocking);
+  BlockingBits blockingBits;
 };
-
@@ -0,0 +1,125 @@
+/* Copyright (C) 2013-2014 Michal Brzozowski (rusolis@poczta.fm)
+
+   This file is part of KeeperRL.
+
+   KeeperRL is free software; you can redistribute it and/or modify it under the terms of the
+   GNU General Public License as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   KeeperRL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+   even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with this program.
+   If not, see http://www.gnu.org/licenses/ . */
+
+#include "stdafx.h"
+#include "util.h"
+#include "flow_field.h"
+#include "shortest_path.h"
+
+FlowField::FlowField(Rectangle area, Vec2 target, function<double(Vec2)> entryFun,
+    function<vector<Vec2>(Vec2)> directions) : distance(area, ShortestPath::infinity), target(target) {
+  PROFILE;
+  using QueueElem = pair<float, Vec2>;
+  priority_queue<QueueElem, vector<QueueElem>, std::greater<QueueElem>> q;
+  distance[target] = 0;
+  q.push({0, target});
+  while (!q.empty()) {
+    auto elem = q.top();
+    q.pop();
+    Vec2 pos = elem.second;
+    if (elem.first > distance[pos])
+      continue;
+    for (Vec2 dir : directions(pos)) {
+      Vec2 next = pos + dir;
+      if (next.inRectangle(area)) {
+        float dist = elem.first + entryFun(next);
+        if (dist < distance[next]) {
+          distance[next] = dist;
+          q.push({dist, next});
+        }
+      }
+    }
+  }
+}
+
+bool FlowField::isReachable(Vec2 v) const {
+  return v.inRectangle(distance.getBounds()) && distance[v] < ShortestPath::infinity;
+}
+
+double FlowField::getDistance(Vec2 v) const {
+  return distance[v];
+}
+
+Vec2 FlowField::getTarget() const {
+  return target;
+}
+
+vector<Vec2> FlowField::getPath(Vec2 from, function<vector<Vec2>(Vec2)> directions,
+    function<double(Vec2)> extraCost) const {
+  if (!isReachable(from))
+    return {};
+  vector<Vec2> ret {from};
+  for (Vec2 pos = from; pos != target;) {
+    optional<Vec2> next;
+    double lowest = ShortestPath::infinity;
+    // Only squares closer to the target are considered, so that the path always ends.
+    for (Vec2 dir : directions(pos)) {
+      Vec2 v = pos + dir;
+      if (v.inRectangle(distance.getBounds()) && distance[v] < distance[pos]) {
+        double cost = distance[v] + (extraCost && v != target ? extraCost(v) : 0);
+        if (!next || cost < lowest) {
+          lowest = cost;
+          next = v;
+        }
+      }
+    }
+    CHECK(!!next) << "Can't track path from " << from << " to " << target;
+    pos = *next;
+    ret.push_back(pos);
+  }
+  return ret.reverse();
+}
+
+const int maxFlowFields = 8;
+const int maxFlowFieldEntries = 100;
+
+const FlowField* FlowFieldCache::get(const Key& key, Generation generation, function<FlowField()> build) {
+  PROFILE;
+  ++numRequests;
+  trim(key);
+  auto& entry = entries[key];
+  if (entry.generation != generation)
+    entry = Entry{generation, 0, 0, none};
+  entry.lastUsed = numRequests;
+  if (!entry.field && ++entry.numRequests >= 2)
+    entry.field = build();
+  return entry.field ? &*entry.field : nullptr;
+}
+
+void FlowFieldCache::trim(const Key& keep) {
+  // Drops the least recently used entries other than the requested one, keeping room for it and its field.
+  auto getLeastRecentlyUsed = [&](bool withField) {
+    optional<Key> ret;
+    int lastUsed = numRequests;
+    for (auto& elem : entries)
+      if (elem.first != keep && (!withField || elem.second.field) && elem.second.lastUsed < lastUsed) {
+        ret = elem.first;
+        lastUsed = elem.second.lastUsed;
+      }
+    return ret;
+  };
+  while (entries.size() >= maxFlowFieldEntries)
+    entries.erase(*getLeastRecentlyUsed(false));
+  int numFields = 0;
+  for (auto& elem : entries)
+    if (elem.first != keep && elem.second.field)
+      ++numFields;
+  for (; numFields >= maxFlowFields; --numFields)
+    entries.at(*getLeastRecentlyUsed(true)).field = none;
+}
+
+void FlowFieldCache::clear() {
+  entries.clear();
+}
@@ -0,0 +1,60 @@
+/* Copyright (C) 2013-2014 Michal Brzozowski (rusolis@poczta.fm)
+
+   This file is part of KeeperRL.
+
+   KeeperRL is free software; you can redistribute it and/or modify it under the terms of the
+   GNU General Public License as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   KeeperRL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+   even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with this program.
+   If not, see http://www.gnu.org/licenses/ . */
+
+#pragma once
+
+#include "util.h"
+#include "movement_type.h"
+
+// Distances to a target from every square of an area, using the same costs as ShortestPath.
+class FlowField {
+  public:
+  FlowField(Rectangle area, Vec2 target, function<double(Vec2)> entryFun, function<vector<Vec2>(Vec2)> directions);
+  bool isReachable(Vec2) const;
+  double getDistance(Vec2) const;
+  Vec2 getTarget() const;
+  // Returns the path to the target ordered like ShortestPath::getPath(), or an empty path if it's not reachable.
+  // extraCost is added to the distances of the squares considered at every step, so that the path can avoid
+  // temporary obstacles that the field doesn't include.
+  vector<Vec2> getPath(Vec2 from, function<vector<Vec2>(Vec2)> directions,
+      function<double(Vec2)> extraCost = nullptr) const;
+
+  private:
+  Table<float> distance;
+  Vec2 target;
+};
+
+// Flow fields of a level shared by all creatures heading to the same square. A field is built once its target is
+// requested for the second time, and is rebuilt after the generation of the navigation data changes.
+class FlowFieldCache {
+  public:
+  using Key = pair<Vec2, MovementType>;
+  // LevelShortestPath::NavigationGeneration, so that changes of costs that don't change sectors are noticed.
+  using Generation = tuple<long long, long long, int>;
+  // Returns nullptr if the field isn't built.
+  const FlowField* get(const Key&, Generation, function<FlowField()> build);
+  void clear();
+
+  private:
+  struct Entry {
+    Generation generation;
+    int numRequests;
+    int lastUsed;
+    optional<FlowField> field;
+  };
+  HashMap<Key, Entry> entries;
+  int numRequests = 0;
+  void trim(const Key&);
+};
@@ -146,7 +146,7 @@ void Furniture::destroy(Position pos, const DestroyAction& action, Creature* des
   auto myLayer = layer;
   auto myType = type;
   if (itemDrop)
-    pos.dropItems(itemDrop->random(pos.getGame()->getContentFactory(), pos.getModelDifficulty()));
+    pos.dropItems(itemDrop->random(pos.getRandom(), pos.getGame()->getContentFactory(), pos.getModelDifficulty()));
   if (destroyFX)
     pos.getGame()->addEvent(EventInfo::FX{pos, *destroyFX});
   auto effect = destroyedEffect;
@@ -164,6 +164,7 @@ void Furniture::tryToDestroyBy(Position pos, Creature* c, const DestroyAction& a
   if (auto& info = destroyedInfo[action.getType()]) {
     double damage = action.getDamage(c);
     info->health -= damage / info->strength;
+    pos.updateNavigationCost();
     updateViewObject();
     pos.setNeedsRenderAndMemoryUpdate(true);
     if (tryDestroyFX)
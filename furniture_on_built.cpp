@@ -93,9 +93,9 @@ void handleOnBuilt(Position pos, Furniture* f, FurnitureOnBuilt type) {
         auto newLevel = tryBuilding(50,
             [&](bool withEnemies) {
               auto contentFactory = pos.getGame()->getContentFactory();
-              auto maker = getUpLevel(Random, contentFactory, -levelIndex + 1, pos, withEnemies);
+              auto maker = getUpLevel(pos.getRandom(), contentFactory, -levelIndex + 1, pos, withEnemies);
               auto level = pos.getModel()->buildUpLevel(contentFactory,
-                  LevelBuilder(Random, contentFactory, levelSize.x, levelSize.y, true), std::move(maker.maker));
+                  LevelBuilder(pos.getRandom(), contentFactory, levelSize.x, levelSize.y, true), std::move(maker.maker));
               return ZLevelResult{ level, maker.enemies.transform([&](auto& e) { return e.buildCollective(contentFactory); })};
             },
             "z-level " + toString(levelIndex));
@@ -115,11 +115,11 @@ void handleOnBuilt(Position pos, Furniture* f, FurnitureOnBuilt type) {
         auto newLevel = tryBuilding(50,
             [&](bool withEnemies) {
               auto contentFactory = pos.getGame()->getContentFactory();
-              auto maker = getLevelMaker(Random, contentFactory, pos.getGame()->zLevelGroups,
+              auto maker = getLevelMaker(pos.getRandom(), contentFactory, pos.getGame()->zLevelGroups,
                   withEnemies ? levelIndex + 1 : 1, pos.getGame()->getPlayerCollective()->getTribeId(), levelSize,
                   pos.getGame()->getEnemyAggressionLevel());
               auto level = pos.getModel()->buildMainLevel(contentFactory,
-                  LevelBuilder(Random, contentFactory, levelSize.x, levelSize.y, true),
+                  LevelBuilder(pos.getRandom(), contentFactory, levelSize.x, levelSize.y, true),
                       std::move(maker.maker));
               return ZLevelResult{ level, maker.enemies.transform([&](auto& e) { return e.buildCollective(contentFactory); })};
             },
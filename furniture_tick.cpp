@@ -61,16 +61,16 @@ static void handle(const FurnitureTickTypes::MeteorShower, Position position, Fu
   const int areaWidth = 3;
   const int range = 4;
   for (int i : Range(10)) {
-    Position targetPoint = position.plus(Vec2(Random.get(-areaWidth / 2, areaWidth / 2 + 1),
-                     Random.get(-areaWidth / 2, areaWidth / 2 + 1)));
-    Vec2 direction(Random.get(-1, 2), Random.get(-1, 2));
+    Position targetPoint = position.plus(Vec2(position.getRandom().get(-areaWidth / 2, areaWidth / 2 + 1),
+                     position.getRandom().get(-areaWidth / 2, areaWidth / 2 + 1)));
+    Vec2 direction(position.getRandom().get(-1, 2), position.getRandom().get(-1, 2));
     if (!targetPoint.isValid() || direction.length8() == 0)
       continue;
     for (int i : Range(range + 1))
       if (!targetPoint.plus(direction * i).canEnter(MovementType({MovementTrait::WALK, MovementTrait::FLY})))
         continue;
     targetPoint.plus(direction * range).throwItem(
-        makeVec(ItemType(CustomItemId("Rock")).get(position.getGame()->getContentFactory())),
+        makeVec(ItemType(CustomItemId("Rock")).get(position.getRandom(), position.getGame()->getContentFactory())),
         Attack(furniture->getCreator(), AttackLevel::MIDDLE, AttackType::HIT, 25, AttrType("DAMAGE")),
         10,
         position.minus(direction),
@@ -80,8 +80,8 @@ static void handle(const FurnitureTickTypes::MeteorShower, Position position, Fu
 }
 
 static void handle(const FurnitureTickTypes::Pit, Position position, Furniture* self) {
-  if (!position.getCreature() && Random.roll(10))
-    for (auto neighborPos : position.neighbors8(Random))
+  if (!position.getCreature() && position.getRandom().roll(10))
+    for (auto neighborPos : position.neighbors8(position.getRandom()))
       if (auto water = neighborPos.getFurniture(FurnitureLayer::GROUND))
         if (auto fillType = water->getFillPit()) {
           auto toAdd = position.getGame()->getContentFactory()->furniture.getFurniture(*fillType, water->getTribe());
@@ -55,7 +55,7 @@ static void usePortal(Position pos, Creature* c) {
             pos.moveCreature(*otherPos, true);
             return;
           }
-          for (Position v : otherPos->neighbors8(Random))
+          for (Position v : otherPos->neighbors8(pos.getRandom()))
             if (pos.canMoveCreature(v)) {
               pos.moveCreature(v, true);
               return;
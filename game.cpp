@@ -48,6 +48,7 @@
 #include "enemy_aggression_level.h"
 #include "unlocks.h"
 #include "progress_meter.h"
+#include "thread_pool.h"
 #ifdef USE_STEAMWORKS
 #  include "steam_achievements.h"
 #endif
@@ -354,6 +355,7 @@ static const TimeInterval initialModelUpdate = 2_visible;
 void Game::initializeModels(ProgressMeter& meter) {
   for (auto col : getCollectives())
     col->update(col->getModel() == getCurrentModel());
+  vector<Model*> toUpdate;
   // Give every model a couple of turns so that things like shopkeepers can initialize.
   for (Vec2 v : models.getBounds())
     if (auto model = models[v].get()) {
@@ -370,22 +372,44 @@ void Game::initializeModels(ProgressMeter& meter) {
       if (!localTime.count(id))
         localTime[id] = (model->getLocalTime() + initialModelUpdate).getDouble();
       if (getCurrentModel() != model)
-        updateModel(model, localTime[id], none);
+        toUpdate.push_back(model);
+      else
+        meter.addProgress();
+    }
+  if (options && options->getBoolValue(OptionId::PARALLEL_MODEL_UPDATE) &&
+      !options->getBoolValue(OptionId::SINGLE_THREAD))
+    updateModelsInParallel(toUpdate, meter);
+  else
+    for (auto model : toUpdate) {
+      updateModel(model, localTime.at(model->getGroundLevel()->getUniqueId()), none);
       meter.addProgress();
     }
 }
 
+void Game::updateModelsInParallel(const vector<Model*>& toUpdate, ProgressMeter& meter) {
+  updatingInParallel = true;
+  ThreadPool::get().run(toUpdate.size(), [&] (int index) {
+    auto model = toUpdate[index];
+    updateModel(model, localTime.at(model->getGroundLevel()->getUniqueId()), none);
+    meter.addProgress();
+  });
+  updatingInParallel = false;
+  while (auto action = deferredActions.popAsync())
+    (*action)();
+}
+
+bool Game::deferIfParallel(function<void()> action) {
+  if (!updatingInParallel)
+    return false;
+  deferredActions.push(std::move(action));
+  return true;
+}
+
 void Game::increaseTime(double diff) {
-  auto before = getGlobalTime();
   currentTime += diff;
-  auto after = getGlobalTime();
-  if (after > before)
-    for (auto m : getAllModels())
-      for (auto c : m->getAllCreatures())
-        c->setGlobalTime(after);
 }
 
-optional<ExitInfo> Game::update(double timeDiff, milliseconds endTime) {
+optional<ExitInfo> Game::update(double timeDiff, optional<milliseconds> endTime) {
   //CHECK(timeDiff >= 0); this will probably fail - check
   PROFILE_BLOCK("Game::update");
   if (auto exitInfo = updateInput())
@@ -532,6 +556,8 @@ Position Game::getTransferPos(Model* from, Model* to) const {
 }
 
 void Game::transferCreature(Creature* c, Model* to, const vector<Position>& destinations) {
+  if (deferIfParallel([=] { if (!c->isDead()) transferCreature(c, to, destinations); }))
+    return;
   Model* from = c->getLevel()->getModel();
   if (from != to && !c->getRider()) {
     if (destinations.empty())
@@ -965,6 +991,8 @@ void Game::clearPlayerControl() {
 }
 
 void Game::addEvent(const GameEvent& event) {
+  if (deferIfParallel([=] { addEvent(event); }))
+    return;
   if (event.contains<EventInfo::CreatureMoved>() && !!playerControl)
     playerControl->onEvent(event); // shortcut to optimize because only PlayerControl cares about this event
   else
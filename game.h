@@ -41,7 +41,7 @@ class Game : public OwnedObject<Game> {
   static PGame splashScreen(PModel&&, const CampaignSetup&, ContentFactory, View*);
   static PGame warlordGame(Table<PModel>, CampaignSetup, vector<PCreature>, ContentFactory, string avatarId);
 
-  optional<ExitInfo> update(double timeDiff, milliseconds endTime);
+  optional<ExitInfo> update(double timeDiff, optional<milliseconds> endTime);
   void setExitInfo(ExitInfo);
   Options* getOptions();
   Encyclopedia* getEncyclopedia();
@@ -112,6 +112,8 @@ class Game : public OwnedObject<Game> {
   void addCollective(Collective*);
 
   void addEvent(const GameEvent&);
+  /** Queues the action until the parallel model update finishes, if one is running. Returns false otherwise. */
+  bool deferIfParallel(function<void()>);
   void addAnalytics(const string& name, const string& value);
   void achieve(AchievementId) const;
   void setWasTransfered();
@@ -130,6 +132,7 @@ class Game : public OwnedObject<Game> {
   private:
   void tick(GlobalTime);
   bool updateModel(Model*, double timeDiff, optional<milliseconds> endTime);
+  void updateModelsInParallel(const vector<Model*>&, ProgressMeter&);
   void uploadEvent(const string& name, const map<string, string>&);
   void considerAchievement(const GameEvent&);
 
@@ -158,6 +161,10 @@ class Game : public OwnedObject<Game> {
   Collective* SERIAL(playerCollective) = nullptr;
   HeapAllocated<Campaign> SERIAL(campaign);
   bool wasTransfered = false;
+  // Set while inactive models are updated on worker threads. Actions that reach across models are
+  // queued in the meantime and applied on the main thread once all workers are done.
+  atomic<bool> updatingInParallel {false};
+  SyncQueue<function<void()>> deferredActions;
   vector<Creature*> SERIAL(players);
   FileSharing* fileSharing = nullptr;
   set<int> SERIAL(turnEvents);
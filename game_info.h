@@ -455,6 +455,9 @@ class GameInfo {
   GlobalTime HASH(time);
   int HASH(modifiedSquares);
   int HASH(totalSquares);
+  int HASH(sectorsMovementTypes) = 0;
+  int HASH(distinctSectors) = 0;
+  int HASH(sectorsMemory) = 0;
 
   GameInfo() {}
   GameInfo(const GameInfo&) = delete;
@@ -472,7 +475,7 @@ class GameInfo {
   vector<ScriptedHelpInfo> scriptedHelp; // this won't change during the game so don't hash
   vector<PlayerMessage> HASH(messageBuffer);
   bool HASH(takingScreenshot) = false;
-  HASH_ALL(infoType, time, playerInfo, villageInfo, sunlightInfo, messageBuffer, modifiedSquares, totalSquares, tutorial, currentLevel, takingScreenshot, isSingleMap)
+  HASH_ALL(infoType, time, playerInfo, villageInfo, sunlightInfo, messageBuffer, modifiedSquares, totalSquares, sectorsMovementTypes, distinctSectors, sectorsMemory, tutorial, currentLevel, takingScreenshot, isSingleMap)
 };
 
 struct AutomatonPart;
@@ -0,0 +1,171 @@
+/* Copyright (C) 2013-2014 Michal Brzozowski (rusolis@poczta.fm)
+
+   This file is part of KeeperRL.
+
+   KeeperRL is free software; you can redistribute it and/or modify it under the terms of the
+   GNU General Public License as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   KeeperRL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+   even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with this program.
+   If not, see http://www.gnu.org/licenses/ . */
+
+#include "stdafx.h"
+#include "util.h"
+#include "gas_grid.h"
+
+SERIALIZE_DEF(GasGrid, planes, bounds)
+
+SERIALIZATION_CONSTRUCTOR_IMPL(GasGrid)
+
+GasGrid::GasGrid(Rectangle b) : bounds(b) {
+}
+
+double GasGrid::getFogVisionCutoff() {
+  return 0.2;
+}
+
+GasGrid::Plane& GasGrid::getPlane(TileGasType type) {
+  if (auto res = getReferenceMaybe(planes, type))
+    return *res;
+  return planes.insert(make_pair(type, Plane{Table<float>(bounds, 0), Table<float>(bounds, 0), none})).first->second;
+}
+
+double GasGrid::getAmount(TileGasType type, Vec2 pos) const {
+  if (auto plane = getReferenceMaybe(planes, type))
+    return plane->total[pos];
+  return 0;
+}
+
+bool GasGrid::hasSunlightBlockingAmount(Vec2 pos) const {
+  for (auto& elem : planes)
+    if (elem.second.total[pos] > getFogVisionCutoff())
+      return true;
+  return false;
+}
+
+bool GasGrid::addAmount(TileGasType type, Vec2 pos, double amount) {
+  CHECK(amount > 0);
+  auto& plane = getPlane(type);
+  auto prevValue = plane.total[pos];
+  plane.total[pos] = min(1., amount + plane.total[pos]);
+  if (plane.total[pos] > plane.permanent[pos])
+    plane.active = plane.active ? Rectangle::boundingBox({plane.active->topLeft(),
+        plane.active->bottomRight() - Vec2(1, 1), pos}) : Rectangle(pos, pos + Vec2(1, 1));
+  return prevValue < getFogVisionCutoff() && plane.total[pos] >= getFogVisionCutoff();
+}
+
+void GasGrid::addPermanentAmount(TileGasType type, Vec2 pos, double amount) {
+  auto& plane = getPlane(type);
+  plane.total[pos] = min(1.0, plane.total[pos] + amount);
+  plane.permanent[pos] = min(1.0, plane.permanent[pos] + amount);
+}
+
+vector<TileGasType> GasGrid::getActiveTypes() const {
+  vector<TileGasType> ret;
+  for (auto& elem : planes)
+    if (elem.second.active)
+      ret.push_back(elem.first);
+  return ret;
+}
+
+// Gas above the permanent amount that is less than this disappears instead of spreading.
+static const float minSpreadAmount = 0.1;
+
+static void decayGas(const float* total, const float* permanent, float* newTotal, int size, float decrease) {
+  for (int i = 0; i < size; ++i) {
+    float excess = total[i] - permanent[i];
+    newTotal[i] = excess >= minSpreadAmount ? permanent[i] + excess * decrease : permanent[i];
+  }
+}
+
+// The buffers are column-major with a one square margin. Each square sends gas to all lower neighbors
+// that it can spread to, up to spread per turn (half of it diagonally) and at most half of the difference,
+// scaled down if it would give away more than its amount above the permanent level. All flows are computed from
+// the amounts at the start of the turn, so the loops don't depend on the order of squares. source, scale and
+// outFlow are work buffers that must be zeroed.
+static void spreadGas(const float* total, const float* permanent, const float* target, float* newTotal,
+    float* source, float* scale, float* outFlow, int height, int size, float spread, float decrease) {
+  const int offsets[] = {-height, height, -1, 1, -height - 1, -height + 1, height - 1, height + 1};
+  const float weights[] = {1, 1, 1, 1, 0.5, 0.5, 0.5, 0.5};
+  const int begin = height + 1;
+  const int end = size - height - 1;
+  for (int i = begin; i < end; ++i)
+    source[i] = total[i] - permanent[i] >= minSpreadAmount ? 1 : 0;
+  for (int i = begin; i < end; ++i) {
+    float out = 0;
+    for (int d = 0; d < 8; ++d) {
+      int j = i + offsets[d];
+      out += target[j] * min(weights[d] * spread, max(0.0f, total[i] - total[j]) / 2);
+    }
+    out *= source[i];
+    float excess = total[i] - permanent[i];
+    scale[i] = excess < out ? excess / out : 1.0f;
+    outFlow[i] = out * scale[i];
+  }
+  for (int i = begin; i < end; ++i) {
+    float in = 0;
+    for (int d = 0; d < 8; ++d) {
+      int j = i + offsets[d];
+      in += source[j] * scale[j] * min(weights[d] * spread, max(0.0f, total[j] - total[i]) / 2);
+    }
+    in *= target[i];
+    float own = total[i] - outFlow[i];
+    own = source[i] > 0 ? permanent[i] + (own - permanent[i]) * decrease : permanent[i];
+    newTotal[i] = min(1.0f, own + in);
+  }
+}
+
+vector<GasGrid::Update> GasGrid::tick(TileGasType type, double spread, double decrease,
+    function<bool(Vec2)> canSpreadTo) {
+  PROFILE;
+  auto& plane = planes.at(type);
+  if (!plane.active)
+    return {};
+  auto region = plane.active->minusMargin(-1).intersection(bounds);
+  const int height = region.height() + 2;
+  const int size = (region.width() + 2) * height;
+  auto getIndex = [&](Vec2 v) { return (v.x - region.left() + 1) * height + v.y - region.top() + 1; };
+  for (auto buffer : {&buffers.total, &buffers.permanent, &buffers.target, &buffers.newTotal, &buffers.source,
+      &buffers.scale, &buffers.outFlow}) {
+    buffer->clear();
+    buffer->resize(size);
+  }
+  auto& total = buffers.total;
+  auto& permanent = buffers.permanent;
+  auto& newTotal = buffers.newTotal;
+  for (auto v : region) {
+    auto index = getIndex(v);
+    total[index] = plane.total[v];
+    permanent[index] = plane.permanent[v];
+  }
+  if (spread > 0) {
+    auto& target = buffers.target;
+    for (auto v : region)
+      if (canSpreadTo(v))
+        target[getIndex(v)] = 1;
+    spreadGas(total.data(), permanent.data(), target.data(), newTotal.data(), buffers.source.data(),
+        buffers.scale.data(), buffers.outFlow.data(), height, size, spread, decrease);
+  } else
+    decayGas(total.data(), permanent.data(), newTotal.data(), size, decrease);
+  vector<Update> ret;
+  vector<Vec2> active;
+  for (auto v : region) {
+    auto index = getIndex(v);
+    float before = total[index];
+    float after = newTotal[index];
+    plane.total[v] = after;
+    if (before > 0 || after != before)
+      ret.push_back(Update{v, before, after});
+    if (after > permanent[index])
+      active.push_back(v);
+  }
+  if (active.empty())
+    plane.active = none;
+  else
+    plane.active = Rectangle::boundingBox(active);
+  return ret;
+}
@@ -0,0 +1,67 @@
+/* Copyright (C) 2013-2014 Michal Brzozowski (rusolis@poczta.fm)
+
+   This file is part of KeeperRL.
+
+   KeeperRL is free software; you can redistribute it and/or modify it under the terms of the
+   GNU General Public License as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   KeeperRL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+   even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with this program.
+   If not, see http://www.gnu.org/licenses/ . */
+
+#pragma once
+
+#include "util.h"
+#include "tile_gas_type.h"
+
+// Gas amounts of a whole level, stored as one plane per gas type. Only the bounding box of squares
+// holding more than their permanent amount is simulated.
+class GasGrid {
+  public:
+  GasGrid(Rectangle bounds);
+
+  static double getFogVisionCutoff();
+
+  double getAmount(TileGasType, Vec2) const;
+  bool hasSunlightBlockingAmount(Vec2) const;
+  // Returns true if the amount crossed getFogVisionCutoff().
+  bool addAmount(TileGasType, Vec2, double amount);
+  void addPermanentAmount(TileGasType, Vec2, double amount);
+  vector<TileGasType> getActiveTypes() const;
+
+  struct Update {
+    Vec2 pos;
+    double before;
+    double after;
+  };
+  // Spreads and decays the gas. Returns all simulated squares that held any gas or whose amount changed.
+  vector<Update> tick(TileGasType, double spread, double decrease, function<bool(Vec2)> canSpreadTo);
+
+  SERIALIZATION_DECL(GasGrid)
+
+  private:
+  struct Plane {
+    Table<float> SERIAL(total);
+    Table<float> SERIAL(permanent);
+    optional<Rectangle> SERIAL(active);
+    SERIALIZE_ALL(total, permanent, active)
+  };
+  Plane& getPlane(TileGasType);
+  HashMap<TileGasType, Plane> SERIAL(planes);
+  Rectangle SERIAL(bounds);
+  // Work buffers of tick(), kept so that they aren't allocated every turn.
+  struct Buffers {
+    vector<float> total;
+    vector<float> permanent;
+    vector<float> target;
+    vector<float> newTotal;
+    vector<float> source;
+    vector<float> scale;
+    vector<float> outFlow;
+  };
+  Buffers buffers;
+};
@@ -589,7 +589,8 @@ const char* GuiBuilder::getCurrentGameSpeedName() const {
 SGuiElem GuiBuilder::drawRightBandInfo(GameInfo& info) {
   auto getIconHighlight = [&] (Color c) { return WL(topMargin, -1, WL(uiHighlight, c.transparency(120))); };
   auto& collectiveInfo = *info.playerInfo.getReferenceMaybe<CollectiveInfo>();
-  int hash = combineHash(collectiveInfo, info.villageInfo, info.modifiedSquares, info.totalSquares, info.tutorial);
+  int hash = combineHash(collectiveInfo, info.villageInfo, info.modifiedSquares, info.totalSquares,
+      info.sectorsMovementTypes, info.distinctSectors, info.sectorsMemory, info.tutorial);
   if (hash != rightBandInfoHash) {
     rightBandInfoHash = hash;
     vector<SGuiElem> buttons = makeVec(
@@ -696,6 +697,9 @@ SGuiElem GuiBuilder::drawRightBandInfo(GameInfo& info) {
     ));
     int modifiedSquares = info.modifiedSquares;
     int totalSquares = info.totalSquares;
+    int sectorsMovementTypes = info.sectorsMovementTypes;
+    int distinctSectors = info.distinctSectors;
+    int sectorsMemory = info.sectorsMemory;
     bottomLine.addBackElem(WL(stack,
         WL(labelFun, [=]()->string {
           switch (counterMode) {
@@ -707,9 +711,12 @@ SGuiElem GuiBuilder::drawRightBandInfo(GameInfo& info) {
               return "LAT " + toString(fpsCounter.getMaxLatency()) + "ms / " + toString(upsCounter.getMaxLatency()) + "ms";
             case CounterMode::SMOD:
               return "SMOD " + toString(modifiedSquares) + "/" + toString(totalSquares);
+            case CounterMode::SECT:
+              return "SECT " + toString(distinctSectors) + "/" + toString(sectorsMovementTypes) + " " +
+                  toString(sectorsMemory / 1024) + "KB";
           }
         }, Color::WHITE),
-        WL(button, [=]() { counterMode = (CounterMode) ( ((int) counterMode + 1) % 4); })), 120);
+        WL(button, [=]() { counterMode = (CounterMode) ( ((int) counterMode + 1) % 5); })), 120);
     main = WL(margin, WL(leftMargin, 10, bottomLine.buildHorizontalList()),
         std::move(main), 18, gui.BOTTOM);
     rightBandInfoCache = WL(margin, std::move(butGui), std::move(main), 55, gui.TOP);
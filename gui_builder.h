@@ -251,7 +251,7 @@ class GuiBuilder {
   const char* getCurrentGameSpeedName() const;
 
   FpsCounter fpsCounter, upsCounter;
-  enum class CounterMode { NONE, FPS, LAT, SMOD };
+  enum class CounterMode { NONE, FPS, LAT, SMOD, SECT };
   CounterMode counterMode = CounterMode::NONE;
 
   SGuiElem getButtonLine(CollectiveInfo::Button, int num, const optional<TutorialInfo>&);
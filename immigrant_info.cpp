@@ -47,9 +47,9 @@ ImmigrantInfo::ImmigrantInfo(vector<CreatureId> id, EnumSet<MinionTrait> t) : id
 
 STRUCT_IMPL(ImmigrantInfo)
 
-CreatureId ImmigrantInfo::getId(int numCreated) const {
+CreatureId ImmigrantInfo::getId(RandomGen& random, int numCreated) const {
   if (!consumeIds)
-    return Random.choose(ids);
+    return random.choose(ids);
   else
     return ids[numCreated];
 }
@@ -126,7 +126,7 @@ class ImmigrantInfo {
   ImmigrantInfo(CreatureId, EnumSet<MinionTrait>);
   ImmigrantInfo(vector<CreatureId>, EnumSet<MinionTrait>);
   STRUCT_DECLARATIONS(ImmigrantInfo)
-  CreatureId getId(int numCreated) const;
+  CreatureId getId(RandomGen&, int numCreated) const;
   CreatureId getNonRandomId(int numCreated) const;
   bool isAvailable(int numCreated) const;
   const SpawnLocation& getSpawnLocation() const;
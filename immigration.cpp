@@ -331,7 +331,7 @@ static vector<Position> pickSpawnPositions(const vector<Creature*>& creatures, c
     };
     optional<Position> mySpawnPos;
     for (int i : Range(100))
-      if (auto pos = goodPos(Random.choose(allPositions))) {
+      if (auto pos = goodPos(allPositions.front().getRandom().choose(allPositions))) {
         mySpawnPos = pos;
         break;
       }
@@ -443,7 +443,7 @@ vector<Creature*> Immigration::Available::addAllCreatures(const vector<Position>
   auto game = collective->getGame();
   info.visitRequirements(makeVisitor(
       [&](const RecruitmentInfo& recruitmentInfo) {
-        auto recruits = recruitmentInfo.getAvailableRecruits(collective, info.getId(0));
+        auto recruits = recruitmentInfo.getAvailableRecruits(collective, info.getId(collective->getRandom(), 0));
         if (!recruits.empty()) {
           Creature* c = recruits[0];
           collective->addCreature(c, info.getTraits());
@@ -521,7 +521,7 @@ SERIALIZE_DEF(Immigration::Available, creatures, immigrantIndex, endTime, immigr
 SERIALIZATION_CONSTRUCTOR_IMPL2(Immigration::Available, Available)
 
 Immigration::Available Immigration::Available::generate(Immigration* immigration, int index) {
-  return generate(immigration, Group {index, Random.get(immigration->immigrants[index].getGroupSize()) });
+  return generate(immigration, Group {index, immigration->collective->getRandom().get(immigration->immigrants[index].getGroupSize()) });
 }
 
 int Immigration::getNumGeneratedAndCandidates(int index) const {
@@ -542,19 +542,20 @@ Immigration::Available Immigration::Available::generate(Immigration* immigration
   auto collective = immigration->collective;
   auto game = collective->getGame();
   auto contentFactory = game->getContentFactory();
+  auto& random = collective->getRandom();
   for (int i : Range(group.count)) {
     if (collective->getConfig().getStripSpawns() && info.stripEquipment)
       immigrants.push_back(contentFactory->getCreatures().
-          fromIdNoInventory(info.getId(numGenerated), collective->getTribeId(),
+          fromIdNoInventory(random, info.getId(random, numGenerated), collective->getTribeId(),
               MonsterAIFactory::collective(collective)));
     else
       immigrants.push_back(contentFactory->getCreatures().
-          fromId(info.getId(numGenerated), collective->getTribeId(),
+          fromId(random, info.getId(random, numGenerated), collective->getTribeId(),
               MonsterAIFactory::collective(collective)));
     for (auto& specialTrait : info.getSpecialTraits())
-      if (Random.chance(specialTrait.prob)) {
+      if (random.chance(specialTrait.prob)) {
         for (auto& trait1 : specialTrait.traits) {
-          auto trait = transformBeforeApplying(trait1);
+          auto trait = transformBeforeApplying(random, trait1);
           specialTraits.push_back(trait);
         }
       }
@@ -611,7 +612,7 @@ void Immigration::resetImmigrantTime() {
       interval.getDouble());
   nextImmigrantTime = max(
       collective->getGlobalTime(),
-      GlobalTime((int) (interval.getDouble() * (Random.getDouble() + 1 + lastImmigrantIndex))));
+      GlobalTime((int) (interval.getDouble() * (collective->getRandom().getDouble() + 1 + lastImmigrantIndex))));
 }
 
 void Immigration::considerRespawningHorses() {
@@ -626,8 +627,9 @@ void Immigration::considerRespawningHorses() {
         if (!existing.contains(c))
           toRemove.insert(c);
       for (auto c : toRemove) {
-        auto clone = contentFactory->getCreatures().fromIdNoInventory(elem->getId(0), collective->getTribeId(),
-            MonsterAIFactory::collective(collective));
+        auto& random = collective->getRandom();
+        auto clone = contentFactory->getCreatures().fromIdNoInventory(random, elem->getId(random, 0),
+            collective->getTribeId(), MonsterAIFactory::collective(collective));
         vector<Creature*> v { clone.get() };
         auto pos = pickSpawnPositions(v, getSpawnPositions(collective, *elem));
         if (!pos.empty())
@@ -654,18 +656,18 @@ void Immigration::update() {
   for (auto elem : Iter(available))
     if (getValueMaybe(autoState, elem->second.immigrantIndex) == ImmigrantAutoState::AUTO_ACCEPT)
       accept(elem->first);
-  if (Random.roll(30))
+  if (collective->getRandom().roll(30))
     considerRespawningHorses();
   if (!nextImmigrantTime || *nextImmigrantTime < collective->getGlobalTime()) {
     vector<Group> immigrantInfo;
     for (auto elem : Iter(immigrants))
-      immigrantInfo.push_back(Group {elem.index(), Random.get(elem->getGroupSize())});
+      immigrantInfo.push_back(Group {elem.index(), collective->getRandom().get(elem->getGroupSize())});
     vector<double> weights = immigrantInfo.transform(
         [&](const Group& group) { return getImmigrantChance(group);});
     if (std::accumulate(weights.begin(), weights.end(), 0.0) > 0) {
       ++idCnt;
       if (available.size() < 10 || collective->getConfig().getImmigrantInterval() > 10_visible)
-        available.emplace(idCnt, Available::generate(this, Random.choose(immigrantInfo, weights)));
+        available.emplace(idCnt, Available::generate(this, collective->getRandom().choose(immigrantInfo, weights)));
       available[idCnt].createdTime = Clock::getRealMillis();
       resetImmigrantTime();
     }
@@ -15,9 +15,9 @@ IntrinsicAttack& IntrinsicAttack::operator =(const IntrinsicAttack& o) {
   return *this;
 }
 
-void IntrinsicAttack::initializeItem(const ContentFactory* factory) {
+void IntrinsicAttack::initializeItem(RandomGen& random, const ContentFactory* factory) {
   if (!item)
-    item = itemType.get(factory);
+    item = itemType.get(random, factory);
 }
 
 SERIALIZATION_CONSTRUCTOR_IMPL(IntrinsicAttack)
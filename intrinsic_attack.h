@@ -11,7 +11,7 @@ struct IntrinsicAttack {
   IntrinsicAttack& operator = (const IntrinsicAttack&);
   IntrinsicAttack(IntrinsicAttack&&) = default;
   IntrinsicAttack& operator = (IntrinsicAttack&&) = default;
-  void initializeItem(const ContentFactory*);
+  void initializeItem(RandomGen&, const ContentFactory*);
   SERIALIZATION_DECL(IntrinsicAttack)
   PItem SERIAL(item);
   ItemType SERIAL(itemType);
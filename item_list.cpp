@@ -48,27 +48,27 @@ vector<ItemType> ItemList::getAllItems() const {
   return ret;
 }
 
-vector<PItem> ItemList::random(const ContentFactory* factory, int difficulty) & {
+vector<PItem> ItemList::random(RandomGen& random, const ContentFactory* factory, int difficulty) & {
   while (!multiItems.empty() && multiItems.back().count == Range::singleElem(0))
     multiItems.pop_back();
   if (!multiItems.empty()) {
     auto& item = multiItems.back();
     if (item.count.getLength() > 1)
-      item.count = Range::singleElem(Random.get(item.count));
+      item.count = Range::singleElem(random.get(item.count));
     if (item.count.getStart() > 0) {
       item.count = Range::singleElem(item.count.getStart() - 1);
       vector<PItem> res;
       for (auto& id : item.items)
-        if (Random.chance(id.second))
-          res.push_back(id.first.get(factory));
+        if (random.chance(id.second))
+          res.push_back(id.first.get(random, factory));
       return res;
     }
   }
   if (unique.size() > 0) {
     ItemType id = unique.back().first;
-    int cnt = Random.get(unique.back().second);
+    int cnt = random.get(unique.back().second);
     unique.pop_back();
-    return id.get(cnt, factory);
+    return id.get(random, cnt, factory);
   }
   auto availableItems = [&] {
     for (auto& it : items)
@@ -78,10 +78,10 @@ vector<PItem> ItemList::random(const ContentFactory* factory, int difficulty) &
   };
   if (!availableItems())
     return {};
-  int index = Random.get(items.transform([&](const auto& elem) {
+  int index = random.get(items.transform([&](const auto& elem) {
     return elem.minDifficulty <= difficulty ? elem.weight : 0.0;
   }));
-  return items[index].id.get(Random.get(items[index].count), factory);
+  return items[index].id.get(random, random.get(items[index].count), factory);
 }
 
 SERIALIZE_DEF(ItemList, OPTION(items), OPTION(unique), OPTION(multiItems))
@@ -135,10 +135,11 @@ class Corpse : public Item {
       rottenTime = time + rottingTime;
     if (time >= *rottenTime && !rotten)
       makeRotten();
-    else if (getWeight() > 10 && !corpseInfo.isSkeleton && !position.isCovered() && Random.roll(350)) {
-      for (Position v : position.neighbors8(Random)) {
-        PCreature vulture = position.getGame()->getContentFactory()->getCreatures().fromId(CreatureId("VULTURE"), TribeId::getPest(),
-            MonsterAIFactory::scavengerBird());
+    else if (getWeight() > 10 && !corpseInfo.isSkeleton && !position.isCovered() && position.getRandom().roll(350)) {
+      auto& random = position.getRandom();
+      for (Position v : position.neighbors8(random)) {
+        PCreature vulture = position.getGame()->getContentFactory()->getCreatures().fromId(random, CreatureId("VULTURE"),
+            TribeId::getPest(), MonsterAIFactory::scavengerBird());
         if (v.canEnter(vulture.get())) {
           v.addCreature(std::move(vulture));
           v.globalMessage("A vulture lands near " + getTheName());
@@ -255,17 +256,17 @@ REGISTER_TYPE(FireScrollItem)
 REGISTER_TYPE(Corpse)
 
 
-SItemAttributes ItemType::getAttributes(const ContentFactory* factory) const {
-  return type->visit<SItemAttributes>([&](const auto& t) { return t.getAttributes(factory); });
+SItemAttributes ItemType::getAttributes(RandomGen& random, const ContentFactory* factory) const {
+  return type->visit<SItemAttributes>([&](const auto& t) { return t.getAttributes(random, factory); });
 }
 
-PItem ItemType::get(const ContentFactory* factory) const {
-  auto attributes = getAttributes(factory);
+PItem ItemType::get(RandomGen& random, const ContentFactory* factory) const {
+  auto attributes = getAttributes(random, factory);
   for (auto& elem : attributes->modifiers) {
     auto var = factory->attrInfo.at(elem.first).modifierVariation;
     auto& mod = elem.second;
-    if (Random.chance(attributes->variationChance) && var > 0)
-      mod = max(1, mod + Random.get(-var, var + 1));
+    if (random.chance(attributes->variationChance) && var > 0)
+      mod = max(1, mod + random.get(-var, var + 1));
   }
   if (attributes->ingredientType)
     attributes->description = "Special crafting ingredient";
@@ -306,29 +307,29 @@ static const vector<pair<string, vector<string>>> badArtifactNames {
   {"battle axe", {"crush", "tooth", "razor", "fist", "bite", "bolt", "sword"}},
   {"war hammer", {"blade", "tooth", "bite", "bolt", "sword", "steel"}}};
 
-vector<PItem> ItemType::get(int num, const ContentFactory* factory) const {
+vector<PItem> ItemType::get(RandomGen& random, int num, const ContentFactory* factory) const {
   vector<PItem> ret;
   for (int i : Range(num))
-    ret.push_back(get(factory));
+    ret.push_back(get(random, factory));
   return ret;
 }
 
-static string getRandomPoemType() {
-  return Random.choose(makeVec<string>("poem", "haiku", "sonnet", "limerick"));
+static string getRandomPoemType(RandomGen& random) {
+  return random.choose(makeVec<string>("poem", "haiku", "sonnet", "limerick"));
 }
 
-static string getRandomPoem() {
-  return Random.choose(makeVec<string>("bad", "obscene", "vulgar")) + " " + getRandomPoemType();
+static string getRandomPoem(RandomGen& random) {
+  return random.choose(makeVec<string>("bad", "obscene", "vulgar")) + " " + getRandomPoemType(random);
 }
 
-SItemAttributes ItemTypes::Corpse::getAttributes(const ContentFactory*) const {
+SItemAttributes ItemTypes::Corpse::getAttributes(RandomGen&, const ContentFactory*) const {
   return getCorpseAttr("corpse", ItemClass::CORPSE, 100, true, none);
 }
 
-SItemAttributes ItemTypes::Poem::getAttributes(const ContentFactory* f) const {
+SItemAttributes ItemTypes::Poem::getAttributes(RandomGen& random, const ContentFactory* f) const {
   return ITATTR(
       i.viewId = ViewId("scroll");
-      i.name = getRandomPoem();
+      i.name = getRandomPoem(random);
       i.blindName = "scroll"_s;
       i.weight = 0.1;
       i.applyVerb = make_pair("read", "reads");
@@ -342,10 +343,10 @@ SItemAttributes ItemTypes::Poem::getAttributes(const ContentFactory* f) const {
   );
 }
 
-SItemAttributes ItemTypes::EventPoem::getAttributes(const ContentFactory* f) const {
+SItemAttributes ItemTypes::EventPoem::getAttributes(RandomGen& random, const ContentFactory* f) const {
   return ITATTR(
       i.viewId = ViewId("scroll");
-      i.shortName = getRandomPoemType();
+      i.shortName = getRandomPoemType(random);
       i.name = *i.shortName + " about " + eventName;
       i.blindName = "scroll"_s;
       i.weight = 0.1;
@@ -361,7 +362,7 @@ SItemAttributes ItemTypes::EventPoem::getAttributes(const ContentFactory* f) con
   );
 }
 
-SItemAttributes ItemTypes::Assembled::getAttributes(const ContentFactory* factory) const {
+SItemAttributes ItemTypes::Assembled::getAttributes(RandomGen&, const ContentFactory* factory) const {
   return ITATTR(
       auto allIds = factory->getCreatures().getViewId(creature);
       i.viewId = allIds.front();
@@ -377,7 +378,7 @@ SItemAttributes ItemTypes::Assembled::getAttributes(const ContentFactory* factor
   );
 }
 
-SItemAttributes ItemTypes::Intrinsic::getAttributes(const ContentFactory* factory) const {
+SItemAttributes ItemTypes::Intrinsic::getAttributes(RandomGen&, const ContentFactory* factory) const {
   return ITATTR(
       i.viewId = viewId;
       i.name = name;
@@ -395,7 +396,7 @@ SItemAttributes ItemTypes::Intrinsic::getAttributes(const ContentFactory* factor
  );
 }
 
-SItemAttributes ItemTypes::Ring::getAttributes(const ContentFactory* f) const {
+SItemAttributes ItemTypes::Ring::getAttributes(RandomGen&, const ContentFactory* f) const {
   return ITATTR(
       i.viewId = ViewId("ring", getColor(lastingEffect, f));
       i.shortName = getName(lastingEffect, f);
@@ -410,7 +411,7 @@ SItemAttributes ItemTypes::Ring::getAttributes(const ContentFactory* f) const {
   );
 }
 
-SItemAttributes ItemTypes::Amulet::getAttributes(const ContentFactory* f) const {
+SItemAttributes ItemTypes::Amulet::getAttributes(RandomGen&, const ContentFactory* f) const {
   return ITATTR(
       i.viewId = getAmuletViewId(lastingEffect);
       i.shortName = getName(lastingEffect, f);
@@ -425,7 +426,7 @@ SItemAttributes ItemTypes::Amulet::getAttributes(const ContentFactory* f) const
   );
 }
 
-SItemAttributes CustomItemId::getAttributes(const ContentFactory* factory) const {
+SItemAttributes CustomItemId::getAttributes(RandomGen& random, const ContentFactory* factory) const {
   if (auto ret = getReferenceMaybe(factory->items, *this)) {
     if (!!(*ret)->resourceId)
       return *ret;
@@ -433,7 +434,7 @@ SItemAttributes CustomItemId::getAttributes(const ContentFactory* factory) const
       return make_shared<ItemAttributes>(**ret);
   } else {
     USER_INFO << "Item not found: " << data() << ". Returning a rock.";
-    return CustomItemId("Rock").getAttributes(factory);
+    return CustomItemId("Rock").getAttributes(random, factory);
   }
 }
 
@@ -460,18 +461,18 @@ static SItemAttributes getPotionAttr(const ContentFactory* factory, Effect effec
   );
 }
 
-SItemAttributes ItemTypes::Potion::getAttributes(const ContentFactory* factory) const {
+SItemAttributes ItemTypes::Potion::getAttributes(RandomGen&, const ContentFactory* factory) const {
   return getPotionAttr(factory, effect, 1, "", "potion1");
 }
 
-SItemAttributes ItemTypes::Potion2::getAttributes(const ContentFactory* factory) const {
+SItemAttributes ItemTypes::Potion2::getAttributes(RandomGen&, const ContentFactory* factory) const {
   return getPotionAttr(factory, effect, 2, "concentrated ", "potion3");
 }
 
-SItemAttributes ItemTypes::PrefixChance::getAttributes(const ContentFactory* factory) const {
-  auto attributes = type->getAttributes(factory);
-  if (!attributes->genPrefixes.empty() && Random.chance(chance))
-    applyPrefix(factory, Random.choose(attributes->genPrefixes), *attributes);
+SItemAttributes ItemTypes::PrefixChance::getAttributes(RandomGen& random, const ContentFactory* factory) const {
+  auto attributes = type->getAttributes(random, factory);
+  if (!attributes->genPrefixes.empty() && random.chance(chance))
+    applyPrefix(factory, random.choose(attributes->genPrefixes), *attributes);
   return attributes;
 }
 
@@ -505,7 +506,7 @@ static ViewId getMushroomViewId(Effect e) {
   );
 }
 
-SItemAttributes ItemTypes::Mushroom::getAttributes(const ContentFactory* factory) const {
+SItemAttributes ItemTypes::Mushroom::getAttributes(RandomGen&, const ContentFactory* factory) const {
   return ITATTR(
       i.viewId = getMushroomViewId(effect);
       i.shortName = effect.getName(factory);
@@ -528,7 +529,7 @@ static ViewId getRuneViewId(const string& name) {
   return ViewId("glyph", colors[(h % colors.size() + colors.size()) % colors.size()]);
 }
 
-SItemAttributes ItemTypes::Glyph::getAttributes(const ContentFactory* factory) const {
+SItemAttributes ItemTypes::Glyph::getAttributes(RandomGen&, const ContentFactory* factory) const {
   return ITATTR(
       i.shortName = getGlyphName(factory, *rune.prefix);
       i.viewId = getRuneViewId(*i.shortName);
@@ -551,7 +552,7 @@ static ViewId getBalsamViewId(const string& name) {
   return ViewId("potion2", colors[(h % colors.size() + colors.size()) % colors.size()]);
 }
 
-SItemAttributes ItemTypes::Balsam::getAttributes(const ContentFactory* factory) const {
+SItemAttributes ItemTypes::Balsam::getAttributes(RandomGen&, const ContentFactory* factory) const {
   return ITATTR(
       i.shortName = effect.getName(factory);
       i.viewId = getBalsamViewId(*i.shortName);
@@ -566,7 +567,7 @@ SItemAttributes ItemTypes::Balsam::getAttributes(const ContentFactory* factory)
   );
 }
 
-SItemAttributes ItemTypes::Scroll::getAttributes(const ContentFactory* factory) const {
+SItemAttributes ItemTypes::Scroll::getAttributes(RandomGen&, const ContentFactory* factory) const {
   return ITATTR(
       i.viewId = ViewId("scroll");
       i.shortName = effect.getName(factory);
@@ -585,7 +586,7 @@ SItemAttributes ItemTypes::Scroll::getAttributes(const ContentFactory* factory)
   );
 }
 
-SItemAttributes ItemTypes::FireScroll::getAttributes(const ContentFactory*) const {
+SItemAttributes ItemTypes::FireScroll::getAttributes(RandomGen&, const ContentFactory*) const {
   return ITATTR(
       i.viewId = ViewId("scroll");
       i.name = "scroll of fire";
@@ -606,7 +607,7 @@ SItemAttributes ItemTypes::FireScroll::getAttributes(const ContentFactory*) cons
   );
 }
 
-SItemAttributes ItemTypes::TechBook::getAttributes(const ContentFactory*) const {
+SItemAttributes ItemTypes::TechBook::getAttributes(RandomGen&, const ContentFactory*) const {
   return ITATTR(
       i.viewId = ViewId("book");
       i.shortName = string(techId.data());
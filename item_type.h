@@ -32,9 +32,9 @@ class ItemType {
   template <class Archive>
   void serialize(Archive&, const unsigned int);
 
-  PItem get(const ContentFactory*) const;
-  vector<PItem> get(int, const ContentFactory*) const;
-  SItemAttributes getAttributes(const ContentFactory*) const;
+  PItem get(RandomGen&, const ContentFactory*) const;
+  vector<PItem> get(RandomGen&, int, const ContentFactory*) const;
+  SItemAttributes getAttributes(RandomGen&, const ContentFactory*) const;
   ItemType setPrefixChance(double chance)&&;
 
   HeapAllocated<ItemTypeVariant> SERIAL(type);
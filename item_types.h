@@ -14,7 +14,7 @@
 
 
 #define ITEM_TYPE_INTERFACE\
-  SItemAttributes getAttributes(const ContentFactory*) const
+  SItemAttributes getAttributes(RandomGen&, const ContentFactory*) const
 
 #define SIMPLE_ITEM(Name) \
   struct Name : public EmptyStruct<Name> { \
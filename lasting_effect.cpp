@@ -771,7 +771,7 @@ double LastingEffects::modifyCreatureDefense(const Creature* c, LastingEffect e,
 }
 
 void LastingEffects::onAllyKilled(Creature* c) {
-  if (Random.chance(0.05) && c->isAffected(LastingEffect::UNSTABLE)) {
+  if (c->getRandom().chance(0.05) && c->isAffected(LastingEffect::UNSTABLE)) {
     c->verb("have", "has", "gone berskerk!");
     c->addEffect(LastingEffect::INSANITY, 100_visible);
   }
@@ -791,7 +791,7 @@ bool LastingEffects::tick(Creature* c, LastingEffect effect) {
   auto factory = c->getGame()->getContentFactory();
   switch (effect) {
     case LastingEffect::ENTANGLED:
-      if (Random.chance(0.002 * max(15, c->getAttr(AttrType("DAMAGE")))))
+      if (c->getRandom().chance(0.002 * max(15, c->getAttr(AttrType("DAMAGE")))))
         c->removeEffect(LastingEffect::ENTANGLED);
       break;
     case LastingEffect::SPYING: {
@@ -801,7 +801,7 @@ bool LastingEffects::tick(Creature* c, LastingEffect effect) {
         if ((col->getTerritory().contains(c->getPosition()) ||
                col->getTerritory().getStandardExtended().contains(c->getPosition())) &&
             col->getTribe()->isEnemy(c) && !col->getCreatures().empty()) {
-          enemyId = Random.choose(col->getCreatures())->getViewObject().id();
+          enemyId = c->getRandom().choose(col->getCreatures())->getViewObject().id();
           enemy = col;
         }
       auto isTriggered = [&] {
@@ -841,12 +841,12 @@ bool LastingEffects::tick(Creature* c, LastingEffect effect) {
         bool canDie = sample >= 9000 && !c->getStatus().contains(CreatureStatus::LEADER);
         for (auto pos : c->getPosition().neighbors8())
           if (auto other = pos.getCreature())
-            if (Random.roll(10)) {
+            if (c->getRandom().roll(10)) {
               other->addEffect(LastingEffect::PLAGUE, getDuration(LastingEffect::PLAGUE));
             }
         if (suffers) {
           if (c->getBody().getHealth() > 0.5 || canDie) {
-            if (Random.roll(10)) {
+            if (c->getRandom().roll(10)) {
               c->getBody().bleed(c, 0.03);
               c->secondPerson(PlayerMessage("You suffer from plague.", MessagePriority::HIGH));
               c->thirdPerson(PlayerMessage(c->getName().the() + " suffers from plague.", MessagePriority::HIGH));
@@ -905,7 +905,7 @@ bool LastingEffects::tick(Creature* c, LastingEffect effect) {
     case LastingEffect::SUNLIGHT_VULNERABLE:
       if (c->getPosition().sunlightBurns() && !c->isAffected(LastingEffect::FROZEN)) {
         c->you(MsgType::ARE, "burnt by the sun");
-        if (Random.roll(10)) {
+        if (c->getRandom().roll(10)) {
           c->you(MsgType::YOUR, "body crumbles to dust");
           c->dieWithReason("killed by sunlight", Creature::DropType::ONLY_INVENTORY);
           return true;
@@ -913,7 +913,7 @@ bool LastingEffects::tick(Creature* c, LastingEffect effect) {
       }
       break;
     case LastingEffect::ENTERTAINER:
-      if (!doesntMove(c) && Random.roll(50)) {
+      if (!doesntMove(c) && c->getRandom().roll(50)) {
         auto others = c->getVisibleCreatures().filter([](const Creature* c) {
           return c->getBody().isHumanoid();
         });
@@ -927,7 +927,7 @@ bool LastingEffects::tick(Creature* c, LastingEffect effect) {
             hateEffects.push_back(buff.first);
         for (auto& buff : hateEffects)
           if (c->isAffected(buff) || (c->getAttributes().getHatedByEffect() != buff &&
-              Random.roll(10 * hateEffects.size()))) {
+              c->getRandom().roll(10 * hateEffects.size()))) {
             hatedGroup = buff;
             break;
           }
@@ -948,11 +948,11 @@ bool LastingEffects::tick(Creature* c, LastingEffect effect) {
       }
       break;
     case LastingEffect::BAD_BREATH:
-      if (Random.roll(50)) {
+      if (c->getRandom().roll(50)) {
         c->getPosition().globalMessage("The smell!");
         for (auto pos : c->getPosition().getRectangle(Rectangle::centered(7)))
           if (auto other = pos.getCreature())
-            if (Random.roll(5)) {
+            if (c->getRandom().roll(5)) {
               other->verb("cover your", "covers "_s + his(other->getAttributes().getGender()), "nose");
               other->addEffect(BuffId("DEF_DEBUFF"), 10_visible);
             }
@@ -41,6 +41,7 @@
 #include "collective.h"
 #include "phylactery_info.h"
 #include "content_factory.h"
+#include "tile_gas_info.h"
 #include "monster_ai.h"
 #include "furniture_layer.h"
 #include "known_tiles.h"
@@ -49,13 +50,20 @@
 #include "portals.h"
 #include "effect_type.h"
 #include "content_factory.h"
+#include "sim_benchmark.h"
 
 template <class Archive>
 void Level::serialize(Archive& ar, const unsigned int version) {
   if (Archive::is_saving::value)
     CHECK(!model->serializationLocked);
   ar & SUBCLASS(OwnedObject<Level>);
-  ar(squares, landingSquares, tickingSquares, creatures, model, fieldOfView);
+  set<Vec2> SERIAL(tickingSquareSet);
+  if (Archive::is_saving::value)
+    tickingSquareSet = tickingSquares.getAll();
+  ar(squares, landingSquares, tickingSquareSet, creatures, model, fieldOfView);
+  if (Archive::is_loading::value)
+    for (auto v : tickingSquareSet)
+      addTickingSquare(v);
   ar(sunlight, bucketMap, lightAmount, unavailable, swarmMaps, territory);
   ar(levelId, noDiagonalPassing, lightCapAmount, creatureIds, memoryUpdates, above, below, mountainLevel, furniture);
   if (version == 0) {
@@ -63,6 +71,12 @@ void Level::serialize(Archive& ar, const unsigned int version) {
     ar(tickingFurniture);
   }
   ar(covered, name, depth, wildlife, addedWildlife, mainDungeon);
+  if (version >= 2)
+    ar(gas);
+  else if (Archive::is_loading::value) {
+    *gas = GasGrid(getBounds());
+    moveSquareGasToGrid();
+  }
   vector<pair<TribeId, unique_ptr<EffectsTable>>> SERIAL(tmp);
   for (auto t : ENUM_ALL(TribeId::KeyType))
     if (!!furnitureEffects[t])
@@ -107,7 +121,7 @@ void Level::updateTickingFurniture() {
         if (auto t = f->getTickType()) {
           if (auto chance = getChanceTick(*t))
             furniture->getBuilt(layer).getWritable(v)->tickType = FurnitureTickType(std::move(*chance->effect));
-          tickingFurniture.insert(make_pair(make_pair(v, layer), -1));
+          addTickingFurniture(v, layer);
         }
         if ((f->getFire() && f->getFire()->isBurning()) || f->hasBlood())
           burningFurniture.insert(make_pair(v, layer));
@@ -135,8 +149,15 @@ Level::Level(Private, SquareArray s, FurnitureArray f, Model* m, Table<double> s
       bucketMap(squares->getBounds().getSize(), FieldOfView::sightRange),
       swarmMaps(getSwarmMaps(squares->getBounds().getSize())),
       lightAmount(squares->getBounds(), 0), lightCapAmount(squares->getBounds(), 1),
-      levelId(id) {
+      levelId(id), gas(squares->getBounds()) {
   updateTickingFurniture();
+  moveSquareGasToGrid();
+}
+
+void Level::moveSquareGasToGrid() {
+  for (auto v : getBounds())
+    if (squares->getReadonly(v)->hasGas())
+      squares->getWritable(v)->moveGasTo(*gas, v);
 }
 
 PLevel Level::create(SquareArray s, FurnitureArray f, Model* m,
@@ -260,10 +281,45 @@ Model* Level::getModel() const {
   return model;
 }
 
+RandomGen& Level::getRandom() const {
+  return model->getRandom();
+}
+
 Game* Level::getGame() const {
   return model->getGame();
 }
 
+void Level::addTerritoryClaim(Vec2 pos, Collective* col) {
+  auto& claims = territoryClaims[pos];
+  if (!claims.contains(col)) {
+    claims.push_back(col);
+    updateTerritoryOwner(pos);
+  }
+}
+
+void Level::removeTerritoryClaim(Vec2 pos, Collective* col) {
+  if (auto claims = getReferenceMaybe(territoryClaims, pos)) {
+    claims->removeElementMaybe(col);
+    if (claims->empty())
+      territoryClaims.erase(pos);
+    updateTerritoryOwner(pos);
+  }
+}
+
+void Level::updateTerritoryOwner(Vec2 pos) {
+  auto& value = territory[pos];
+  value = nullptr;
+  if (auto claims = getReferenceMaybe(territoryClaims, pos)) {
+    if (claims->size() == 1)
+      value = (*claims)[0];
+    else
+      // The player's collective always wins, otherwise the one added to the model last.
+      for (auto col : model->getCollectives())
+        if (claims->contains(col) && (!value || value->getVillainType() != VillainType::PLAYER))
+          value = col;
+  }
+}
+
 double Level::getLight(Vec2 pos) const {
   return min(1.0, max(0.0, min(covered[pos] ? 1.0 : lightCapAmount[pos], lightAmount[pos] +
       sunlight[pos] * getGame()->getSunlightInfo().getLightAmount())));
@@ -354,7 +410,7 @@ optional<Position> Level::getClosestLanding(vector<Position> landing, Creature*
   CHECK(creature);
   queue<Position> q;
   PositionSet marked;
-  for (Position pos : Random.permutation(landing)) {
+  for (Position pos : getRandom().permutation(landing)) {
     q.push(pos);
     marked.insert(pos);
   }
@@ -365,7 +421,7 @@ optional<Position> Level::getClosestLanding(vector<Position> landing, Creature*
     if (v.canEnter(creature))
       return v;
     else
-      for (Position next : v.neighbors8(Random))
+      for (Position next : v.neighbors8(getRandom()))
         if (!marked.count(next) && next.canEnterEmpty(movement)) {
           q.push(next);
           marked.insert(next);
@@ -394,7 +450,7 @@ void Level::changeLevel(StairKey key, Creature* c) {
   if (otherLevel->landCreature(key, c))
     eraseCreature(c, oldPos);
   else {
-    Position otherPos = Random.choose(otherLevel->landingSquares.at(key));
+    Position otherPos = getRandom().choose(otherLevel->landingSquares.at(key));
     if (Creature* other = otherPos.getCreature()) {
       if (!other->isPlayer() && c->getPosition().canEnterEmpty(other) && otherPos.canEnterEmpty(c) &&
           c->canSwapPositionInMovement(other)) {
@@ -569,11 +625,60 @@ vector<Position> Level::getAllLandingPositions() const {
 }
 
 void Level::addTickingSquare(Vec2 pos) {
-  tickingSquares.insert(pos);
+  tickingSquares.add(pos);
+}
+
+void Level::tickGas() {
+  PROFILE;
+  auto factory = getGame()->getContentFactory();
+  vector<Position> connectivityUpdates;
+  for (auto type : gas->getActiveTypes()) {
+    auto& info = factory->tileGasTypes.at(type);
+    auto updates = gas->tick(type, info.spread, info.decrease,
+        [this](Vec2 v) { return Position(v, this).canSeeThruIgnoringGas(VisionId::NORMAL); });
+    for (auto& update : updates) {
+      Position pos(update.pos, this);
+      if (info.effect && update.before > 0.01 && getRandom().chance(update.before))
+        info.effect->apply(pos);
+      auto cutoff = GasGrid::getFogVisionCutoff();
+      if ((update.before >= cutoff) != (update.after >= cutoff)) {
+        if (info.blocksVision)
+          pos.updateVisibility();
+        connectivityUpdates.push_back(pos);
+      }
+      if (update.before != update.after)
+        pos.setNeedsRenderAndMemoryUpdate(true);
+    }
+  }
+  updateConnectivity(connectivityUpdates);
+}
+
+void Level::tickSquares() {
+  PROFILE;
+  tickingSquares.tick([this](Vec2 pos) {
+    auto square = squares->getWritable(pos);
+    square->tick(Position(pos, this));
+    return square->isTicking();
+  });
 }
 
 void Level::addTickingFurniture(Vec2 pos, FurnitureLayer layer) {
-  tickingFurniture[make_pair(pos, layer)] = 1.0;
+  auto key = make_pair(pos, layer);
+  auto& elem = tickingFurniture[key];
+  elem.chance = -1;
+  scheduleFurnitureTick(key, elem, furnitureTicks.getTime() + 1);
+}
+
+void Level::scheduleFurnitureTick(pair<Vec2, FurnitureLayer> key, FurnitureTick& elem, int turn) {
+  elem.turn = turn;
+  furnitureTicks.insert(key, turn);
+}
+
+static int getTurnsUntilChance(RandomGen& random, double chance) {
+  if (chance >= 1)
+    return 1;
+  // Number of rolls until the first success has a geometric distribution.
+  return 1 + int(min(1000000.0, std::log(1 - random.getDouble()) / std::log(1 - chance)));
 }
 
 void Level::addBurningFurniture(Vec2 pos, FurnitureLayer layer) {
@@ -582,28 +687,46 @@ void Level::addBurningFurniture(Vec2 pos, FurnitureLayer layer) {
 
 void Level::tick() {
   PROFILE_BLOCK("Level::tick");
-  for (Vec2 pos : tickingSquares)
-    squares->getWritable(pos)->tick(Position(pos, this));
+  SIM_TIMER(LEVEL_TICK);
+  tickSquares();
+  tickGas();
   auto& furnitureFactory = getGame()->getContentFactory()->furniture;
-  for (auto& elem : tickingFurniture)
-    if (auto f = furniture->getBuilt(elem.first.second).getWritable(elem.first.first)) {
-      auto& chance = elem.second;
-      if (chance <= 0)
-        if (auto tickType = furnitureFactory.getData(f->getType()).tickType)
-          if (auto chanceTick = getChanceTick(*tickType))
-            chance = chanceTick->value;
-      if (chance <= 0)
-        chance = 1;
-      if (Random.chance(chance))
-        f->tick(Position(elem.first.first, this), elem.first.second);
+  for (auto& key : furnitureTicks.advance()) {
+    auto elem = getReferenceMaybe(tickingFurniture, key);
+    if (!elem || elem->turn != furnitureTicks.getTime())
+      continue;
+    auto f = furniture->getBuilt(key.second).getWritable(key.first);
+    if (!f || !f->isTicking()) {
+      tickingFurniture.erase(key);
+      continue;
+    }
+    if (elem->chance <= 0) {
+      if (auto tickType = furnitureFactory.getData(f->getType()).tickType)
+        if (auto chanceTick = getChanceTick(*tickType))
+          elem->chance = chanceTick->value;
+      if (elem->chance <= 0)
+        elem->chance = 1;
+      // This is the first turn that the furniture may tick.
+      auto turns = getTurnsUntilChance(getRandom(), elem->chance);
+      if (turns > 1) {
+        scheduleFurnitureTick(key, *elem, furnitureTicks.getTime() + turns - 1);
+        continue;
+      }
     }
-  for (auto& elem : burningFurniture)
-    if (auto f = furniture->getBuilt(std::get<1>(elem)).getWritable(std::get<0>(elem)))
-      f->updateFire(Position(std::get<0>(elem), this), std::get<1>(elem));
+    scheduleFurnitureTick(key, *elem, furnitureTicks.getTime() + getTurnsUntilChance(getRandom(), elem->chance));
+    f->tick(Position(key.first, this), key.second);
+  }
+  for (auto& elem : copyOf(burningFurniture)) {
+    if (auto f = furniture->getBuilt(elem.second).getWritable(elem.first))
+      f->updateFire(Position(elem.first, this), elem.second);
+    auto f = furniture->getBuilt(elem.second).getReadonly(elem.first);
+    if (!f || ((!f->getFire() || !f->getFire()->isBurning()) && !f->hasBlood()))
+      burningFurniture.erase(elem);
+  }
   addedWildlife = addedWildlife.filter([this, col = getGame()->getPlayerCollective()](Creature* c) {
     return c->getPosition().getLevel() == this && (!col || !col->getCreatures().contains(c)); });
-  if (Random.roll(50) && addedWildlife.size() < wildlife.count.getStart()) {
-    auto gen = wildlife.generate(Random, &getGame()->getContentFactory()->getCreatures(), TribeId::getWildlife(),
+  if (getRandom().roll(50) && addedWildlife.size() < wildlife.count.getStart()) {
+    auto gen = wildlife.generate(getRandom(), &getGame()->getContentFactory()->getCreatures(), TribeId::getWildlife(),
         MonsterAIFactory::wildlifeNonPredator());
     if (!gen.empty()) {
       auto c = std::move(gen[0]);
@@ -616,23 +739,42 @@ void Level::tick() {
   }
   if (above) {
     PROFILE_BLOCK("Z level tick");
-    for (auto v : getBounds()) {
-      if (!unavailable[v] && above->unavailable[v]) {
-        Position pos(v, this);
-        if (pos.isCovered()) {
-          Position abovePos(v, above);
-          auto col = getGame()->getPlayerCollective();
-          above->unavailable[v] = false;
-          abovePos.addFurniture(getGame()->getContentFactory()->furniture.getFurniture(FurnitureType("ROOF"),
-              TribeId::getMonster()));
-          if (!!col && col->getKnownTiles().isKnown(pos)) {
-            col->addKnownTile(abovePos);
-            getGame()->getPlayerControl()->addToMemory(abovePos);
-          }
-          if (!!col && col->getTerritory().contains(pos))
-            col->claimSquare(abovePos);
-        }
+    if (zLevelFullUpdate) {
+      zLevelFullUpdate = false;
+      zLevelUpdates.clear();
+      for (auto v : getBounds())
+        updateZLevel(v);
+    } else {
+      auto updates = std::move(zLevelUpdates);
+      zLevelUpdates.clear();
+      for (auto v : updates)
+        updateZLevel(v);
+    }
+  }
+  pathService.resolve(this);
+}
+
+void Level::setNeedsZLevelUpdate(Vec2 v) {
+  if (above && !zLevelFullUpdate)
+    zLevelUpdates.insert(v);
+}
+
+void Level::updateZLevel(Vec2 v) {
+  if (!unavailable[v] && above->unavailable[v]) {
+    Position pos(v, this);
+    if (pos.isCovered()) {
+      Position abovePos(v, above);
+      auto col = getGame()->getPlayerCollective();
+      above->unavailable[v] = false;
+      above->setNeedsZLevelUpdate(v);
+      abovePos.addFurniture(getGame()->getContentFactory()->furniture.getFurniture(FurnitureType("ROOF"),
+          TribeId::getMonster()));
+      if (!!col && col->getKnownTiles().isKnown(pos)) {
+        col->addKnownTile(abovePos);
+        getGame()->getPlayerControl()->addToMemory(abovePos);
       }
+      if (!!col && col->getTerritory().contains(pos))
+        col->claimSquare(abovePos);
     }
   }
 }
@@ -647,44 +789,114 @@ const Rectangle& Level::getBounds() const {
 }
 
 Sectors& Level::getSectorsDontCreate(const MovementType& movement) const {
-  return sectors.at(movement);
-}
-
-static Sectors::ExtraConnections getOrCreateExtraConnections(Rectangle bounds,
-    const HashMap<MovementType, Sectors>& sectors) {
-  if (sectors.empty())
-    return Sectors::ExtraConnections(bounds);
-  else
-    return sectors.begin()->second.getExtraConnections();
+  auto ret = sectors.getMaybe(movement);
+  CHECK(!!ret);
+  return *ret;
 }
 
 Sectors& Level::getSectors(const MovementType& movement) const {
   PROFILE;
-  if (auto res = getReferenceMaybe(sectors, movement))
+  if (auto res = sectors.getMaybe(movement))
     return *res;
   else {
     PROFILE_BLOCK("Gen sectors");
-    sectors.insert(make_pair(movement, Sectors(getBounds(), getOrCreateExtraConnections(getBounds(), sectors))));
-    Sectors& newSectors = sectors.at(movement);
+    Table<bool> navigable(getBounds(), false);
     for (Position pos : getAllPositions())
       if (pos.canNavigateCalc(movement))
-        newSectors.add(pos.getCoord());
-    for (auto& portal : model->portals->getMatchedPortals())
-      if (portal.first.getLevel() == this && portal.second.getLevel() == this)
-        newSectors.addExtraConnection(portal.first.getCoord(), portal.second.getCoord());
-    return newSectors;
+        navigable[pos.getCoord()] = true;
+    bool wasEmpty = sectors.getMovementTypes().empty();
+    auto& ret = sectors.add(movement, navigable);
+    // Other Sectors already have the portals in their extra connections.
+    if (wasEmpty)
+      for (auto& portal : model->portals->getMatchedPortals())
+        if (portal.first.getLevel() == this && portal.second.getLevel() == this)
+          ret.addExtraConnection(portal.first.getCoord(), portal.second.getCoord());
+    return ret;
   }
 }
 
+vector<Sectors*> Level::getDistinctSectors() const {
+  return sectors.getDistinct();
+}
+
+void Level::updateSectors(Vec2 coord) {
+  Position pos(coord, this);
+  for (auto& movement : sectors.update(coord, [&] (const MovementType& m) { return pos.canNavigateCalc(m); }))
+    if (auto clusters = getReferenceMaybe(pathClusters, movement))
+      clusters->invalidate(coord);
+}
+
+FieldOfViewCacheStats Level::getFieldOfViewCacheStats() const {
+  FieldOfViewCacheStats ret;
+  for (auto vision : ENUM_ALL(VisionId))
+    ret += getFieldOfView(vision).getCacheStats();
+  return ret;
+}
+
+SharedSectors::Usage Level::getSectorsUsage() const {
+  return sectors.getUsage();
+}
+
+PathClusters& Level::getPathClusters(const MovementType& movement) const {
+  if (auto res = getReferenceMaybe(pathClusters, movement))
+    return *res;
+  return pathClusters.insert(make_pair(movement, PathClusters(getBounds()))).first->second;
+}
+
+NavigationCostGrid& Level::getNavigationCosts(const MovementType& movement) const {
+  if (auto res = getReferenceMaybe(navigationCosts, movement))
+    return *res;
+  return navigationCosts.insert(make_pair(movement, NavigationCostGrid(getBounds()))).first->second;
+}
+
+PathService& Level::getPathService() const {
+  return pathService;
+}
+
+FlowFieldCache& Level::getFlowFields() const {
+  return flowFields;
+}
+
 void Level::prepareForRetirement() {
   for (auto l : ENUM_ALL(FurnitureLayer))
     furniture->getBuilt(l).clearModified();
 }
 
 void Level::updateSunlightMovement() {
-  for (auto movement : getKeys(sectors))
-    if (movement.isSunlightVulnerable())
+  for (auto movement : sectors.getMovementTypes())
+    if (movement.isSunlightVulnerable()) {
       sectors.erase(movement);
+      pathClusters.erase(movement);
+      navigationCosts.erase(movement);
+    }
+}
+
+// Below this many changes, updating Sectors one position at a time is cheaper than committing a batch.
+static const int minConnectivityBatch = 50;
+
+void Level::updateConnectivity(const vector<Position>& positions) {
+  PROFILE;
+  if (positions.size() < minConnectivityBatch) {
+    for (auto& pos : positions)
+      pos.updateConnectivity();
+    return;
+  }
+  // The events are fired after the batch is committed, so that listeners see consistent Sectors.
+  vector<char> couldEnter;
+  for (auto& pos : positions)
+    couldEnter.push_back(getSectorsDontCreate({MovementTrait::WALK}).contains(pos.getCoord()));
+  for (auto elem : getDistinctSectors())
+    elem->beginBatch();
+  for (auto& pos : positions)
+    pos.updateSectors();
+  // Groups split during the batch are copied together with their pending changes.
+  for (auto elem : getDistinctSectors())
+    elem->commitBatch();
+  auto& walkSectors = getSectorsDontCreate({MovementTrait::WALK});
+  for (int i : All(positions))
+    if (!!couldEnter[i] != walkSectors.contains(positions[i].getCoord()))
+      if (auto game = getGame())
+        game->addEvent(EventInfo::MovementChanged{positions[i]});
 }
 
 int Level::getNumGeneratedSquares() const {
@@ -720,11 +932,17 @@ bool Level::needsMemoryUpdate(Vec2 pos) const {
 void Level::setFurniture(Vec2 pos, PFurniture f) {
   auto layer = f->getLayer();
   furniture->eraseConstruction(pos, layer);
-  if (f->isTicking())
+  if (f->isTicking()) {
+    // The tick chance is rolled by the level, as in updateTickingFurniture().
+    if (auto t = f->getTickType())
+      if (auto chance = getChanceTick(*t))
+        f->tickType = FurnitureTickType(std::move(*chance->effect));
     addTickingFurniture(pos, f->getLayer());
+  }
   if ((f->getFire() && f->getFire()->isBurning()) || f->hasBlood())
     addBurningFurniture(pos, f->getLayer());
   furniture->getBuilt(layer).putElem(pos, std::move(f));
+  setNeedsZLevelUpdate(pos);
 }
 
 vector<PhylacteryInfo> Level::getPhylacteries() {
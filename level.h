@@ -20,12 +20,20 @@
 #include "unique_entity.h"
 #include "movement_type.h"
 #include "sectors.h"
+#include "shared_sectors.h"
+#include "path_clusters.h"
+#include "flow_field.h"
+#include "navigation_cost_grid.h"
+#include "path_service.h"
 #include "stair_key.h"
 #include "entity_set.h"
 #include "vision_id.h"
 #include "furniture_layer.h"
 #include "creature_list.h"
 #include "lasting_or_buff.h"
+#include "timing_wheel.h"
+#include "gas_grid.h"
+#include "ticking_squares.h"
 
 class Model;
 class Square;
@@ -44,6 +52,7 @@ class SquareArray;
 class FurnitureArray;
 class Vision;
 class FieldOfView;
+struct FieldOfViewCacheStats;
 class ContentFactory;
 struct PhylacteryInfo;
 
@@ -130,6 +139,7 @@ class Level : public OwnedObject<Level> {
 
   Model* getModel() const;
   Game* getGame() const;
+  RandomGen& getRandom() const;
 
   void addLightSource(Vec2, double radius);
   void removeLightSource(Vec2, double radius);
@@ -139,11 +149,16 @@ class Level : public OwnedObject<Level> {
   double getLevelGenSunlight(Vec2) const;
 
   void updateSunlightMovement();
+  /** Same as calling Position::updateConnectivity() on each position, but many changes are applied
+    to Sectors in a single batch.*/
+  void updateConnectivity(const vector<Position>&);
 
   void prepareForRetirement();
 
   int getNumGeneratedSquares() const;
   int getNumTotalSquares() const;
+  SharedSectors::Usage getSectorsUsage() const;
+  FieldOfViewCacheStats getFieldOfViewCacheStats() const;
 
   void setNeedsMemoryUpdate(Vec2, bool);
   bool needsMemoryUpdate(Vec2) const;
@@ -154,6 +169,10 @@ class Level : public OwnedObject<Level> {
   void setFurniture(Vec2, PFurniture);
 
   Sectors& getSectors(const MovementType&) const;
+  PathClusters& getPathClusters(const MovementType&) const;
+  FlowFieldCache& getFlowFields() const;
+  NavigationCostGrid& getNavigationCosts(const MovementType&) const;
+  PathService& getPathService() const;
   struct EffectSet {
     vector<LastingOrBuff> SERIAL(friendly);
     vector<LastingOrBuff> SERIAL(hostile);
@@ -169,6 +188,9 @@ class Level : public OwnedObject<Level> {
   bool canTranfer = true;
   bool aiFollows = true;
   Table<Collective*> SERIAL(territory);
+  void addTerritoryClaim(Vec2, Collective*);
+  void removeTerritoryClaim(Vec2, Collective*);
+  void updateTerritoryOwner(Vec2);
   int sightRange = 100;
   CreatureList SERIAL(wildlife);
   vector<Creature*> SERIAL(addedWildlife);
@@ -186,9 +208,24 @@ class Level : public OwnedObject<Level> {
   Table<bool> renderUpdates = Table<bool>(getMaxBounds(), true);
   Table<bool> SERIAL(unavailable);
   LandingSquares SERIAL(landingSquares);
-  set<Vec2> SERIAL(tickingSquares);
-  HashMap<pair<Vec2, FurnitureLayer>, double> tickingFurniture;
+  TickingSquares tickingSquares = TickingSquares(getMaxBounds());
+  struct FurnitureTick {
+    // Chance to tick on a given turn, or -1 if it's not yet read from the furniture's type.
+    double chance;
+    int turn;
+  };
+  HashMap<pair<Vec2, FurnitureLayer>, FurnitureTick> tickingFurniture;
+  // Entries not matching the turn stored in tickingFurniture are stale and skipped.
+  TimingWheel<pair<Vec2, FurnitureLayer>> furnitureTicks;
+  void scheduleFurnitureTick(pair<Vec2, FurnitureLayer>, FurnitureTick&, int turn);
   HashSet<pair<Vec2, FurnitureLayer>> burningFurniture;
+  // Squares whose cover changed, checked in tick for a roof to be added on the level above.
+  set<Vec2> zLevelUpdates;
+  bool zLevelFullUpdate = true;
+  void setNeedsZLevelUpdate(Vec2);
+  void updateZLevel(Vec2);
+  // All collectives claiming a given square, used to pick the owner stored in the territory table.
+  HashMap<Vec2, vector<Collective*>> territoryClaims;
   void placeCreature(Creature*, Vec2 pos);
   void unplaceCreature(Creature*, Vec2 pos);
   vector<Creature*> SERIAL(creatures);
@@ -202,8 +239,15 @@ class Level : public OwnedObject<Level> {
   Table<double> SERIAL(lightAmount);
   Table<double> SERIAL(lightCapAmount);
   EnumMap<TribeId::KeyType, unique_ptr<EffectsTable>> SERIAL(furnitureEffects);
-  mutable HashMap<MovementType, Sectors> sectors;
+  mutable SharedSectors sectors;
   Sectors& getSectorsDontCreate(const MovementType&) const;
+  vector<Sectors*> getDistinctSectors() const;
+  void updateSectors(Vec2);
+  // Must be invalidated whenever the Sectors of the same MovementType change.
+  mutable HashMap<MovementType, PathClusters> pathClusters;
+  mutable FlowFieldCache flowFields;
+  mutable HashMap<MovementType, NavigationCostGrid> navigationCosts;
+  mutable PathService pathService;
 
   friend class LevelBuilder;
   struct Private {};
@@ -222,12 +266,16 @@ class Level : public OwnedObject<Level> {
   bool isWithinVision(Vec2 from, Vec2 to, const Vision&) const;
   LevelId SERIAL(levelId) = 0;
   bool SERIAL(noDiagonalPassing) = false;
+  HeapAllocated<GasGrid> SERIAL(gas);
   void updateCreatureLight(Vec2, int diff);
   template<typename Fun>
   void forEachEffect(Vec2, TribeId, Fun);
   void placeSwarmer(Vec2, Creature*);
   void unplaceSwarmer(Vec2, Creature*);
   void updateTickingFurniture();
+  void tickSquares();
+  void tickGas();
+  void moveSquareGasToGrid();
 };
 
-CEREAL_CLASS_VERSION(Level, 1)
\ No newline at end of file
+CEREAL_CLASS_VERSION(Level, 2)
\ No newline at end of file
@@ -576,7 +576,7 @@ class Creatures : public LevelMaker {
         [&](CreatureGroup c){
           vector<PCreature> ret;
           for (int i : Range(numCreatures))
-            ret.push_back(c.random(&builder->getContentFactory()->getCreatures(), *actorFactory));
+            ret.push_back(c.random(builder->getRandom(), &builder->getContentFactory()->getCreatures(), *actorFactory));
           return ret;
         },
         [&](const CreatureList& c){
@@ -621,7 +621,7 @@ class Items : public LevelMaker {
     auto itemList = getItems(builder);
     for (int i : Range(numItem))
       builder->putItems(builder->getRandom().choose(available),
-          itemList.random(builder->getContentFactory(), difficulty));
+          itemList.random(builder->getRandom(), builder->getContentFactory(), difficulty));
   }
 
   ItemList getItems(const LevelBuilder* builder) {
@@ -1011,7 +1011,7 @@ class Buildings : public LevelMaker {
             // if the building is large enough, don't place door near the corner
           Vec2(px + (w >= 4 ? builder->getRandom().get(2, w - 1) : builder->getRandom().get(1, w)),
                py + (buildingRow * h)) :
-          getRandomExit(Random, Rectangle(px, py, px + w + 1, py + h + 1), (w >= 4 && h >= 4) ? 2 : 1);
+          getRandomExit(builder->getRandom(), Rectangle(px, py, px + w + 1, py + h + 1), (w >= 4 && h >= 4) ? 2 : 1);
       if (building.floorInside)
         builder->resetFurniture(doorLoc, *building.floorInside);
       if (building.door)
@@ -1699,7 +1699,7 @@ class ShopMaker : public LevelMaker {
 
   virtual void make(LevelBuilder* builder, Rectangle area) override {
     auto factory = builder->getContentFactory();
-    PCreature shopkeeper = factory->getCreatures().fromId(CreatureId("SHOPKEEPER"), tribe,
+    PCreature shopkeeper = factory->getCreatures().fromId(builder->getRandom(), CreatureId("SHOPKEEPER"), tribe,
         MonsterAIFactory::idle());
     shopkeeper->setController(CreatureFactory::getShopkeeper(builder->toGlobalCoordinates(area).getAllSquares(),
         shopkeeper.get()));
@@ -1721,7 +1721,7 @@ class ShopMaker : public LevelMaker {
     auto itemList = factory->itemFactory.get(shopInfo.items);
     for (int i : Range(builder->getRandom().get(shopInfo.count))) {
       Vec2 v = pos[builder->getRandom().get(pos.size())];
-      builder->putItems(v, itemList.random(factory, difficulty));
+      builder->putItems(v, itemList.random(builder->getRandom(), factory, difficulty));
     }
   }
 
@@ -2037,7 +2037,7 @@ static PMakerQueue village(RandomGen& random, SettlementInfo info, int minRooms,
   return queue;
 }
 
-static PMakerQueue cottage(SettlementInfo info, const BuildingInfo& building, int difficulty) {
+static PMakerQueue cottage(RandomGen& random, SettlementInfo info, const BuildingInfo& building, int difficulty) {
   auto queue = make_unique<MakerQueue>();
   if (building.floorOutside)
     queue->addMaker(make_unique<Empty>(*building.floorOutside));
@@ -2045,7 +2045,7 @@ static PMakerQueue cottage(SettlementInfo info, const BuildingInfo& building, in
   if (info.furniture)
     room->addMaker(make_unique<Furnitures>(Predicate::attrib(SquareAttrib::ROOM), 0.3, *info.furniture, info.tribe));
   if (!info.shopItems.empty())
-    room->addMaker(make_unique<ShopMaker>(Random.choose(info.shopItems), info, difficulty));
+    room->addMaker(make_unique<ShopMaker>(random.choose(info.shopItems), info, difficulty));
   if (building.prettyFloor)
     room->addMaker(make_unique<Empty>(SquareChange(*building.prettyFloor)));
   queue->addMaker(make_unique<Buildings>(1, 2, 5, 7, building, info.tribe, false, std::move(room), false));
@@ -2158,7 +2158,7 @@ PLevelMaker LevelMaker::blackMarket(RandomGen& random, SettlementInfo info, Vec2
         make_unique<BorderGuard>(
             make_unique<ShopMaker>(items, info, difficulty),
             SquareChange(building.wall)),
-        Vec2(Random.get(5, 8), Random.get(5, 8)),
+        Vec2(random.get(5, 8), random.get(5, 8)),
         Predicate::alwaysTrue());
   marketArea->addMaker(make_unique<BorderGuard>(std::move(locations), SquareChange(building.wall)));
   if (info.collective)
@@ -2670,7 +2670,7 @@ namespace {
           [&](LayoutActions::Items items) {
             auto f = builder->getContentFactory();
             auto list = f->itemFactory.get(items);
-            builder->putItems(pos, list.random(f, difficulty));
+            builder->putItems(pos, list.random(builder->getRandom(), f, difficulty));
           },
           [&](LayoutActions::ClearFurniture) { builder->removeAllFurniture(pos); },
           [&](LayoutActions::ClearLayer l) { builder->removeFurniture(pos, l); },
@@ -2691,7 +2691,8 @@ namespace {
             if (s.index < stockpile.size()) {
               if (stockpile[s.index].furniture)
                 builder->putFurniture(pos, *stockpile[s.index].furniture, tribe);
-              builder->putItems(pos, stockpile[s.index].items.random(builder->getContentFactory(), difficulty));
+              builder->putItems(pos, stockpile[s.index].items.random(builder->getRandom(), builder->getContentFactory(),
+                  difficulty));
             }
           },
           [&](LayoutActions::Stairs s) {
@@ -2704,18 +2705,18 @@ namespace {
           },
           [&](LayoutActions::AddGas t) { builder->addPermanentGas(t, pos); },
           [&](LayoutActions::HostileCreature c) {
-            builder->putCreature(pos, builder->getContentFactory()->getCreatures().fromId(c.id, TribeId::getHostile(),
-                MonsterAIFactory::stayInLocation(
+            builder->putCreature(pos, builder->getContentFactory()->getCreatures().fromId(builder->getRandom(), c.id,
+                TribeId::getHostile(), MonsterAIFactory::stayInLocation(
                     builder->toGlobalCoordinates(Rectangle::centered(pos, 4)).getAllSquares())));
           },
           [&](LayoutActions::PeacefulCreature c) {
-            builder->putCreature(pos, builder->getContentFactory()->getCreatures().fromId(c.id, TribeId::getPeaceful(),
-                MonsterAIFactory::stayInLocation(
+            builder->putCreature(pos, builder->getContentFactory()->getCreatures().fromId(builder->getRandom(), c.id,
+                TribeId::getPeaceful(), MonsterAIFactory::stayInLocation(
                     builder->toGlobalCoordinates(Rectangle::centered(pos, 4)).getAllSquares())));
           },
           [&](LayoutActions::AlliedPrisoner info) {
-            auto c = builder->getContentFactory()->getCreatures().fromIdNoInventory(info.id, TribeId::getDarkKeeper(),
-                MonsterAIFactory::stayInLocation(
+            auto c = builder->getContentFactory()->getCreatures().fromIdNoInventory(builder->getRandom(), info.id,
+                TribeId::getDarkKeeper(), MonsterAIFactory::stayInLocation(
                     builder->toGlobalCoordinates(Rectangle::centered(pos, 4)).getAllSquares()));
             c->getStatus().insert(CreatureStatus::PRISONER);
             builder->putCreature(pos, std::move(c));
@@ -2724,8 +2725,8 @@ namespace {
     }
 
     void placeShop(LevelBuilder* builder, const vector<Vec2> area, const SettlementInfo::ShopInfo& shopInfo) {
-      PCreature shopkeeper = builder->getContentFactory()->getCreatures().fromId(CreatureId("SHOPKEEPER"), tribe,
-          MonsterAIFactory::idle());
+      PCreature shopkeeper = builder->getContentFactory()->getCreatures().fromId(builder->getRandom(),
+          CreatureId("SHOPKEEPER"), tribe, MonsterAIFactory::idle());
       shopkeeper->setController(CreatureFactory::getShopkeeper(builder->toGlobalCoordinates(area),
           shopkeeper.get()));
       vector<Vec2> pos;
@@ -2740,7 +2741,7 @@ namespace {
       auto itemList = builder->getContentFactory()->itemFactory.get(shopInfo.items);
       for (int i : Range(builder->getRandom().get(shopInfo.count))) {
         Vec2 v = pos[builder->getRandom().get(pos.size())];
-        builder->putItems(v, itemList.random(builder->getContentFactory(), difficulty));
+        builder->putItems(v, itemList.random(builder->getRandom(), builder->getContentFactory(), difficulty));
       }
     }
 
@@ -2826,7 +2827,7 @@ static PMakerQueue getSettlementMaker(const ContentFactory& contentFactory, Rand
           case BuiltinLayoutId::CASTLE2:
             return castle2(random, settlement, type.buildingInfo, difficulty);
           case BuiltinLayoutId::COTTAGE:
-            return cottage(settlement, type.buildingInfo, difficulty);
+            return cottage(random, settlement, type.buildingInfo, difficulty);
           case BuiltinLayoutId::FORREST_COTTAGE:
             return forrestCottage(settlement, type.buildingInfo, difficulty);
           case BuiltinLayoutId::TOWER:
@@ -3081,7 +3082,7 @@ PLevelMaker LevelMaker::getWaterZLevel(RandomGen& random, FurnitureType waterTyp
   queue->addMaker(make_unique<Empty>(SquareChange(waterType)));
   auto locations = make_unique<RandomLocations>();
   for (int i : Range(5))
-    locations->add(make_unique<UniformBlob>(SquareChange(FurnitureType("FLOOR"))), Vec2(Random.get(5, 10), Random.get(5, 10)),
+    locations->add(make_unique<UniformBlob>(SquareChange(FurnitureType("FLOOR"))), Vec2(random.get(5, 10), random.get(5, 10)),
         RandomLocations::LocationPredicate(Predicate::alwaysTrue()));
   queue->addMaker(std::move(locations));
   queue->addMaker(make_unique<Creatures>(std::move(enemies), TribeId::getMonster(), MonsterAIFactory::monster()));
@@ -3149,8 +3150,8 @@ class SokobanFromFile : public LevelMaker {
           builder->putFurniture(v, FurnitureParams{FurnitureType("IRON_DOOR"), TribeId::getHostile()});
           break;
         case '0':
-          builder->putCreature(v, builder->getContentFactory()->getCreatures().fromId(CreatureId("SOKOBAN_BOULDER"),
-              TribeId::getPeaceful()));
+          builder->putCreature(v, builder->getContentFactory()->getCreatures().fromId(builder->getRandom(),
+              CreatureId("SOKOBAN_BOULDER"), TribeId::getPeaceful()));
           break;
         default: FATAL << "Unknown symbol in sokoban data: " << file[v];
       }
@@ -3299,21 +3300,22 @@ PLevelMaker LevelMaker::upLevel(Position pos, const BiomeInfo& biomeInfo, vector
   queue->addMaker(make_unique<UpLevelMaker>(pos, biomeInfo));
   queue->addMaker(getForrest(biomeInfo));
   auto& factory = *pos.getGame()->getContentFactory();
+  auto& random = pos.getRandom();
   for (auto& settlement : settlements) {
     auto locations = make_unique<RandomLocations>();
     locations->add(make_unique<MakerQueue>(
-            getSettlementMaker(factory, Random, settlement, 0),
+            getSettlementMaker(factory, random, settlement, 0),
             make_unique<Connector>(none, TribeId::getMonster(), 5,
                 Predicate::canEnter({MovementTrait::WALK}),
                 SquareAttrib::CONNECTOR)
         ),
-        getSize(factory.mapLayouts, Random, settlement.type),
+        getSize(factory.mapLayouts, random, settlement.type),
         getSettlementPredicate(settlement.type));
     queue->addMaker(std::move(locations));
   }
   if (resources) {
     auto resLocations = make_unique<RandomLocations>();
-    generateResources(Random, *resources, nullptr, resLocations.get(), {}, 0, TribeId::getMonster());
+    generateResources(random, *resources, nullptr, resLocations.get(), {}, 0, TribeId::getMonster());
     queue->addMaker(std::move(resLocations));
   }
   auto all = make_unique<MakerQueue>();
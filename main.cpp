@@ -56,6 +56,7 @@
 #include "fx_view_manager.h"
 #include "layout_renderer.h"
 #include "unlocks.h"
+#include "path_benchmark.h"
 
 #include "stack_printer.h"
 
@@ -143,6 +144,9 @@ static po::parser getCommandLineFlags() {
   flags["no_crash_reports"].description("Don't intercept game crashes and send crash reports to the developer");
   flags["free_mode"].description("Run in free ascii mode");
   flags["gen_z_levels"].type(po::string).description("Generate and print z-level types for a given keeper");
+  flags["bench_sim"].type(po::string).description("Load a save file and benchmark the simulation without a window");
+  flags["turns"].type(po::i32).description("Number of turns to simulate in the simulation benchmark");
+  flags["bench_path"].type(po::i32).description("Benchmark pathfinding on synthetic levels using the given random seed");
 #ifndef RELEASE
   flags["quick_game"].description("Skip main menu and load the last save file or start a single map game");
   flags["new_game"].description("Skip main menu and start a single map game");
@@ -292,6 +296,10 @@ static int keeperMain(po::parser& commandLineFlags) {
     testAll();
     return 0;
   }
+  if (commandLineFlags["bench_path"].was_set()) {
+    PathBenchmark::run(commandLineFlags["bench_path"].get().i32);
+    return 0;
+  }
   DirectoryPath dataPath([&]() -> string {
     if (commandLineFlags["data_dir"].was_set())
       return commandLineFlags["data_dir"].get().string;
@@ -431,6 +439,17 @@ static int keeperMain(po::parser& commandLineFlags) {
     battleTest(new DummyView(&clock), nullptr);
     return 0;
   }
+  if (commandLineFlags["bench_sim"].was_set()) {
+    USER_CHECK(commandLineFlags["turns"].was_set()) << "Need to specify turns option";
+    DummyView view(&clock);
+    MainLoop loop(&view, &highscores, &fileSharing, paidDataPath, freeDataPath, userPath, modsDir, &options, nullptr,
+        &sokobanInput, nullptr, &allUnlocked, nullptr, saveVersion, modVersion);
+    try {
+      loop.simulationBenchmark(FilePath::fromFullPath(commandLineFlags["bench_sim"].get().string),
+          commandLineFlags["turns"].get().i32);
+    } catch (GameExitException) {}
+    return 0;
+  }
   Renderer renderer(
       &clock,
       steamPtr.getInput(),
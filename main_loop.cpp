@@ -58,6 +58,13 @@
 #include "scripted_ui_data.h"
 #include "version.h"
 #include "collective.h"
+#include "sim_benchmark.h"
+#include "field_of_view.h"
+#include "shortest_path.h"
+#include "path_service.h"
+#include "sectors.h"
+#include "thread_pool.h"
+#include "time_queue.h"
 
 #ifdef USE_STEAMWORKS
 #  include "steam_ugc.h"
@@ -1068,6 +1075,127 @@ void MainLoop::modelGenTest(int numTries, const vector<string>& types, RandomGen
       .measureSiteGen(numTries, types, std::move(biomes));
 }
 
+void MainLoop::simulationBenchmark(const FilePath& savePath, int numTurns) {
+  PGame game = loadGame(savePath, savePath.getFileName());
+  USER_CHECK(!!game) << "Failed to load " << savePath.getPath();
+  Encyclopedia encyclopedia(game->getContentFactory());
+  game->initialize(options, highscores, view, fileSharing, &encyclopedia, unlocks, steamAchievements);
+  ProgressMeter meter(1);
+  game->initializeModels(meter);
+  // A directly controlled creature would wait for input from the DummyView forever.
+  USER_CHECK(!game->isTurnBased()) << "Can't benchmark a save with a directly controlled creature";
+  SimBenchmark::start();
+  auto startTurn = game->getGlobalTime();
+  auto endTurn = startTurn + TimeInterval(numTurns);
+  auto startTime = steady_clock::now();
+  while (game->getGlobalTime() < endTurn)
+    if (game->update(1, none))
+      break;
+  auto totalTime = steady_clock::now() - startTime;
+  auto toSeconds = [] (steady_clock::duration d) {
+    return std::chrono::duration_cast<std::chrono::duration<double>>(d).count();
+  };
+  double seconds = max(0.000001, toSeconds(totalTime));
+  int turns = (game->getGlobalTime() - startTurn).getVisibleInt();
+  auto moves = SimBenchmark::getNumCreatureMoves();
+  std::cout << "Simulated " << turns << " turns in " << seconds << "s\n";
+  std::cout << "Turns/sec: " << turns / seconds << "\n";
+  std::cout << "Creature moves/sec: " << moves / seconds << " (" << moves << " moves)\n";
+  for (auto id : ENUM_ALL(SimTimerId)) {
+    auto total = toSeconds(SimBenchmark::getTotal(id));
+    std::cout << EnumInfo<SimTimerId>::getString(id) << ": " << total << "s ("
+        << 100 * total / seconds << "%)\n";
+  }
+  FieldOfViewCacheStats fovStats;
+  for (auto level : game->getCurrentModel()->getLevels())
+    fovStats += level->getFieldOfViewCacheStats();
+  std::cout << "FieldOfView cache: " << fovStats.hits << " hits, " << fovStats.misses << " misses, "
+      << fovStats.evictions << " evictions, " << fovStats.bytes / 1024 << "KB\n";
+  // Position::getStairsTo needs real levels connected by stairs, so it's measured here and not in --bench_path.
+  auto model = game->getCurrentModel();
+  auto levels = model->getLevels();
+  if (levels.size() > 1) {
+    MovementType movement({MovementTrait::WALK});
+    auto getRandomPosition = [&] {
+      auto level = levels[Random.get(levels.size())];
+      return Position(level->getBounds().random(Random), level);
+    };
+    vector<pair<Position, Position>> queries;
+    for (int i : Range(1000))
+      queries.push_back(make_pair(getRandomPosition(), getRandomPosition()));
+    auto queryStartTime = steady_clock::now();
+    for (auto& query : queries)
+      query.first.getStairsTo(query.second, movement);
+    std::cout << "Position::getStairsTo: "
+        << 1000000000 * toSeconds(steady_clock::now() - queryStartTime) / queries.size() << " ns/query\n";
+  }
+  // The searches that need a level with furniture and creatures are measured on the level with most creatures.
+  auto level = levels[0];
+  for (auto l : levels)
+    if (l->getAllCreatures().size() > level->getAllCreatures().size())
+      level = l;
+  auto measure = [&] (const string& name, int numQueries, function<void(int)> query) {
+    auto queryStartTime = steady_clock::now();
+    for (int i : Range(numQueries))
+      query(i);
+    std::cout << name << ": " << 1000000000 * toSeconds(steady_clock::now() - queryStartTime) / max(1, numQueries)
+        << " ns/query (" << numQueries << " queries)\n";
+  };
+  auto getRandomTarget = [&] (Position from, const MovementType& movement) -> optional<Position> {
+    auto& sectors = level->getSectors(movement);
+    for (int i : Range(100)) {
+      Vec2 to = level->getBounds().random(Random);
+      if (to != from.getCoord() && sectors.same(from.getCoord(), to))
+        return Position(to, level);
+    }
+    return none;
+  };
+  MovementType walk({MovementTrait::WALK});
+  vector<pair<Position, Position>> pathQueries;
+  for (auto c : level->getAllCreatures())
+    if (auto target = getRandomTarget(c->getPosition(), walk))
+      pathQueries.push_back(make_pair(c->getPosition(), *target));
+  vector<LevelShortestPath> paths;
+  paths.reserve(pathQueries.size());
+  measure("LevelShortestPath", pathQueries.size(), [&] (int i) {
+    paths.push_back(LevelShortestPath(pathQueries[i].first, walk, pathQueries[i].second));
+  });
+  // Every path is repaired around its first move, as when a creature finds it blocked.
+  vector<pair<int, Position>> toRepair;
+  for (int i : All(paths)) {
+    auto steps = paths[i].getPath();
+    if (steps.size() > 2 && steps.back() == pathQueries[i].first)
+      toRepair.push_back(make_pair(i, steps[steps.size() - 2]));
+  }
+  int numRepaired = 0;
+  measure("LevelShortestPath::repair", toRepair.size(), [&] (int i) {
+    if (paths[toRepair[i].first].repair(pathQueries[toRepair[i].first].first, walk, toRepair[i].second))
+      ++numRepaired;
+  });
+  std::cout << "Repaired " << numRepaired << " of " << toRepair.size() << " paths\n";
+  // The requests of a whole turn are resolved together, so the time is divided among them.
+  vector<pair<Creature*, Position>> requests;
+  for (auto c : level->getAllCreatures())
+    if (auto target = getRandomTarget(c->getPosition(), c->getMovementType()))
+      requests.push_back(make_pair(c, *target));
+  PathService pathService;
+  measure("PathService on " + toString(ThreadPool::get().getConcurrency()) + " threads", requests.size(), [&] (int i) {
+    pathService.request(requests[i].first, requests[i].first->getPosition(), requests[i].second);
+    if (i == requests.size() - 1)
+      pathService.resolve(level);
+  });
+  TimeQueue timeQueue;
+  for (int i : Range(500))
+    timeQueue.addCreature(CreatureFactory::getHumanForTests(), LocalTime(Random.get(10)));
+  measure("TimeQueue with 500 creatures", 200000, [&] (int) {
+    auto c = timeQueue.getNextCreature(1000000);
+    if (Random.roll(20))
+      timeQueue.makeExtraMove(c);
+    else
+      timeQueue.increaseTime(c, TimeInterval(1 + Random.get(3)));
+  });
+}
+
 static CreatureList readAlly(ifstream& input) {
   string ally;
   input >> ally;
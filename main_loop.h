@@ -49,6 +49,7 @@ class MainLoop {
   int campaignBattleText(int numTries, const FilePath& levelPath, EnemyId keeperId, EnemyId);
   void launchQuickGame(optional<int> maxTurns, bool tryToLoad);
   void genZLevels(const string& keeperType);
+  void simulationBenchmark(const FilePath& savePath, int numTurns);
   ContentFactory createContentFactory(bool vanillaOnly) const;
 
   private:
@@ -37,7 +37,7 @@ static optional<Position> getTileToExplore(Collective* collective, const Creatur
   auto movementType = c->getMovementType();
   optional<Position> caveTile;
   optional<Position> outdoorTile;
-  for (auto& pos : Random.permutation(borderTiles)) {
+  for (auto& pos : collective->getRandom().permutation(borderTiles)) {
     //CHECK(pos.getModel() == collective->getModel());
     if (pos.isCovered()) {
       if ((!caveTile || betterPos(c->getPosition(), *caveTile, pos)) &&
@@ -97,7 +97,7 @@ static Creature* getMinionToAbuse(Collective* collective, const Creature* abuser
 
 static Creature* getCopulationTarget(const Collective* collective, const Creature* succubus) {
   for (auto trait : {MinionTrait::FIGHTER, MinionTrait::LEADER})
-    for (Creature* c : Random.permutation(collective->getCreatures(trait)))
+    for (Creature* c : collective->getRandom().permutation(collective->getCreatures(trait)))
       if (succubus->canCopulateWith(c))
         return c;
   return nullptr;
@@ -279,7 +279,7 @@ PTask MinionActivities::generate(Collective* collective, Creature* c, MinionActi
       auto& pigstyPos = collective->getConstructions().getBuiltPositions(FurnitureType("PIGSTY"));
       if (pigstyPos.count(c->getPosition()) && !myTerritory.empty()) {
         PROFILE_BLOCK("Leave pigsty");
-        return Task::doneWhen(Task::goTo(Random.choose(myTerritory)),
+        return Task::doneWhen(Task::goTo(collective->getRandom().choose(myTerritory)),
             TaskPredicate::outsidePositions(c, pigstyPos));
       }
       auto& leaders = collective->getLeaders();
@@ -360,11 +360,11 @@ optional<TimeInterval> MinionActivities::getDuration(const Creature* c, MinionAc
     case MinionActivity::SLEEP: return none;
     case MinionActivity::EAT:
     case MinionActivity::MINION_ABUSE:
-      return TimeInterval((int) 30 + Random.get(-10, 10));
+      return TimeInterval((int) 30 + c->getRandom().get(-10, 10));
     case MinionActivity::RITUAL:
       return 150_visible;
     default:
-      return TimeInterval(500 + Random.get(Range(0, 250)));
+      return TimeInterval(500 + c->getRandom().get(Range(0, 250)));
   }
 }
 
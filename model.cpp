@@ -60,6 +60,7 @@
 #include "warlord_controller.h"
 #include "territory.h"
 #include "portals.h"
+#include "sim_benchmark.h"
 
 template <class Archive>
 void Model::serialize(Archive& ar, const unsigned int version) {
@@ -67,6 +68,15 @@ void Model::serialize(Archive& ar, const unsigned int version) {
   ar & SUBCLASS(OwnedObject<Model>);
   ar(levels, collectives, timeQueue, deadCreatures, currentTime, game, lastTick, biomeId, position);
   ar(stairNavigation, cemetery, mainLevels, upLevels, eventGenerator, externalEnemies, defaultMusic, portals);
+  if (version >= 1)
+    ar(random);
+  else if (Archive::is_loading::value)
+    initRandom(combineHash(position, lastTick));
+  if (Archive::is_loading::value) {
+    for (auto& col : collectives)
+      for (auto& pos : col->getTerritory().getAll())
+        pos.getLevel()->addTerritoryClaim(pos.getCoord(), col.get());
+  }
 }
 
 SERIALIZATION_CONSTRUCTOR_IMPL(Model)
@@ -131,6 +141,7 @@ bool Model::update(double totalTime) {
     if (!creature->isDead()) {
       INFO << "Turn " << totalTime << " " << creature->getName().bare() << " moving now";
       creature->makeMove();
+      SimBenchmark::addCreatureMove();
     }
     CHECK(creature->getLevel() != nullptr) << "Creature misplaced after moving: " << creature->getName().bare() <<
         ". Any idea why this happened?";
@@ -142,6 +153,7 @@ bool Model::update(double totalTime) {
 }
 
 void Model::tick(LocalTime time) { PROFILE
+  SIM_TIMER(MODEL_TICK);
   for (Creature* c : timeQueue->getAllCreatures()) {
     c->tick();
   }
@@ -149,18 +161,9 @@ void Model::tick(LocalTime time) { PROFILE
     l->tick();
   for (PCollective& col : collectives)
     col->tick();
-  for (auto& l : levels)
-    for (auto v : l->territory.getBounds())
-      l->territory[v] = nullptr;
-  for (auto& col : collectives)
-    for (auto& pos : col->getTerritory().getAll()) {
-      auto& value = pos.getLevel()->territory[pos.getCoord()];
-      if (!value || value->getVillainType() != VillainType::PLAYER)
-        value = col.get();
-    }
   if (externalEnemies)
     externalEnemies->update(getGroundLevel(), time);
-  stairNavigation.clear();
+  stairNavigationValidated.clear();
 }
 
 void Model::addCreature(PCreature c) {
@@ -175,7 +178,7 @@ void Model::addCreature(PCreature c, TimeInterval delay) {
 
 Level* Model::buildLevel(const ContentFactory* factory, LevelBuilder b, PLevelMaker maker, int depth, string name) {
   LevelBuilder builder(std::move(b));
-  levels.push_back(builder.build(factory, this, maker.get(), Random.getLL()));
+  levels.push_back(builder.build(factory, this, maker.get(), builder.getRandom().getLL()));
   levels.back()->depth = depth;
   levels.back()->name = name;
   return levels.back().get();
@@ -202,10 +205,11 @@ Level* Model::buildMainLevel(const ContentFactory* factory, LevelBuilder b, PLev
 Model::Model(Private) {
 }
 
-PModel Model::create(ContentFactory* contentFactory, optional<MusicType> music, BiomeId biomeId) {
+PModel Model::create(ContentFactory* contentFactory, RandomGen& random, optional<MusicType> music, BiomeId biomeId) {
   auto ret = makeOwner<Model>(Private{});
-  ret->cemetery = LevelBuilder(Random, contentFactory, 100, 100, false)
-      .build(contentFactory, ret.get(), LevelMaker::emptyLevel(FurnitureType("GRASS"), false).get(), Random.getLL());
+  ret->initRandom(random.get(INT_MAX));
+  ret->cemetery = LevelBuilder(random, contentFactory, 100, 100, false)
+      .build(contentFactory, ret.get(), LevelMaker::emptyLevel(FurnitureType("GRASS"), false).get(), random.getLL());
   ret->eventGenerator = makeOwner<EventGenerator>();
   ret->defaultMusic = music;
   ret->biomeId = biomeId;
@@ -215,6 +219,14 @@ PModel Model::create(ContentFactory* contentFactory, optional<MusicType> music,
 Model::~Model() {
 }
 
+RandomGen& Model::getRandom() {
+  return random;
+}
+
+void Model::initRandom(int seed) {
+  random.init(seed);
+}
+
 LocalTime Model::getLocalTime() const {
   return LocalTime((int) currentTime);
 }
@@ -285,19 +297,91 @@ Model::StairConnections Model::createStairConnections(const MovementType& moveme
 
 void Model::calculateStairNavigation() {
   stairNavigation.clear();
+  stairDistances.clear();
+  stairNavigationGenerations.clear();
+  stairNavigationValidated.clear();
+}
+
+vector<long long> Model::getSectorsGenerations(const MovementType& movement) const {
+  vector<long long> ret;
+  for (auto level : getLevels())
+    ret.push_back(level->getSectors(movement).getGeneration());
+  return ret;
+}
+
+static const int noStairDistance = INT_MAX / 2;
+
+Model::StairDistances Model::createStairDistances(const MovementType& movement) const {
+  PROFILE;
+  StairDistances ret;
+  for (auto level : getLevels())
+    for (auto key : level->getAllStairKeys())
+      if (!ret.index.count(key) && getLinkedLevel(level, key)) {
+        int cnt = ret.index.size();
+        ret.index[key] = cnt;
+      }
+  const int numKeys = ret.index.size();
+  auto& distances = ret.distances;
+  distances = vector<int>(numKeys * numKeys, noStairDistance);
+  for (int i : Range(numKeys))
+    distances[i * numKeys + i] = 0;
+  for (auto level : getLevels())
+    for (auto key1 : level->getAllStairKeys())
+      if (auto index1 = getValueMaybe(ret.index, key1))
+        for (auto key2 : level->getAllStairKeys())
+          if (auto index2 = getValueMaybe(ret.index, key2))
+            if (key1 != key2) {
+              auto pos1 = level->getLandingSquares(key1)[0];
+              auto pos2 = level->getLandingSquares(key2)[0];
+              if (pos1.isConnectedTo(pos2, movement)) {
+                auto& dist = distances[*index1 * numKeys + *index2];
+                dist = min(dist, *pos1.dist8(pos2) + 1);
+              }
+            }
+  for (int k : Range(numKeys))
+    for (int i : Range(numKeys))
+      if (distances[i * numKeys + k] < noStairDistance)
+        for (int j : Range(numKeys)) {
+          auto& dist = distances[i * numKeys + j];
+          dist = min(dist, distances[i * numKeys + k] + distances[k * numKeys + j]);
+        }
+  return ret;
+}
+
+void Model::updateStairNavigation(const MovementType& movement) {
+  if (!stairNavigationValidated.count(movement)) {
+    auto generations = getSectorsGenerations(movement);
+    auto previous = getReferenceMaybe(stairNavigationGenerations, movement);
+    if (!previous || *previous != generations || !stairNavigation.count(movement) || !stairDistances.count(movement)) {
+      stairNavigation[movement] = createStairConnections(movement);
+      stairDistances[movement] = createStairDistances(movement);
+      stairNavigationGenerations[movement] = std::move(generations);
+    }
+    stairNavigationValidated.insert(movement);
+  }
 }
 
 bool Model::areConnected(StairKey key1, StairKey key2, const MovementType& movement) {
   PROFILE;
-  auto& connections = [&]() -> StairConnections& {
-    if (auto ret = getReferenceMaybe(stairNavigation, movement))
-      return *ret;
-    auto ret = stairNavigation.insert(make_pair(movement, createStairConnections(movement)));
-    return ret.first->second;
-  }();
+  updateStairNavigation(movement);
+  auto& connections = stairNavigation.at(movement);
   return connections.at(key1) == connections.at(key2);
 }
 
+optional<int> Model::getStairDistance(StairKey key1, StairKey key2, const MovementType& movement) {
+  PROFILE;
+  updateStairNavigation(movement);
+  auto& distances = stairDistances.at(movement);
+  auto index1 = getValueMaybe(distances.index, key1);
+  auto index2 = getValueMaybe(distances.index, key2);
+  if (!index1 || !index2)
+    return none;
+  auto ret = distances.distances[*index1 * distances.index.size() + *index2];
+  if (ret >= noStairDistance)
+    return none;
+  return ret;
+}
+
 vector<Level*> Model::getLevels() const {
   return getWeakPointers(levels);
 }
@@ -44,7 +44,7 @@ class Portals;
   */
 class Model : public OwnedObject<Model> {
   public:
-  static PModel create(ContentFactory*, optional<MusicType>, BiomeId);
+  static PModel create(ContentFactory*, RandomGen&, optional<MusicType>, BiomeId);
 
   /** Makes an update to the game. This method is repeatedly called to make the game run.
     Returns the total logical time elapsed.*/
@@ -53,6 +53,8 @@ class Model : public OwnedObject<Model> {
   /** Returns the level that the stairs lead to. */
   Level* getLinkedLevel(Level* from, StairKey) const;
   bool areConnected(StairKey, StairKey, const MovementType&);
+  /** Returns the shortest walking distance between two stairs, counting one extra step for each stair used.*/
+  optional<int> getStairDistance(StairKey, StairKey, const MovementType&);
 
   void addCreature(PCreature);
   void addCreature(PCreature, TimeInterval delay);
@@ -64,6 +66,8 @@ class Model : public OwnedObject<Model> {
 
   LocalTime getLocalTime() const;
   double getLocalTimeDouble() const;
+  /** Random number stream used by everything that happens in this model. */
+  RandomGen& getRandom();
   TimeQueue& getTimeQueue();
   int getMoveCounter() const;
   void increaseMoveCounter();
@@ -140,6 +144,19 @@ class Model : public OwnedObject<Model> {
   using StairConnections = HashMap<StairKey, int>;
   StairConnections createStairConnections(const MovementType&) const;
   HashMap<MovementType, StairConnections> SERIAL(stairNavigation);
+  struct StairDistances {
+    HashMap<StairKey, int> index;
+    // Row-major matrix of distances between all pairs of keys in index.
+    vector<int> distances;
+  };
+  StairDistances createStairDistances(const MovementType&) const;
+  HashMap<MovementType, StairDistances> stairDistances;
+  void updateStairNavigation(const MovementType&);
+  // Sectors generations of all levels that each entry in stairNavigation and stairDistances was computed from.
+  HashMap<MovementType, vector<long long>> stairNavigationGenerations;
+  // Entries checked against the current sectors generations since the last tick.
+  HashSet<MovementType> stairNavigationValidated;
+  vector<long long> getSectorsGenerations(const MovementType&) const;
   template <typename>
   friend class EventListener;
   OwnerPointer<EventGenerator> SERIAL(eventGenerator);
@@ -148,5 +165,8 @@ class Model : public OwnedObject<Model> {
   int moveCounter = 0;
   optional<MusicType> SERIAL(defaultMusic);
   BiomeId SERIAL(biomeId);
+  RandomGen random;
+  void initRandom(int seed);
 };
 
+CEREAL_CLASS_VERSION(Model, 1)
@@ -189,9 +189,9 @@ void ModelBuilder::measureSiteGen(int numTries, vector<string> types, vector<Bio
               [&] {
                 auto model = tryCampaignBaseModel(alignment, none, BiomeId("GRASSLAND"), none);
                 auto size = model->getGroundLevel()->getBounds().getSize();
-                auto maker = getLevelMaker(Random, contentFactory, {"basic"}, i, TribeId::getDarkKeeper(), size,
+                auto maker = getLevelMaker(random, contentFactory, {"basic"}, i, TribeId::getDarkKeeper(), size,
                     EnemyAggressionLevel(0));
-                LevelBuilder(Random, contentFactory, size.x, size.y, true)
+                LevelBuilder(random, contentFactory, size.x, size.y, true)
                     .build(contentFactory, model.get(), maker.maker.get(), 123);
               }); });
     }
@@ -201,7 +201,7 @@ void ModelBuilder::measureSiteGen(int numTries, vector<string> types, vector<Bio
       auto id = EnemyId(type.data());
       for (auto alignment : ENUM_ALL(TribeAlignment))
         tasks.push_back([=] { measureModelGen(type, numTries, [&] {
-            tryCampaignSiteModel(id, VillainType::LESSER, alignment, Random.choose(biomes), 0); }); });
+            tryCampaignSiteModel(id, VillainType::LESSER, alignment, random.choose(biomes), 0); }); });
     }
   }
   for (auto& t : tasks)
@@ -314,7 +314,7 @@ PModel ModelBuilder::tryModel(int width, int difficulty, vector<EnemyInfo> enemy
     optional<KeeperBaseInfo> keeperBase, BiomeId biomeId,
     optional<ExternalEnemies> externalEnemies) {
   auto& biomeInfo = contentFactory->biomeInfo.at(biomeId);
-  auto model = Model::create(contentFactory, biomeInfo.overrideMusic, biomeId);
+  auto model = Model::create(contentFactory, random, biomeInfo.overrideMusic, biomeId);
   vector<SettlementInfo> topLevelSettlements;
   vector<EnemyInfo> extraEnemies;
   for (auto& elem : enemyInfo) {
@@ -337,12 +337,12 @@ PModel ModelBuilder::tryModel(int width, int difficulty, vector<EnemyInfo> enemy
 }
 
 PModel ModelBuilder::battleModel(const FilePath& levelPath, vector<PCreature> allies, vector<CreatureList> enemies) {
-  auto m = Model::create(contentFactory, none, BiomeId("GRASSLAND"));
+  auto m = Model::create(contentFactory, random, none, BiomeId("GRASSLAND"));
   ifstream stream(levelPath.getPath());
   Table<char> level = *SokobanInput::readTable(stream);
   Level* l = m->buildMainLevel(
       contentFactory,
-      LevelBuilder(meter, Random, contentFactory, level.getBounds().width(), level.getBounds().height(), true, 1.0),
+      LevelBuilder(meter, random, contentFactory, level.getBounds().width(), level.getBounds().height(), true, 1.0),
       LevelMaker::battleLevel(level, std::move(allies), enemies));
   return m;
 }
@@ -56,6 +56,7 @@
 #include "automaton_part.h"
 #include "ai_type.h"
 #include "construction_map.h"
+#include "sim_benchmark.h"
 
 class Behaviour {
   public:
@@ -249,10 +250,10 @@ class MoveRandomly : public Behaviour {
       updateMem(creature->getPosition());
     optional<Position> target;
     double val = 0.0001;
-    if (Random.roll(2))
+    if (creature->getRandom().roll(2))
       return {val, creature->wait()};
-    for (Position pos : creature->getPosition().neighbors8(Random)) {
-      if (Random.roll(10))
+    for (Position pos : creature->getPosition().neighbors8(creature->getRandom())) {
+      if (creature->getRandom().roll(10))
         if (auto other = pos.getCreature())
           if (auto petAction = creature->pet(other))
             return petAction;
@@ -262,7 +263,7 @@ class MoveRandomly : public Behaviour {
       }
     }
     if (!target)
-      for (Position pos: creature->getPosition().neighbors8(Random))
+      for (Position pos: creature->getPosition().neighbors8(creature->getRandom()))
         if (creature->move(pos)) {
           target = pos;
           break;
@@ -299,7 +300,7 @@ class BirdFlyAway : public Behaviour {
 
   virtual MoveInfo getMove() override {
     const Creature* enemy = creature->getClosestEnemy();
-    if (Random.roll(15) || ( enemy && enemy->getPosition().dist8(creature->getPosition()).value_or(100000) < maxDist))
+    if (creature->getRandom().roll(15) || ( enemy && enemy->getPosition().dist8(creature->getPosition()).value_or(100000) < maxDist))
       if (auto action = creature->flyAway())
         return {1.0, action};
     return NoMove;
@@ -471,7 +472,7 @@ class Fighter : public Behaviour {
   MoveInfo considerBreakingChokePoint(Creature* other) {
   PROFILE;
     HashSet<Position> myNeighbors;
-    for (auto pos : creature->getPosition().neighbors8(Random))
+    for (auto pos : creature->getPosition().neighbors8(creature->getRandom()))
       myNeighbors.insert(pos);
     MoveInfo destroyMove = NoMove;
     bool isFriendBetween = false;
@@ -525,7 +526,7 @@ class Fighter : public Behaviour {
             return false;
       return true;
     };
-    for (auto pos : target.neighbors8(Random))
+    for (auto pos : target.neighbors8(creature->getRandom()))
       if (isSafe(pos))
         return pos;
     return none;
@@ -742,11 +743,11 @@ class GuardArea : public Behaviour {
     PROFILE;
     if (myLevel != creature->getLevel() || !area.count(creature->getPosition().getCoord())) {
       if (myLevel == creature->getLevel())
-        for (auto v : creature->getPosition().neighbors8(Random))
+        for (auto v : creature->getPosition().neighbors8(creature->getRandom()))
           if (area.count(v.getCoord()))
             if (auto action = creature->move(v))
               return action;
-      return creature->moveTowards(Position(Random.choose(area), myLevel));
+      return creature->moveTowards(Position(creature->getRandom().choose(area), myLevel));
     }
     return CreatureAction();
   }
@@ -917,7 +918,7 @@ class ByCollective : public Behaviour {
   PTask getEquipmentTask() {
     if (!collective->usesEquipment(creature))
       return nullptr;
-    if (!collective->hasTrait(creature, MinionTrait::NO_AUTO_EQUIPMENT) && Random.roll(40))
+    if (!collective->hasTrait(creature, MinionTrait::NO_AUTO_EQUIPMENT) && creature->getRandom().roll(40))
       collective->autoAssignEquipment(creature);
     vector<PTask> tasks;
     auto& minionEquipment = collective->getMinionEquipment();
@@ -954,7 +955,7 @@ class ByCollective : public Behaviour {
         }
       }
     if (!goodTasks.empty()) {
-      auto ret = Random.choose(std::move(goodTasks));
+      auto ret = creature->getRandom().choose(std::move(goodTasks));
       collective->setMinionActivity(creature, ret.first);
       return std::move(ret);
     }
@@ -973,7 +974,7 @@ class ByCollective : public Behaviour {
       if (generatedCache && generatedCache->first == activity && !!generatedCache->second)
         return std::move(generatedCache->second);
       /*if ((!collective->hasTrait(creature, MinionTrait::WORKER) || activity == MinionActivity::IDLE)
-          && !Random.roll(30)
+          && !creature->getRandom().roll(30)
           && lastTimeGeneratedActivity[activity]
           && *lastTimeGeneratedActivity[activity] >= collective->getLocalTime() - 10_visible)
         return nullptr;*/
@@ -1038,7 +1039,7 @@ class ByCollective : public Behaviour {
     PROFILE;
     // don't switch the activity every turn as this may cancel and existing sleep task
     // at the moment the creature is about to go to sleep causing it to wonder around the bedroom
-    if (Random.roll(5) && (collective->getConfig().allowHealingTaskOutsideTerritory() ||
+    if (creature->getRandom().roll(5) && (collective->getConfig().allowHealingTaskOutsideTerritory() ||
         collective->getTerritory().contains(creature->getPosition()))) {
       const static EnumSet<MinionActivity> healingActivities {MinionActivity::SLEEP};
       auto currentActivity = collective->getCurrentActivity(creature).activity;
@@ -1122,7 +1123,7 @@ class ChooseRandom : public Behaviour {
       : Behaviour(c), behaviours(std::move(beh)), weights(w) {}
 
   virtual MoveInfo getMove() override {
-    return behaviours[Random.get(weights)]->getMove();
+    return behaviours[creature->getRandom().get(weights)]->getMove();
   }
 
   SERIALIZATION_CONSTRUCTOR(ChooseRandom);
@@ -1155,11 +1156,11 @@ class AvoidFire : public Behaviour {
   virtual MoveInfo getMove() override {
     auto myPosition = creature->getPosition();
     if (myPosition.isBurning() && !creature->isAffected(BuffId("FIRE_IMMUNITY"))) {
-      for (Position pos : myPosition.neighbors8(Random))
+      for (Position pos : myPosition.neighbors8(creature->getRandom()))
         if (!pos.isBurning())
           if (auto action = creature->move(pos))
             return action;
-      for (Position pos : myPosition.neighbors8(Random))
+      for (Position pos : myPosition.neighbors8(creature->getRandom()))
         if (auto action = creature->forceMove(pos))
           return action;
     }
@@ -1208,6 +1209,7 @@ MonsterAI::MonsterAI(Creature* c, const vector<Behaviour*>& beh, const vector<in
 
 void MonsterAI::makeMove() {
   PROFILE;
+  SIM_TIMER(MONSTER_AI_MOVE);
   vector<MoveInfo> moves;
   for (int i : All(behaviours)) {
     MoveInfo move = behaviours[i]->getMove();
@@ -22,6 +22,7 @@
 
 SERIALIZE_DEF(NameGenerator, names)
 
+// Names are generated while content is loaded on the main thread, so they use the global generator.
 string getSyllable() {
   string vowels = "aeyuio";
   string consonants = "qwrtplkjhgfdszxcvbnm";
@@ -81,7 +82,11 @@ void NameGenerator::merge(NameGenerator g) {
       names.insert(std::move(elem));
 }
 
+// Names can be taken from several model update threads at once.
+static std::mutex namesMutex;
+
 string NameGenerator::getNext(NameGeneratorId id) {
+  std::unique_lock<std::mutex> lock(namesMutex);
   CHECK(!names[id].empty());
   string ret = names[id].front();
   names[id].pop_front();
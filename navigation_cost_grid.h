@@ -0,0 +1,49 @@
+/* Copyright (C) 2013-2014 Michal Brzozowski (rusolis@poczta.fm)
+
+   This file is part of KeeperRL.
+
+   KeeperRL is free software; you can redistribute it and/or modify it under the terms of the
+   GNU General Public License as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   KeeperRL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+   even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with this program.
+   If not, see http://www.gnu.org/licenses/ . */
+
+#pragma once
+
+#include "util.h"
+
+// Navigation costs of a level for one MovementType, calculated lazily for each square and forgotten when something
+// that affects them changes.
+class NavigationCostGrid {
+  public:
+  NavigationCostGrid(Rectangle bounds) : costs(bounds, -1) {}
+
+  template <typename Fun>
+  double get(Vec2 v, Fun calculate) {
+    auto& cost = costs[v];
+    if (cost < 0)
+      cost = calculate();
+    return cost;
+  }
+
+  void invalidate(Vec2 v) {
+    if (costs[v] >= 0) {
+      costs[v] = -1;
+      ++generation;
+    }
+  }
+
+  // Changes every time a calculated cost is forgotten.
+  int getGeneration() const {
+    return generation;
+  }
+
+  private:
+  Table<float> costs;
+  int generation = 0;
+};
@@ -59,6 +59,7 @@ const EnumMap<OptionId, Options::Value> defaults {
   {OptionId::KEEPER_WARNING, 1},
   {OptionId::KEEPER_WARNING_TIMEOUT, 200},
   {OptionId::SINGLE_THREAD, 0},
+  {OptionId::PARALLEL_MODEL_UPDATE, 0},
   {OptionId::UNLOCK_ALL, 0},
   {OptionId::EXP_INCREASE, 1},
   {OptionId::DPI_AWARE, 0}
@@ -99,6 +100,7 @@ const map<OptionId, string> names {
   {OptionId::KEEPER_WARNING, "Keeper danger warning"},
   {OptionId::KEEPER_WARNING_TIMEOUT, "Keeper danger timeout"},
   {OptionId::SINGLE_THREAD, "Use a single thread for loading operations"},
+  {OptionId::PARALLEL_MODEL_UPDATE, "Update other sites on several threads"},
   {OptionId::UNLOCK_ALL, "Unlock all hidden gameplay features"},
   {OptionId::EXP_INCREASE, "Enemy difficulty curve"},
   {OptionId::DPI_AWARE, "Override Windows DPI scaling"},
@@ -123,6 +125,7 @@ const map<OptionId, string> hints {
   {OptionId::KEEPER_WARNING_TIMEOUT, "Number of turns before a new \"Keeper in danger\" warning is shown"},
   {OptionId::SINGLE_THREAD, "Please try this option if you're experiencing slow saving, loading, or map generation. "
         "Note: this will make the game unresponsive during the operation."},
+  {OptionId::PARALLEL_MODEL_UPDATE, "Experimental: catch up the sites you are not on using all CPU cores when a game is loaded."},
   {OptionId::UNLOCK_ALL, "Unlocks all player characters and gameplay features that are normally unlocked by finding secrets in the game."},
   {OptionId::EXP_INCREASE, "Defines the increase in experience for every lesser and main villain as you travel further away from your home site."},
   {OptionId::DPI_AWARE, "If you find the game blurry, this setting might help. Requires restarting the game. "},
@@ -148,6 +151,7 @@ const map<OptionSet, vector<OptionId>> optionSets {
       OptionId::KEEPER_WARNING,
       OptionId::KEEPER_WARNING_TIMEOUT,
       OptionId::SINGLE_THREAD,
+      OptionId::PARALLEL_MODEL_UPDATE,
       OptionId::UNLOCK_ALL,
 #ifndef RELEASE
       OptionId::KEEP_SAVEFILES,
@@ -327,6 +331,7 @@ static bool isBoolean(OptionId id) {
     case OptionId::DISABLE_CURSOR:
     case OptionId::START_WITH_NIGHT:
     case OptionId::SINGLE_THREAD:
+    case OptionId::PARALLEL_MODEL_UPDATE:
     case OptionId::UNLOCK_ALL:
     case OptionId::DPI_AWARE:
       return true;
@@ -358,6 +363,7 @@ string Options::getValueString(OptionId id) {
     case OptionId::DISABLE_CURSOR:
     case OptionId::START_WITH_NIGHT:
     case OptionId::SINGLE_THREAD:
+    case OptionId::PARALLEL_MODEL_UPDATE:
     case OptionId::UNLOCK_ALL:
       return getYesNo(value);
     case OptionId::SETTLEMENT_NAME:
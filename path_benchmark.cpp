@@ -0,0 +1,320 @@
+/* Copyright (C) 2013-2014 Michal Brzozowski (rusolis@poczta.fm)
+
+   This file is part of KeeperRL.
+
+   KeeperRL is free software; you can redistribute it and/or modify it under the terms of the
+   GNU General Public License as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   KeeperRL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+   even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with this program.
+   If not, see http://www.gnu.org/licenses/ . */
+
+#include "stdafx.h"
+#include "path_benchmark.h"
+#include "sectors.h"
+#include "shortest_path.h"
+#include "level.h"
+#include "field_of_view.h"
+#include "path_clusters.h"
+#include "flow_field.h"
+
+namespace {
+
+struct BenchmarkMap {
+  string name;
+  Table<bool> floor;
+  Table<float> costs;
+  vector<pair<Vec2, Vec2>> portals;
+};
+
+struct BenchmarkResult {
+  double nanosPerQuery;
+  double nodesPerQuery;
+};
+
+// Open caves made by smoothing random noise with a cellular automaton.
+BenchmarkMap makeCaves(Rectangle bounds, RandomGen& random) {
+  Table<bool> floor(bounds, false);
+  for (Vec2 v : bounds)
+    floor[v] = random.chance(0.55);
+  for (int i : Range(5)) {
+    Table<bool> next(bounds, false);
+    for (Vec2 v : bounds) {
+      int walls = 0;
+      for (Vec2 w : v.neighbors8())
+        if (!w.inRectangle(bounds) || !floor[w])
+          ++walls;
+      next[v] = walls < 5;
+    }
+    floor = std::move(next);
+  }
+  return BenchmarkMap{"caves", std::move(floor), Table<float>(bounds, 1), {}};
+}
+
+// A perfect maze with one square wide corridors, so paths are long and winding.
+BenchmarkMap makeMaze(Rectangle bounds, RandomGen& random) {
+  Table<bool> floor(bounds, false);
+  Rectangle cells(1, 1, bounds.right() - 1, bounds.bottom() - 1);
+  vector<Vec2> stack {Vec2(1, 1)};
+  floor[stack.back()] = true;
+  while (!stack.empty()) {
+    Vec2 cur = stack.back();
+    vector<Vec2> next;
+    for (Vec2 dir : Vec2::directions4())
+      if ((cur + dir * 2).inRectangle(cells) && !floor[cur + dir * 2])
+        next.push_back(dir);
+    if (next.empty()) {
+      stack.pop_back();
+      continue;
+    }
+    Vec2 dir = random.choose(next);
+    floor[cur + dir] = true;
+    floor[cur + dir * 2] = true;
+    stack.push_back(cur + dir * 2);
+  }
+  return BenchmarkMap{"maze", std::move(floor), Table<float>(bounds, 1), {}};
+}
+
+// Open ground with a grid of walled rooms, each entered through doors that are more expensive to cross.
+BenchmarkMap makeFortress(Rectangle bounds, RandomGen& random) {
+  Table<bool> floor(bounds, true);
+  Table<float> costs(bounds, 1);
+  const int blockSize = 24;
+  for (int x = 2; x + blockSize < bounds.right(); x += blockSize)
+    for (int y = 2; y + blockSize < bounds.bottom(); y += blockSize) {
+      Rectangle room(x + 2, y + 2, x + 2 + random.get(10, blockSize - 3), y + 2 + random.get(10, blockSize - 3));
+      vector<Vec2> walls;
+      for (Vec2 v : room)
+        if (v.x == room.left() || v.y == room.top() || v.x == room.right() - 1 || v.y == room.bottom() - 1) {
+          floor[v] = false;
+          if (v != room.topLeft() && v != room.bottomRight() - Vec2(1, 1) &&
+              v != Vec2(room.left(), room.bottom() - 1) && v != Vec2(room.right() - 1, room.top()))
+            walls.push_back(v);
+        }
+      for (int i : Range(random.get(1, 3))) {
+        Vec2 door = random.choose(walls);
+        floor[door] = true;
+        costs[door] = 5;
+      }
+    }
+  return BenchmarkMap{"fortress", std::move(floor), std::move(costs), {}};
+}
+
+vector<Vec2> getFloor(const BenchmarkMap& map) {
+  vector<Vec2> ret;
+  for (Vec2 v : map.floor.getBounds())
+    if (map.floor[v])
+      ret.push_back(v);
+  return ret;
+}
+
+void addPortals(BenchmarkMap& map, int num, RandomGen& random) {
+  auto floor = getFloor(map);
+  HashSet<Vec2> used;
+  while (map.portals.size() < num) {
+    Vec2 v = floor[random.get(floor.size())];
+    Vec2 w = floor[random.get(floor.size())];
+    if (v != w && !used.count(v) && !used.count(w)) {
+      used.insert(v);
+      used.insert(w);
+      map.portals.push_back(make_pair(v, w));
+    }
+  }
+}
+
+Sectors makeSectors(const BenchmarkMap& map, bool batch) {
+  Rectangle bounds = map.floor.getBounds();
+  Sectors ret(bounds, Sectors::ExtraConnections(bounds));
+  if (batch)
+    ret.beginBatch();
+  for (Vec2 v : bounds)
+    if (map.floor[v])
+      ret.add(v);
+  ret.commitBatch();
+  for (auto& portal : map.portals)
+    ret.addExtraConnection(portal.first, portal.second);
+  return ret;
+}
+
+template <typename Fun>
+BenchmarkResult measure(int numQueries, Fun query) {
+  long long nodes = 0;
+  auto startTime = steady_clock::now();
+  for (int i : Range(numQueries))
+    nodes += query(i);
+  auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now() - startTime).count();
+  return BenchmarkResult{double(nanos) / numQueries, double(nodes) / numQueries};
+}
+
+void printResult(const string& mapName, const string& benchmark, BenchmarkResult result) {
+  std::cout << mapName << " " << benchmark << ": " << result.nanosPerQuery << " ns/query, "
+      << result.nodesPerQuery << " nodes/query\n";
+}
+
+// A roughly round area of floor squares around the center, like a gas cloud.
+vector<Vec2> getArea(const BenchmarkMap& map, Vec2 center, int size) {
+  vector<Vec2> ret;
+  for (int radius = 0; ret.size() < size; ++radius) {
+    ret.clear();
+    for (Vec2 v : Rectangle::centered(center, radius).intersection(map.floor.getBounds()))
+      if (map.floor[v] && v.distD(center) <= radius)
+        ret.push_back(v);
+  }
+  return ret;
+}
+
+void runOnMap(BenchmarkMap map, RandomGen& random) {
+  Rectangle bounds = map.floor.getBounds();
+  auto floor = getFloor(map);
+  printResult(map.name, "Sectors build", measure(3, [&](int) {
+    makeSectors(map, false);
+    return floor.size();
+  }));
+  printResult(map.name, "Sectors batched build", measure(3, [&](int) {
+    makeSectors(map, true);
+    return floor.size();
+  }));
+  auto sectors = makeSectors(map, true);
+  // Areas of floor are removed and added back, as when gas spreads and clears.
+  vector<vector<Vec2>> areas;
+  for (int i : Range(20))
+    areas.push_back(getArea(map, floor[random.get(floor.size())], 256));
+  auto updateArea = [&](const vector<Vec2>& area, bool batch) {
+    if (batch)
+      sectors.beginBatch();
+    for (Vec2 v : area)
+      sectors.remove(v);
+    sectors.commitBatch();
+    if (batch)
+      sectors.beginBatch();
+    for (Vec2 v : area)
+      sectors.add(v);
+    sectors.commitBatch();
+    return 2 * area.size();
+  };
+  printResult(map.name, "Sectors area of 256, single updates", measure(areas.size(), [&](int i) {
+    return updateArea(areas[i], false);
+  }));
+  printResult(map.name, "Sectors area of 256, batched", measure(areas.size(), [&](int i) {
+    return updateArea(areas[i], true);
+  }));
+  // Same pairs of connected squares for all path searches.
+  vector<pair<Vec2, Vec2>> queries;
+  while (queries.size() < 100) {
+    Vec2 from = floor[random.get(floor.size())];
+    Vec2 to = floor[random.get(floor.size())];
+    if (from != to && sectors.same(from, to))
+      queries.push_back(make_pair(from, to));
+  }
+  long long entryCalls = 0;
+  auto lengthFun = [](Vec2 from) { return [from](Vec2 v)->double { return from.dist8(v); }; };
+  auto plainEntry = [&](Vec2 v) {
+    ++entryCalls;
+    return map.floor[v] ? 1.0 : ShortestPath::infinity;
+  };
+  printResult(map.name, "ShortestPath", measure(queries.size(), [&](int i) {
+    entryCalls = 0;
+    ShortestPath(bounds, plainEntry, lengthFun(queries[i].first), Vec2::directions8(), queries[i].second,
+        queries[i].first);
+    return entryCalls;
+  }));
+  // Costs and portals as seen by LevelShortestPath, with squares outside the sector rejected early.
+  auto levelEntry = [&](Vec2 v) {
+    ++entryCalls;
+    return sectors.contains(v) ? map.costs[v] : ShortestPath::infinity;
+  };
+  auto levelDirections = [&](Vec2 v) {
+    vector<Vec2> ret = Vec2::directions8();
+    if (auto portal = sectors.getExtraConnection(v))
+      ret.push_back(*portal - v);
+    return ret;
+  };
+  vector<pair<Vec2, Vec2>> longQueries;
+  for (auto& query : queries)
+    if (query.first.dist8(query.second) >= 3 * PathClusters::clusterSize)
+      longQueries.push_back(query);
+  PathClusters clusters(bounds);
+  auto hierarchicalPath = [&](int i) {
+    entryCalls = 0;
+    ShortestPath::makeHierarchical(clusters, sectors, bounds, levelEntry, levelDirections, longQueries[i].second,
+        longQueries[i].first);
+    return entryCalls;
+  };
+  printResult(map.name, "Hierarchical path, building clusters", measure(longQueries.size(), hierarchicalPath));
+  printResult(map.name, "Hierarchical path", measure(longQueries.size(), hierarchicalPath));
+  // Many creatures heading to a few squares, like minions going to the same workshop or enemies to the leader.
+  vector<Vec2> targets;
+  for (int i : Range(5))
+    targets.push_back(queries[i].second);
+  vector<pair<Vec2, Vec2>> sharedQueries;
+  while (sharedQueries.size() < 200) {
+    Vec2 from = floor[random.get(floor.size())];
+    Vec2 to = targets[sharedQueries.size() % targets.size()];
+    if (from != to && sectors.same(from, to))
+      sharedQueries.push_back(make_pair(from, to));
+  }
+  printResult(map.name, "ShortestPath, 5 targets", measure(sharedQueries.size(), [&](int i) {
+    entryCalls = 0;
+    ShortestPath(bounds, levelEntry, lengthFun(sharedQueries[i].first), levelDirections, sharedQueries[i].second,
+        sharedQueries[i].first);
+    return entryCalls;
+  }));
+  printResult(map.name, "FlowField build", measure(targets.size(), [&](int i) {
+    entryCalls = 0;
+    FlowField(bounds, targets[i], levelEntry, levelDirections);
+    return entryCalls;
+  }));
+  FlowFieldCache flowFields;
+  MovementType movement({MovementTrait::WALK});
+  printResult(map.name, "FlowFieldCache, 5 targets", measure(sharedQueries.size(), [&](int i) {
+    entryCalls = 0;
+    Vec2 from = sharedQueries[i].first;
+    Vec2 to = sharedQueries[i].second;
+    if (auto field = flowFields.get({to, movement}, FlowFieldCache::Generation(sectors.getGeneration(), 0, 0),
+        [&] { return FlowField(bounds, to, levelEntry, levelDirections); })) {
+      if (!field->getPath(from, levelDirections).empty())
+        return entryCalls;
+    }
+    ShortestPath(bounds, levelEntry, lengthFun(from), levelDirections, to, from);
+    return entryCalls;
+  }));
+  printResult(map.name, "Dijkstra radius 30", measure(queries.size(), [&](int i) {
+    return Dijkstra(bounds, {queries[i].first}, 30, levelEntry).getAllReachable().size();
+  }));
+  printResult(map.name, "BfSearch", measure(queries.size(), [&](int i) {
+    return BfSearch(bounds, queries[i].first, [&](Vec2 v) { return map.floor[v]; }).getAllReachable().size();
+  }));
+  Table<bool> blocking(bounds.minusMargin(-1), true);
+  for (Vec2 v : bounds)
+    blocking[v] = !map.floor[v];
+  FieldOfView::BlockingBits blockingBits(blocking);
+  FieldOfView::Visibility visibility;
+  vector<Vec2> viewers;
+  for (int i : Range(1000))
+    viewers.push_back(floor[random.get(floor.size())]);
+  printResult(map.name, "FieldOfView scalar", measure(viewers.size(), [&](int i) {
+    visibility.computeScalar(bounds, blocking, viewers[i].x, viewers[i].y);
+    return visibility.getVisibleTiles().size();
+  }));
+  printResult(map.name, "FieldOfView bitboard", measure(viewers.size(), [&](int i) {
+    visibility.compute(bounds, blockingBits, viewers[i].x, viewers[i].y);
+    return visibility.getVisibleTiles().size();
+  }));
+}
+
+}
+
+void PathBenchmark::run(int seed) {
+  RandomGen random;
+  random.init(seed);
+  Rectangle bounds = Level::getMaxBounds();
+  std::cout << "Benchmarking on " << bounds.width() << "x" << bounds.height() << " levels, seed " << seed << "\n";
+  for (auto map : {makeCaves(bounds, random), makeMaze(bounds, random), makeFortress(bounds, random)}) {
+    addPortals(map, 8, random);
+    runOnMap(std::move(map), random);
+  }
+}
@@ -0,0 +1,203 @@
+/* Copyright (C) 2013-2014 Michal Brzozowski (rusolis@poczta.fm)
+
+   This file is part of KeeperRL.
+
+   KeeperRL is free software; you can redistribute it and/or modify it under the terms of the
+   GNU General Public License as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   KeeperRL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+   even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with this program.
+   If not, see http://www.gnu.org/licenses/ . */
+
+#include "stdafx.h"
+#include "util.h"
+#include "path_clusters.h"
+#include "sectors.h"
+
+const int PathClusters::clusterSize = 16;
+
+static int getNumClusters(int length) {
+  return (length + PathClusters::clusterSize - 1) / PathClusters::clusterSize;
+}
+
+PathClusters::PathClusters(Rectangle b) : bounds(b), numY(getNumClusters(b.height())),
+    clusters(getNumClusters(b.width()) * numY) {
+}
+
+int PathClusters::getClusterIndex(Vec2 v) const {
+  return (v.x - bounds.left()) / clusterSize * numY + (v.y - bounds.top()) / clusterSize;
+}
+
+Rectangle PathClusters::getClusterBounds(int index) const {
+  Vec2 topLeft = bounds.topLeft() + Vec2(index / numY, index % numY) * clusterSize;
+  return Rectangle(topLeft, topLeft + Vec2(clusterSize, clusterSize)).intersection(bounds);
+}
+
+Rectangle PathClusters::getClusterBounds(Vec2 v) const {
+  return getClusterBounds(getClusterIndex(v));
+}
+
+void PathClusters::invalidate(Vec2 pos) {
+  // Squares next to the edge of a cluster also affect the entrances of the neighboring cluster.
+  for (Vec2 v : concat(pos.neighbors8(), pos))
+    if (v.inRectangle(bounds))
+      clusters[getClusterIndex(v)].dirty = true;
+}
+
+vector<int> PathClusters::getDistances(const Sectors& sectors, Rectangle area, Vec2 from) const {
+  auto getIndex = [&](Vec2 v) { return (v.x - area.left()) * area.height() + v.y - area.top(); };
+  vector<int> ret(area.width() * area.height(), -1);
+  queue<Vec2> q;
+  ret[getIndex(from)] = 0;
+  q.push(from);
+  while (!q.empty()) {
+    Vec2 pos = q.front();
+    q.pop();
+    for (Vec2 v : pos.neighbors8())
+      if (v.inRectangle(area) && ret[getIndex(v)] == -1 && sectors.contains(v)) {
+        ret[getIndex(v)] = ret[getIndex(pos)] + 1;
+        q.push(v);
+      }
+  }
+  return ret;
+}
+
+void PathClusters::rebuild(Cluster& cluster, Rectangle area, const Sectors& sectors) const {
+  cluster.entrances.clear();
+  cluster.entranceIndex.clear();
+  auto addEntrance = [&](Vec2 pos, Vec2 exit) {
+    if (auto index = getValueMaybe(cluster.entranceIndex, pos))
+      cluster.entrances[*index].exits.push_back(exit);
+    else {
+      cluster.entranceIndex[pos] = cluster.entrances.size();
+      cluster.entrances.push_back(Entrance{pos, {exit}});
+    }
+  };
+  // Every run of squares along an edge from which the neighboring cluster can be entered gets an entrance
+  // in its middle. The neighbor finds the same runs on its side, so the exits match its entrances.
+  auto addEdge = [&](Vec2 start, Vec2 step, int length, Vec2 outside) {
+    int runStart = -1;
+    for (int i : Range(length + 1)) {
+      Vec2 pos = start + step * i;
+      bool crossable = i < length && sectors.contains(pos) && (pos + outside).inRectangle(bounds) &&
+          sectors.contains(pos + outside);
+      if (crossable && runStart == -1)
+        runStart = i;
+      else if (!crossable && runStart > -1) {
+        Vec2 middle = start + step * ((runStart + i - 1) / 2);
+        addEntrance(middle, middle + outside);
+        runStart = -1;
+      }
+    }
+  };
+  addEdge(area.topLeft(), Vec2(1, 0), area.width(), Vec2(0, -1));
+  addEdge(Vec2(area.left(), area.bottom() - 1), Vec2(1, 0), area.width(), Vec2(0, 1));
+  addEdge(area.topLeft(), Vec2(0, 1), area.height(), Vec2(-1, 0));
+  addEdge(Vec2(area.right() - 1, area.top()), Vec2(0, 1), area.height(), Vec2(1, 0));
+  for (Vec2 v : area)
+    if (auto other = sectors.getExtraConnection(v))
+      if (sectors.contains(v) && sectors.contains(*other))
+        addEntrance(v, *other);
+  cluster.distances.clear();
+  for (auto& entrance : cluster.entrances) {
+    auto distances = getDistances(sectors, area, entrance.pos);
+    cluster.distances.push_back(cluster.entrances.transform([&](const Entrance& e) {
+      return distances[(e.pos.x - area.left()) * area.height() + e.pos.y - area.top()];
+    }));
+  }
+  cluster.dirty = false;
+}
+
+const PathClusters::Cluster& PathClusters::getUpdatedCluster(int index, const Sectors& sectors) {
+  auto& cluster = clusters[index];
+  if (cluster.dirty)
+    rebuild(cluster, getClusterBounds(index), sectors);
+  return cluster;
+}
+
+optional<vector<Vec2>> PathClusters::getWaypoints(const Sectors& sectors, Vec2 from, Vec2 to) {
+  PROFILE;
+  if (!sectors.same(from, to))
+    return none;
+  // Nodes are pairs of cluster index and entrance index. The start and the goal don't belong to any cluster.
+  using Node = pair<int, int>;
+  const Node start(-1, 0);
+  const Node goal(-1, 1);
+  int fromIndex = getClusterIndex(from);
+  int toIndex = getClusterIndex(to);
+  auto fromArea = getClusterBounds(fromIndex);
+  auto toArea = getClusterBounds(toIndex);
+  auto fromDistances = getDistances(sectors, fromArea, from);
+  auto toDistances = getDistances(sectors, toArea, to);
+  auto getFromDistance = [&](Vec2 v) {
+    return fromDistances[(v.x - fromArea.left()) * fromArea.height() + v.y - fromArea.top()];
+  };
+  auto getToDistance = [&](Vec2 v) {
+    return toDistances[(v.x - toArea.left()) * toArea.height() + v.y - toArea.top()];
+  };
+  auto getPos = [&](Node node) {
+    if (node == start)
+      return from;
+    if (node == goal)
+      return to;
+    return clusters[node.first].entrances[node.second].pos;
+  };
+  HashMap<Node, int> distance;
+  HashMap<Node, Node> parent;
+  using QueueElem = pair<int, Node>;
+  priority_queue<QueueElem, vector<QueueElem>, std::greater<QueueElem>> q;
+  distance[start] = 0;
+  q.push({from.dist8(to), start});
+  while (!q.empty()) {
+    auto elem = q.top();
+    q.pop();
+    Node node = elem.second;
+    int dist = distance.at(node);
+    if (elem.first > dist + getPos(node).dist8(to))
+      continue;
+    if (node == goal) {
+      vector<Vec2> ret;
+      for (; node != start; node = parent.at(node))
+        ret.push_back(getPos(node));
+      ret.push_back(from);
+      return ret.reverse();
+    }
+    auto visit = [&](Node next, int cost) {
+      int nextDist = dist + cost;
+      auto current = getValueMaybe(distance, next);
+      if (!current || *current > nextDist) {
+        distance[next] = nextDist;
+        parent[next] = node;
+        q.push({nextDist + getPos(next).dist8(to), next});
+      }
+    };
+    if (node == start) {
+      auto& cluster = getUpdatedCluster(fromIndex, sectors);
+      for (int i : All(cluster.entrances)) {
+        int d = getFromDistance(cluster.entrances[i].pos);
+        if (d > -1)
+          visit(Node(fromIndex, i), d);
+      }
+      if (fromIndex == toIndex && getFromDistance(to) > -1)
+        visit(goal, getFromDistance(to));
+      continue;
+    }
+    auto& cluster = getUpdatedCluster(node.first, sectors);
+    auto& entrance = cluster.entrances[node.second];
+    for (int i : All(cluster.entrances))
+      if (i != node.second && cluster.distances[node.second][i] > -1)
+        visit(Node(node.first, i), cluster.distances[node.second][i]);
+    for (Vec2 exit : entrance.exits) {
+      int exitIndex = getClusterIndex(exit);
+      if (auto index = getValueMaybe(getUpdatedCluster(exitIndex, sectors).entranceIndex, exit))
+        visit(Node(exitIndex, *index), 1);
+    }
+    if (node.first == toIndex && getToDistance(entrance.pos) > -1)
+      visit(goal, getToDistance(entrance.pos));
+  }
+  return none;
+}
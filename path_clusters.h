@@ -0,0 +1,58 @@
+/* Copyright (C) 2013-2014 Michal Brzozowski (rusolis@poczta.fm)
+
+   This file is part of KeeperRL.
+
+   KeeperRL is free software; you can redistribute it and/or modify it under the terms of the
+   GNU General Public License as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   KeeperRL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+   even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with this program.
+   If not, see http://www.gnu.org/licenses/ . */
+
+#pragma once
+
+#include "util.h"
+
+class Sectors;
+
+// Abstract graph over Sectors for planning long paths. The level is split into square clusters. Squares where a path
+// crosses into a neighboring cluster, or through a portal, are the nodes, and the distances between the nodes of each
+// cluster are precomputed. A cluster is recomputed lazily after a square in it or next to it changes.
+class PathClusters {
+  public:
+  PathClusters(Rectangle bounds);
+
+  static const int clusterSize;
+
+  void invalidate(Vec2);
+  Rectangle getClusterBounds(Vec2) const;
+
+  /** Returns squares leading from 'from' to 'to', in which every two consecutive squares are either in the same
+    cluster or a single move apart. Returns none if the graph doesn't connect the two squares.*/
+  optional<vector<Vec2>> getWaypoints(const Sectors&, Vec2 from, Vec2 to);
+
+  private:
+  struct Entrance {
+    Vec2 pos;
+    vector<Vec2> exits;
+  };
+  struct Cluster {
+    bool dirty = true;
+    vector<Entrance> entrances;
+    HashMap<Vec2, int> entranceIndex;
+    // Distances between entrances within the cluster, -1 if they're not connected.
+    vector<vector<int>> distances;
+  };
+  int getClusterIndex(Vec2) const;
+  Rectangle getClusterBounds(int index) const;
+  const Cluster& getUpdatedCluster(int index, const Sectors&);
+  void rebuild(Cluster&, Rectangle area, const Sectors&) const;
+  vector<int> getDistances(const Sectors&, Rectangle area, Vec2 from) const;
+  Rectangle bounds;
+  int numY;
+  vector<Cluster> clusters;
+};
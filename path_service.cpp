@@ -0,0 +1,158 @@
+/* Copyright (C) 2013-2014 Michal Brzozowski (rusolis@poczta.fm)
+
+   This file is part of KeeperRL.
+
+   KeeperRL is free software; you can redistribute it and/or modify it under the terms of the
+   GNU General Public License as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   KeeperRL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+   even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with this program.
+   If not, see http://www.gnu.org/licenses/ . */
+
+#include "stdafx.h"
+#include "util.h"
+#include "path_service.h"
+#include "shortest_path.h"
+#include "creature.h"
+#include "level.h"
+#include "sectors.h"
+#include "thread_pool.h"
+
+void PathService::request(const Creature* c, Position from, Position target) {
+  CHECK(from.isSameLevel(target));
+  requests[c->getUniqueId()] = Request{from.getCoord(), target.getCoord(), c->getMovementType()};
+}
+
+optional<LevelShortestPath> PathService::getResult(const Creature* c, Position target) {
+  auto id = c->getUniqueId();
+  if (auto path = getReferenceMaybe(results, id))
+    if (path->front() == target.getCoord()) {
+      auto ret = LevelShortestPath(ShortestPath(target.getLevel()->getBounds(), std::move(*path)), target.getLevel());
+      results.erase(id);
+      return ret;
+    }
+  return none;
+}
+
+// Runs without touching the level, so that several searches can run at once. Follows LevelShortestPath,
+// except that the portals aren't taken into account in the distance estimate.
+vector<Vec2> PathService::Search::find(const Snapshot& snapshot, Vec2 from, Vec2 target) {
+  ++generation;
+  auto& bounds = distance.getBounds();
+  auto getDistance = [&](Vec2 v) -> double {
+    return generations[v] == generation ? distance[v] : ShortestPath::infinity;
+  };
+  auto setDistance = [&](Vec2 v, double d) {
+    distance[v] = d;
+    generations[v] = generation;
+  };
+  auto getNeighbors = [&](Vec2 v) {
+    auto ret = v.neighbors8();
+    if (auto portal = snapshot.portals[v])
+      ret.push_back(*portal);
+    return ret;
+  };
+  auto getEstimate = [&](Vec2 v) {
+    return 2 * (from.dist8(v) + 0.01 * from.distD(v));
+  };
+  using QueueElem = pair<double, Vec2>;
+  priority_queue<QueueElem, vector<QueueElem>, std::greater<QueueElem>> q;
+  setDistance(target, 0);
+  q.push({getEstimate(target), target});
+  while (!q.empty()) {
+    auto elem = q.top();
+    q.pop();
+    Vec2 pos = elem.second;
+    double posDist = getDistance(pos);
+    if (elem.first > posDist + getEstimate(pos))
+      continue;
+    if (pos == from) {
+      vector<Vec2> ret {from};
+      while (pos != target) {
+        Vec2 next = pos;
+        for (Vec2 v : getNeighbors(pos))
+          if (v.inRectangle(bounds) && getDistance(v) < getDistance(next))
+            next = v;
+        CHECK(next != pos) << "Can't track path from " << from << " to " << target;
+        pos = next;
+        ret.push_back(pos);
+      }
+      return ret.reverse();
+    }
+    for (Vec2 next : getNeighbors(pos))
+      if (next.inRectangle(bounds)) {
+        double nextDist = getDistance(next);
+        if (posDist < nextDist) {
+          double dist = posDist + (next == from ? 1.0 : snapshot.costs[next]);
+          if (dist < nextDist) {
+            setDistance(next, dist);
+            q.push({dist + getEstimate(next), next});
+          }
+        }
+      }
+  }
+  return {};
+}
+
+PathService::Snapshot& PathService::getSnapshot(Level* level, const MovementType& movementType) {
+  PROFILE;
+  auto generation = LevelShortestPath::getNavigationGeneration(level, movementType);
+  auto it = snapshots.find(movementType);
+  if (it == snapshots.end() || it->second.generation != generation) {
+    if (it != snapshots.end())
+      snapshots.erase(it);
+    it = snapshots.insert(make_pair(movementType, Snapshot{
+        LevelShortestPath::getNavigationCosts(level, movementType),
+        level->getSectors(movementType).getExtraConnections(), generation, {}})).first;
+  }
+  auto& snapshot = it->second;
+  snapshot.setCreatureCosts(LevelShortestPath::getCreatureNavigationCosts(level, movementType));
+  return snapshot;
+}
+
+void PathService::Snapshot::setCreatureCosts(const vector<pair<Vec2, float>>& newCosts) {
+  // In reverse, in case a square was changed twice.
+  for (int i = creatureCosts.size() - 1; i >= 0; --i)
+    costs[creatureCosts[i].first] = creatureCosts[i].second;
+  creatureCosts.clear();
+  for (auto& elem : newCosts) {
+    creatureCosts.push_back(make_pair(elem.first, costs[elem.first]));
+    costs[elem.first] = elem.second;
+  }
+}
+
+void PathService::resolve(Level* level) {
+  PROFILE;
+  results.clear();
+  if (requests.empty())
+    return;
+  HashMap<MovementType, const Snapshot*> used;
+  vector<pair<UniqueEntity<Creature>::Id, Request>> toResolve;
+  for (auto& elem : requests) {
+    auto& movementType = elem.second.movementType;
+    if (!used.count(movementType))
+      used[movementType] = &getSnapshot(level, movementType);
+    toResolve.push_back(elem);
+  }
+  requests.clear();
+  auto& pool = ThreadPool::get();
+  int numTasks = min<int>(toResolve.size(), pool.getConcurrency());
+  while (searches.size() < numTasks)
+    searches.push_back(Search{Table<float>(level->getBounds()), Table<int>(level->getBounds(), 0)});
+  vector<vector<Vec2>> paths(toResolve.size());
+  atomic<int> nextRequest {0};
+  pool.run(numTasks, [&](int task) {
+    auto& search = searches[task];
+    for (int index = nextRequest++; index < toResolve.size(); index = nextRequest++) {
+      auto& request = toResolve[index].second;
+      paths[index] = search.find(*used.at(request.movementType), request.from, request.target);
+    }
+  });
+  for (int i : All(toResolve))
+    if (!paths[i].empty())
+      results.insert(make_pair(toResolve[i].first, std::move(paths[i])));
+}
@@ -0,0 +1,66 @@
+/* Copyright (C) 2013-2014 Michal Brzozowski (rusolis@poczta.fm)
+
+   This file is part of KeeperRL.
+
+   KeeperRL is free software; you can redistribute it and/or modify it under the terms of the
+   GNU General Public License as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   KeeperRL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+   even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with this program.
+   If not, see http://www.gnu.org/licenses/ . */
+
+#pragma once
+
+#include "util.h"
+#include "movement_type.h"
+#include "unique_entity.h"
+#include "shortest_path.h"
+
+class Creature;
+class Level;
+class Position;
+
+// Path searches requested during a turn. At the end of the turn they are resolved together on the thread pool,
+// against a snapshot of the level's navigation costs. The snapshot is kept between turns and only taken again
+// when the level's navigation data changes, while the costs of squares with creatures are updated every turn.
+// Each result is kept until the end of the next turn.
+class PathService {
+  public:
+  void request(const Creature*, Position from, Position target);
+  optional<LevelShortestPath> getResult(const Creature*, Position target);
+  void resolve(Level*);
+
+  private:
+  struct Request {
+    Vec2 from;
+    Vec2 target;
+    MovementType movementType;
+  };
+  HashMap<UniqueEntity<Creature>::Id, Request> requests;
+  // Paths ordered like ShortestPath::getPath().
+  HashMap<UniqueEntity<Creature>::Id, vector<Vec2>> results;
+  struct Snapshot {
+    Table<float> costs;
+    Table<optional<Vec2>> portals;
+    LevelShortestPath::NavigationGeneration generation;
+    // Squares whose costs were raised because of creatures, with their costs without them.
+    vector<pair<Vec2, float>> creatureCosts;
+    // Restores the costs changed by the previous call and applies the new ones.
+    void setCreatureCosts(const vector<pair<Vec2, float>>&);
+  };
+  Snapshot& getSnapshot(Level*, const MovementType&);
+  HashMap<MovementType, Snapshot> snapshots;
+  // Search tables of one thread, reused between turns.
+  struct Search {
+    Table<float> distance;
+    Table<int> generations;
+    int generation = 0;
+    vector<Vec2> find(const Snapshot&, Vec2 from, Vec2 target);
+  };
+  vector<Search> searches;
+  friend class Test;
+};
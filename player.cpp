@@ -760,7 +760,7 @@ void Player::makeMove() {
             getView()->presentText("Sorry", "Couldn't parse \"" + action.get<string>() + "\": " + *error);
           else
             if (auto cnt = getView()->getNumber("Enter number of items", Range(1, 1000), 1))
-              creature->take(item/*.setPrefixChance(1)*/.get(*cnt, getGame()->getContentFactory()));
+              creature->take(item/*.setPrefixChance(1)*/.get(Random, *cnt, getGame()->getContentFactory()));
           break;
         }
         case UserInputId::SUMMON_ENEMY: {
@@ -1037,7 +1037,7 @@ static vector<WishedItemInfo> getWishedItems(ContentFactory* factory) {
   for (auto& creature : factory->getCreatures().getAllCreatures())
     ret.push_back(WishedItemInfo {
       creature,
-      factory->getCreatures().fromId(creature, TribeId::getMonster())->getName().bare(),
+      factory->getCreatures().fromId(Random, creature, TribeId::getMonster())->getName().bare(),
       Range(1, 2)
     });
   for (auto& elem : factory->items) {
@@ -1111,7 +1111,7 @@ void Player::grantWish(const string& message) {
     }
     wishType->visit(
         [&](ItemType itemType) {
-          auto items = itemType.get(count, getGame()->getContentFactory());
+          auto items = itemType.get(Random, count, getGame()->getContentFactory());
           auto name = items[0]->getPluralAName(items.size());
           getGame()->addAnalytics("wishItem", *text + ":" + name);
           creature->verb("receive", "receives", name);
@@ -829,7 +829,7 @@ optional<pair<ViewId, int>> PlayerControl::getCostObj(const optional<CostInfo>&
 string PlayerControl::getMinionName(CreatureId id) const {
   static map<CreatureId, string> names;
   if (!names.count(id))
-    names[id] = getGame()->getContentFactory()->getCreatures().fromId(id, TribeId::getMonster())->getName().bare();
+    names[id] = getGame()->getContentFactory()->getCreatures().fromId(Random, id, TribeId::getMonster())->getName().bare();
   return names.at(id);
 }
 
@@ -1327,8 +1327,8 @@ void PlayerControl::fillTechUnlocks(CollectiveInfo::LibraryInfo::TechInfo& techI
   for (auto& immigrant : collective->getImmigration().getImmigrants())
     for (auto& req : immigrant.requirements)
       if (req.type.getValueMaybe<TechId>() == tech) {
-        techInfo.unlocks.push_back({creatureFactory.getViewId(immigrant.getId(0)),
-            creatureFactory.getName(immigrant.getId(0)), "immigrants"});
+        techInfo.unlocks.push_back({creatureFactory.getViewId(immigrant.getId(Random, 0)),
+            creatureFactory.getName(immigrant.getId(Random, 0)), "immigrants"});
       }
 }
 
@@ -1381,7 +1381,7 @@ static optional<ImmigrantCreatureInfo> getImmigrantCreatureInfo(ContentFactory*
   static map<CreatureId, PCreature> creatureStats;
   auto getStats = [&](CreatureId id) -> Creature* {
     if (!creatureStats[id]) {
-      creatureStats[id] = factory->getCreatures().fromId(id, TribeId::getDarkKeeper());
+      creatureStats[id] = factory->getCreatures().fromId(Random, id, TribeId::getDarkKeeper());
     }
     return creatureStats[id].get();
   };
@@ -1761,7 +1761,7 @@ static ImmigrantDataInfo::SpecialTraitInfo getSpecialTraitInfo(const SpecialTrai
           return TraitInfo{toString(part.count) + " extra "_s + getName(part.part) + "s", false};
       },
       [&] (const ExtraIntrinsicAttack& a) {
-        return TraitInfo{capitalFirst(a.item.get(factory)->getName()), false};
+        return TraitInfo{capitalFirst(a.item.get(Random, factory)->getName()), false};
       },
       [&] (const OneOfTraits&) -> TraitInfo {
         FATAL << "Can't draw traits alternative";
@@ -1843,7 +1843,7 @@ void PlayerControl::fillImmigrationHelp(CollectiveInfo& info) const {
   static map<CreatureId, PCreature> creatureStats;
   auto getStats = [&](CreatureId id) -> Creature* {
     if (!creatureStats[id]) {
-      creatureStats[id] = contentFactory->getCreatures().fromId(id, TribeId::getDarkKeeper());
+      creatureStats[id] = contentFactory->getCreatures().fromId(Random, id, TribeId::getDarkKeeper());
     }
     return creatureStats[id].get();
   };
@@ -2032,6 +2032,10 @@ void PlayerControl::refreshGameInfo(GameInfo& gameInfo) const {
   gameInfo.modifiedSquares = gameInfo.totalSquares = 0;
   gameInfo.modifiedSquares += getCurrentLevel()->getNumGeneratedSquares();
   gameInfo.totalSquares += getCurrentLevel()->getNumTotalSquares();
+  auto sectorsUsage = getCurrentLevel()->getSectorsUsage();
+  gameInfo.sectorsMovementTypes = sectorsUsage.movementTypes;
+  gameInfo.distinctSectors = sectorsUsage.distinctSectors;
+  gameInfo.sectorsMemory = sectorsUsage.memory;
   info.teams.clear();
   for (int i : All(getTeams().getAll())) {
     TeamId team = getTeams().getAll()[i];
@@ -3199,7 +3203,7 @@ void PlayerControl::handleSelection(Position position, const BuildInfoTypes::Bui
           if (auto error = PrettyPrinting::parseObject(item, *input))
             getView()->presentText("Sorry", "Couldn't parse \"" + *input + "\": " + *error);
           else {
-            position.dropItems(item.get(*num, getGame()->getContentFactory()));
+            position.dropItems(item.get(Random, *num, getGame()->getContentFactory()));
           }
         }
     },
@@ -3294,7 +3298,7 @@ void PlayerControl::handleSelection(Position position, const BuildInfoTypes::Bui
     [&](BuildInfoTypes::PlaceMinion) {
       auto& factory = getGame()->getContentFactory()->getCreatures();
       vector<PCreature> allCreatures = factory.getAllCreatures().transform(
-          [this, &factory](CreatureId id){ return factory.fromId(id, getTribeId()); });
+          [this, &factory](CreatureId id){ return factory.fromId(Random, id, getTribeId()); });
       if (auto id = getView()->chooseCreature("Choose creature to place",
           allCreatures.transform([&](auto& c) { return PlayerInfo(c.get(), this->getGame()->getContentFactory()); }), "cancel")) {
         for (auto& c : allCreatures)
@@ -29,7 +29,7 @@
 #include "shortest_path.h"
 #include "bucket_map.h"
 #include "vision.h"
-#include "tile_gas.h"
+#include "gas_grid.h"
 #include "tile_gas_info.h"
 #include "attack.h"
 #include "attack_level.h"
@@ -71,6 +71,13 @@ Game* Position::getGame() const {
     return nullptr;
 }
 
+RandomGen& Position::getRandom() const {
+  if (level)
+    return level->getRandom();
+  else
+    return Random;
+}
+
 Position::Position(Vec2 v, Level* l) : coord(v), level(l), valid(level && level->inBounds(coord)) {
 }
 
@@ -243,8 +250,12 @@ void Position::registerPortal() {
     portals->registerPortal(*this);
     if (auto other = portals->getOtherPortal(*this)) {
       if (isSameLevel(*other)) {
-        for (auto& sectors : level->sectors)
-          sectors.second.addExtraConnection(coord, other->coord);
+        for (auto sectors : level->getDistinctSectors())
+          sectors->addExtraConnection(coord, other->coord);
+        for (auto& clusters : level->pathClusters) {
+          clusters.second.invalidate(coord);
+          clusters.second.invalidate(other->coord);
+        }
       } else {
         auto key = StairKey::getNew();
         setLandingLink(key);
@@ -260,11 +271,16 @@ void Position::removePortal() {
     auto& portals = getModel()->portals;
     if (auto other = portals->getOtherPortal(*this)) {
       if (isSameLevel(*other)) {
-        for (auto& sectors : level->sectors)
-          sectors.second.removeExtraConnection(coord, other->coord);
+        for (auto sectors : level->getDistinctSectors())
+          sectors->removeExtraConnection(coord, other->coord);
+        for (auto& clusters : level->pathClusters) {
+          clusters.second.invalidate(coord);
+          clusters.second.invalidate(other->coord);
+        }
       } else {
         removeLandingLink();
         other->removeLandingLink();
+        getModel()->calculateStairNavigation();
       }
     }
     portals->removePortal(*this);
@@ -443,7 +459,13 @@ string Position::getName() const {
 void Position::getViewIndex(ViewIndex& index, const Creature* viewer) const {
   PROFILE;
   if (isValid()) {
-    getSquare()->getViewIndex(getGame()->getContentFactory(), index, viewer);
+    auto factory = getGame()->getContentFactory();
+    getSquare()->getViewIndex(factory, index, viewer);
+    for (auto& type : factory->tileGasTypes) {
+      auto amount = level->gas->getAmount(type.first, coord);
+      if (amount > 0)
+        index.addGasAmount(type.second.name, type.second.color.transparency(amount * 255));
+    }
     if (isUnavailable())
       index.setHighlight(HighlightType::UNAVAILABLE);
     if (isCovered())
@@ -553,7 +575,7 @@ bool Position::canEnterEmptyCalc(const MovementType& t, optional<FurnitureLayer>
     return false;
   const auto square = getSquare();
   bool result = true;
-  const bool covered = isCovered() || getSquare()->hasSunlightBlockingGasAmount();
+  const bool covered = isCovered() || level->gas->hasSunlightBlockingAmount(coord);
   for (auto layer : ENUM_ALL(FurnitureLayer))
     if (layer != ignore)
       if (auto furniture = level->furniture->getBuilt(layer).getReadonly(coord)) {
@@ -763,6 +785,7 @@ void Position::removeFurniture(const Furniture* f, PFurniture replace, Creature*
   } else {
     level->furniture->getBuilt(layer).clearElem(coord);
     level->furniture->eraseConstruction(coord, layer);
+    level->setNeedsZLevelUpdate(coord);
   }
   updateMovementDueToFire();
   updateConnectivity();
@@ -859,13 +882,13 @@ bool Position::fireDamage(int amount) const {
   PROFILE;
   bool res = false;
   for (auto furniture : modFurniture())
-    if (Random.chance(0.05 * amount))
+    if (getRandom().chance(0.05 * amount))
       res |= furniture->fireDamage(*this);
   if (Creature* creature = getCreature())
-    creature->takeDamage(Attack(nullptr, Random.choose<AttackLevel>(), AttackType::HIT, amount,
+    creature->takeDamage(Attack(nullptr, getRandom().choose<AttackLevel>(), AttackType::HIT, amount,
         AttrType("FIRE_DAMAGE"), {}, "The fire is harmless", false));
   for (Item* it : getItems())
-    if (Random.chance(0.05 * amount))
+    if (getRandom().chance(0.05 * amount))
       it->fireDamage(*this);
   return res;
 }
@@ -874,13 +897,13 @@ bool Position::iceDamage(int amount) const {
   PROFILE;
   bool res = false;
   for (auto furniture : modFurniture())
-    if (Random.chance(0.05 * amount))
+    if (getRandom().chance(0.05 * amount))
       res |= furniture->iceDamage(*this);
   if (Creature* creature = getCreature())
-    creature->takeDamage(Attack(nullptr, Random.choose<AttackLevel>(), AttackType::HIT, amount,
+    creature->takeDamage(Attack(nullptr, getRandom().choose<AttackLevel>(), AttackType::HIT, amount,
         AttrType("COLD_DAMAGE"), {}, "The cold is harmless"));
   for (Item* it : getItems())
-    if (Random.chance(0.05 * amount))
+    if (getRandom().chance(0.05 * amount))
       it->iceDamage(*this);
   return res;
 }
@@ -889,13 +912,13 @@ bool Position::acidDamage(int amount) const {
   PROFILE;
   bool res = false;
   for (auto furniture : modFurniture())
-    if (Random.chance(0.05 * amount))
+    if (getRandom().chance(0.05 * amount))
       res |= furniture->acidDamage(*this);
   if (Creature* creature = getCreature())
-    creature->takeDamage(Attack(nullptr, Random.choose<AttackLevel>(), AttackType::HIT, amount,
+    creature->takeDamage(Attack(nullptr, getRandom().choose<AttackLevel>(), AttackType::HIT, amount,
         AttrType("ACID_DAMAGE"), {}, "The acid is harmless"));
   /*for (Item* it : getItems())
-    if (Random.chance(amount))
+    if (getRandom().chance(amount))
       it->acidDamage(*this);*/
   return res;
 }
@@ -974,14 +997,20 @@ vector<Position> Position::getVisibleTiles(const Vision& vision) {
 
 void Position::addGas(TileGasType type, double amount) {
   PROFILE;
-  if (isValid())
-    modSquare()->addGas(*this, type, amount);
+  if (isValid()) {
+    setNeedsRenderAndMemoryUpdate(true);
+    if (canSeeThruIgnoringGas(VisionId::NORMAL) && level->gas->addAmount(type, coord, amount)) {
+      if (getGame()->getContentFactory()->tileGasTypes.at(type).blocksVision)
+        updateVisibility();
+      updateConnectivity();
+    }
+  }
 }
 
 double Position::getGasAmount(TileGasType type) const {
   PROFILE;
   if (isValid())
-    return getSquare()->getGasAmount(type);
+    return level->gas->getAmount(type, coord);
   else
     return 0;
 }
@@ -1001,7 +1030,7 @@ bool Position::isCovered() const {
 bool Position::sunlightBurns() const {
   PROFILE;
   return isValid() && !isCovered() && level->lightCapAmount[coord] >= 1 &&
-      getGame()->getSunlightInfo().getState() == SunlightState::DAY && !getSquare()->hasSunlightBlockingGasAmount();
+      getGame()->getSunlightInfo().getState() == SunlightState::DAY && !level->gas->hasSunlightBlockingAmount(coord);
 }
 
 double Position::getLightEmission() const {
@@ -1055,18 +1084,25 @@ void Position::updateConnectivity() const {
   // It's important that sectors aren't generated at this point, because we need stale data to detect change.
   auto movementEventPredicate = [this] { return level->getSectorsDontCreate({MovementTrait::WALK}).contains(coord); };
   bool couldEnter = movementEventPredicate();
-  if (isValid()) {
-    for (auto& elem : level->sectors)
-      if (canNavigateCalc(elem.first))
-        elem.second.add(coord);
-      else
-        elem.second.remove(coord);
-  }
+  updateSectors();
   if (couldEnter != movementEventPredicate())
     if (auto game = getGame())
       game->addEvent(EventInfo::MovementChanged{*this});
 }
 
+void Position::updateSectors() const {
+  if (isValid()) {
+    updateNavigationCost();
+    level->updateSectors(coord);
+  }
+}
+
+void Position::updateNavigationCost() const {
+  if (isValid())
+    for (auto& costs : level->navigationCosts)
+      costs.second.invalidate(coord);
+}
+
 void Position::updateVisibility() const {
   PROFILE;
   if (isValid())
@@ -1146,20 +1182,24 @@ optional<DestroyAction> Position::getBestDestroyAction(const MovementType& movem
   return none;
 }
 
-double Position::getNavigationCost(const MovementType& movement, const Sectors& onltMovementSectors) const {
+double Position::getNavigationCost(const MovementType& movement, const Sectors& onlyMovementSectors,
+    NavigationCostGrid& costs, bool includeCreatures) const {
   PROFILE;
-  if (onltMovementSectors.contains(coord)) {
-    if (level->getSafeSquare(coord)->getCreature()) {
+  // Creatures move too often for their squares to be kept in the grid.
+  if (onlyMovementSectors.contains(coord)) {
+    if (includeCreatures && level->getSafeSquare(coord)->getCreature()) {
       return 5.0;
     } else
       return 1.0;
   }
-  if (auto destroyAction = getBestDestroyAction(movement))
-    return 1.0 + *getFurniture(FurnitureLayer::MIDDLE)->getStrength(*destroyAction) / 10;
-  if (movement.canBuildBridge() && canConstruct(FurnitureType("BRIDGE")) &&
-      !movement.isCompatible(getFurniture(FurnitureLayer::GROUND)->getTribe()))
-    return 10;
-  return ShortestPath::infinity;
+  return costs.get(coord, [&] {
+    if (auto destroyAction = getBestDestroyAction(movement))
+      return 1.0 + *getFurniture(FurnitureLayer::MIDDLE)->getStrength(*destroyAction) / 10;
+    if (movement.canBuildBridge() && canConstruct(FurnitureType("BRIDGE")) &&
+        !movement.isCompatible(getFurniture(FurnitureLayer::GROUND)->getTribe()))
+      return 10.0;
+    return ShortestPath::infinity;
+  });
 }
 
 bool Position::canNavigate(const MovementType& type) const {
@@ -1198,7 +1238,7 @@ bool Position::canSeeThru(VisionId id, const ContentFactory* factory) const {
   if (!isValid() || !canSeeThruIgnoringGas(id))
     return false;
   for (auto& type : factory->tileGasTypes)
-    if (type.second.blocksVision && getSquare()->getGasAmount(type.first) >= TileGas::getFogVisionCutoff())
+    if (type.second.blocksVision && level->gas->getAmount(type.first, coord) >= GasGrid::getFogVisionCutoff())
       return false;
   return true;
 }
@@ -1297,52 +1337,37 @@ optional<pair<Position, int>> Position::getStairsTo(Position targetPos, const Mo
     bool includeNeighbors) const {
   PROFILE;
   CHECK(isSameModel(targetPos));
-  HashMap<StairKey, int> distance;
-  using QueueElem = tuple<StairKey, Level*, Level*, int>;
-  auto queueCmp = [](auto& elem1, auto& elem2) { return std::get<3>(elem1) > std::get<3>(elem2); };
-  priority_queue<QueueElem, vector<QueueElem>, decltype(queueCmp)> q(queueCmp);
   auto model = targetPos.getModel();
-  auto relaxKey = [model, &movement, &distance, &q](int thisValue, Position thisPos) {
-    auto level = thisPos.level;
-    for (auto key : level->getAllStairKeys())
-      if (auto linked = model->getLinkedLevel(level, key)) {
-        auto stairpos = level->getLandingSquares(key)[0];
-        if (thisPos.isConnectedTo(stairpos, movement)) {
-          auto value = thisValue + *thisPos.dist8(stairpos) + 1;
-          auto cur = getValueMaybe(distance, key);
-          if (!cur || *cur > value) {
-            distance[key] = value;
-            q.push(make_tuple(key, level, linked, value));
-          }
-        }
+  auto targetLevel = targetPos.level;
+  vector<pair<StairKey, int>> targetStairs;
+  for (auto key : targetLevel->getAllStairKeys()) {
+    auto stairPos = targetLevel->getLandingSquares(key)[0];
+    optional<int> value;
+    auto relax = [&](Position pos) {
+      if (pos.isConnectedTo(stairPos, movement)) {
+        auto dist = *pos.dist8(stairPos) + 1;
+        if (!value || *value > dist)
+          value = dist;
       }
-  };
-  relaxKey(0, targetPos);
-  if (includeNeighbors)
-    for (auto neighbor : targetPos.neighbors8())
-      relaxKey(0, neighbor);
-  while (!q.empty()) {
-    auto cur = q.top();
-    q.pop();
-    auto thisKey = std::get<0>(cur);
-    auto l1 = std::get<1>(cur);
-    auto l2 = std::get<2>(cur);
-    auto thisValue = std::get<3>(cur);
-    if (thisValue == distance.at(thisKey)) {
-      relaxKey(thisValue, l1->getLandingSquares(thisKey)[0]);
-      relaxKey(thisValue, l2->getLandingSquares(thisKey)[0]);
-    }
+    };
+    relax(targetPos);
+    if (includeNeighbors)
+      for (auto neighbor : targetPos.neighbors8())
+        relax(neighbor);
+    if (value)
+      targetStairs.push_back(make_pair(key, *value));
   }
   optional<pair<Position, int>> ret;
-  for (auto key : level->getAllStairKeys())
-    if (auto keyRes = getValueMaybe(distance, key)) {
-      auto stairPos = level->getLandingSquares(key)[0];
-      if (isConnectedTo(stairPos, movement)) {
-        auto res = *keyRes + *dist8(stairPos);
-        if (!ret || res < ret->second)
-          ret = make_pair(stairPos, res);
-      }
-    }
+  for (auto key : level->getAllStairKeys()) {
+    auto stairPos = level->getLandingSquares(key)[0];
+    if (isConnectedTo(stairPos, movement))
+      for (auto& targetStair : targetStairs)
+        if (auto stairDist = model->getStairDistance(targetStair.first, key, movement)) {
+          auto res = targetStair.second + *stairDist + *dist8(stairPos);
+          if (!ret || res < ret->second)
+            ret = make_pair(stairPos, res);
+        }
+  }
   return ret;
 }
 
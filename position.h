@@ -20,6 +20,7 @@ class DestroyAction;
 class Inventory;
 class Vision;
 class Sectors;
+class NavigationCostGrid;
 class ContentFactory;
 struct FurnitureEffectInfo;
 
@@ -31,6 +32,8 @@ class Position {
   static vector<Position> getAll(Level*, Rectangle);
   Model* getModel() const;
   Game* getGame() const;
+  /** Returns the model's random number stream, or the global one if the position isn't on a level. */
+  RandomGen& getRandom() const;
   optional<int> dist8(const Position&) const;
   bool isSameLevel(const Position&) const;
   bool isSameLevel(const Level*) const;
@@ -121,10 +124,16 @@ class Position {
   bool canNavigate(const MovementType& type) const;
   bool canNavigateToOrNeighbor(Position, const MovementType&) const;
   bool canNavigateTo(Position, const MovementType&) const;
-  double getNavigationCost(const MovementType&, const Sectors& onltMovementSectors) const;
+  // Without includeCreatures the cost doesn't depend on where creatures are standing.
+  double getNavigationCost(const MovementType&, const Sectors& onlyMovementSectors, NavigationCostGrid&,
+      bool includeCreatures = true) const;
   optional<DestroyAction> getBestDestroyAction(const MovementType&) const;
   vector<Position> getVisibleTiles(const Vision&);
   void updateConnectivity() const;
+  /** Updates the Sectors of the level without firing events. Use updateConnectivity() instead, unless
+    the events are fired separately.*/
+  void updateSectors() const;
+  void updateNavigationCost() const;
   void updateVisibility() const;
   bool canSeeThruIgnoringGas(VisionId) const;
   bool canSeeThru(VisionId) const;
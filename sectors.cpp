@@ -18,7 +18,23 @@
 #include "level.h"
 #include <limits>
 
-SERIALIZE_DEF(Sectors, bounds, sectors, allPos, extraConnections)
+template <class Archive>
+void Sectors::serialize(Archive& ar, const unsigned int) {
+  // Sectors are stored as position sets to keep the save format unchanged.
+  vector<HashSet<Vec2>> allPos;
+  if (Archive::is_saving::value) {
+    CHECK(!batching);
+    allPos.resize(sectorSizes.size());
+    for (Vec2 v : bounds)
+      if (contains(v))
+        allPos[sectors[v]].insert(v);
+  }
+  ar(bounds, sectors, allPos, extraConnections);
+  if (Archive::is_loading::value)
+    sectorSizes = allPos.transform([](const HashSet<Vec2>& pos) { return (int) pos.size(); });
+}
+
+SERIALIZABLE(Sectors);
 
 SERIALIZATION_CONSTRUCTOR_IMPL(Sectors)
 
@@ -35,9 +51,24 @@ bool Sectors::contains(Vec2 v) const {
   return sectors[v] > -1;
 }
 
+long long Sectors::getNewGeneration() {
+  static atomic<long long> generationCounter(0);
+  return ++generationCounter;
+}
+
+long long Sectors::getGeneration() const {
+  return generation;
+}
+
 bool Sectors::add(Vec2 pos) {
   if (contains(pos))
     return false;
+  generation = getNewGeneration();
+  if (batching) {
+    batchChanges.push_back(make_pair(pos, sectors[pos]));
+    setSector(pos, *batchSector);
+    return true;
+  }
   set<int> neighbors;
   for (Vec2 v : getNeighbors(pos))
     if (v.inRectangle(bounds) && contains(v))
@@ -49,7 +80,7 @@ bool Sectors::add(Vec2 pos) {
   else {
     int largest = -1;
     for (int elem : neighbors)
-      if (largest == -1 || allPos[largest].size() < allPos[elem].size())
+      if (largest == -1 || sectorSizes[largest] < sectorSizes[elem])
         largest = elem;
     join(pos, largest);
   }
@@ -59,21 +90,21 @@ bool Sectors::add(Vec2 pos) {
 void Sectors::setSector(Vec2 pos, SectorId sector) {
   CHECK(sectors[pos] != sector);
   if (contains(pos))
-    allPos[sectors[pos]].erase(pos);
+    --sectorSizes[sectors[pos]];
   sectors[pos] = sector;
-  allPos[sector].insert(pos);
+  ++sectorSizes[sector];
 }
 
 Sectors::SectorId Sectors::getNewSector() {
-  allPos.emplace_back(0);
-  CHECK(allPos.size() < std::numeric_limits<SectorId>::max());
-  return allPos.size() - 1;
+  sectorSizes.push_back(0);
+  CHECK(sectorSizes.size() < std::numeric_limits<SectorId>::max());
+  return sectorSizes.size() - 1;
 }
 
 int Sectors::getNumSectors() const {
   int ret = 0;
-  for (auto& elem : allPos)
-    if (elem.size() > 0)
+  for (auto& elem : sectorSizes)
+    if (elem > 0)
       ++ret;
   return ret;
 }
@@ -93,13 +124,13 @@ void Sectors::join(Vec2 pos1, SectorId sector) {
   }
 }
 
-static DirtyTable<int> bfsTable(Level::getMaxBounds(), -1);
+static thread_local DirtyTable<int> bfsTable(Level::getMaxBounds(), -1);
 
-vector<Vec2> Sectors::getDisjoint(Vec2 pos) const {
+vector<Vec2> Sectors::getDisjoint(const vector<Vec2>& seeds) const {
   vector<queue<Vec2>> queues;
   bfsTable.clear();
   int numNeighbor = 0;
-  for (Vec2 v : getNeighbors(pos))
+  for (Vec2 v : seeds)
     if (v.inRectangle(bounds) && contains(v) && !bfsTable.isDirty(v)) {
         bfsTable.setValue(v, numNeighbor++);
         queues.emplace_back();
@@ -119,7 +150,7 @@ vector<Vec2> Sectors::getDisjoint(Vec2 pos) const {
         lastNeighbor = myNum;
         q.pop();
         for (Vec2 w : getNeighbors(v))
-          if (w.inRectangle(bounds) && contains(w) && w != pos) {
+          if (w.inRectangle(bounds) && contains(w)) {
             if (!bfsTable.isDirty(w)) {
               bfsTable.setValue(w, myNum);
               q.push(w);
@@ -131,15 +162,23 @@ vector<Vec2> Sectors::getDisjoint(Vec2 pos) const {
       break;
     }
   }
-  int maxSector = allPos.size() - 1;
+  int maxSector = sectorSizes.size() - 1;
   vector<Vec2> ret;
-  for (Vec2 v : getNeighbors(pos))
+  for (Vec2 v : seeds)
     if (v.inRectangle(bounds) && sectors[v] <= maxSector && contains(v) &&
           !sets.same(bfsTable.getDirtyValue(v), lastNeighbor))
       ret.push_back(v);
   return ret;
 }
 
+void Sectors::split(const vector<Vec2>& seeds) {
+  // Every cut off component gets an id from firstNew up, so it's relabelled only once.
+  SectorId firstNew = sectorSizes.size();
+  for (Vec2 v : getDisjoint(seeds))
+    if (sectors[v] < firstNew)
+      join(v, getNewSector());
+}
+
 vector<Vec2> Sectors::getNeighbors(Vec2 pos) const {
   auto ret = pos.neighbors8();
   if (auto con = extraConnections[pos])
@@ -148,11 +187,12 @@ vector<Vec2> Sectors::getNeighbors(Vec2 pos) const {
 }
 
 void Sectors::addExtraConnection(Vec2 pos1, Vec2 pos2) {
+  generation = getNewGeneration();
   if (contains(pos1) && contains(pos2)) {
     auto sector1 = sectors[pos1];
     auto sector2 = sectors[pos2];
     if (sector1 != sector2) {
-      if (allPos[sector1].size() > allPos[sector2].size())
+      if (sectorSizes[sector1] > sectorSizes[sector2])
         join(pos2, sector1);
       else
         join(pos1, sector2);
@@ -165,6 +205,7 @@ void Sectors::addExtraConnection(Vec2 pos1, Vec2 pos2) {
 }
 
 void Sectors::removeExtraConnection(Vec2 pos1, Vec2 pos2) {
+  generation = getNewGeneration();
   extraConnections[pos1] = none;
   extraConnections[pos2] = none;
   join(pos1, getNewSector());
@@ -174,17 +215,31 @@ const Sectors::ExtraConnections Sectors::getExtraConnections() const {
   return extraConnections;
 }
 
+optional<Vec2> Sectors::getExtraConnection(Vec2 v) const {
+  return extraConnections[v];
+}
+
+int Sectors::getMemoryUsage() const {
+  const int area = bounds.width() * bounds.height();
+  return sizeof(*this) + area * (sizeof(SectorId) + sizeof(optional<Vec2>)) + sectorSizes.capacity() * sizeof(int) +
+      batchChanges.capacity() * sizeof(batchChanges[0]);
+}
+
 Sectors::SectorId Sectors::getLargest() const {
   PROFILE;
   int ret = 0;
-  for (int i : All(allPos))
-    if (allPos[i].size() > allPos[ret].size())
+  for (int i : All(sectorSizes))
+    if (sectorSizes[i] > sectorSizes[ret])
       ret = i;
   return SectorId(ret);
 }
 
-const Sectors::PosSet& Sectors::getWholeSector(SectorId id) const {
-  return allPos[id];
+vector<Vec2> Sectors::getWholeSector(SectorId id) const {
+  vector<Vec2> ret;
+  for (Vec2 v : bounds)
+    if (sectors[v] == id)
+      ret.push_back(v);
+  return ret;
 }
 
 optional<Sectors::SectorId> Sectors::getSector(Vec2 v) const {
@@ -198,13 +253,131 @@ optional<Sectors::SectorId> Sectors::getSector(Vec2 v) const {
 bool Sectors::remove(Vec2 pos) {
   if (!contains(pos))
     return false;
-  allPos[sectors[pos]].erase(pos);
+  generation = getNewGeneration();
+  if (batching)
+    batchChanges.push_back(make_pair(pos, sectors[pos]));
+  --sectorSizes[sectors[pos]];
   sectors[pos] = -1;
-  for (Vec2 v : getDisjoint(pos))
-    join(v, getNewSector());
+  if (!batching)
+    split(getNeighbors(pos));
   return true;
 }
 
+void Sectors::beginBatch() {
+  CHECK(!batching);
+  batching = true;
+  if (!batchSector)
+    batchSector = getNewSector();
+}
+
+static thread_local DirtyTable<char> batchTable(Level::getMaxBounds(), 0);
+
+void Sectors::commitBatch() {
+  PROFILE;
+  if (!batching)
+    return;
+  batching = false;
+  auto tmpSector = *batchSector;
+  // The batch is undone first, so that every sector is one connected component again. Added positions are left out
+  // until the removals are applied, and positions that are back in their old state keep their sector.
+  vector<Vec2> removed;
+  vector<Vec2> added;
+  batchTable.clear();
+  for (auto& change : batchChanges) {
+    Vec2 pos = change.first;
+    if (batchTable.isDirty(pos))
+      continue;
+    batchTable.setValue(pos, 1);
+    bool wasIn = change.second > -1;
+    if (contains(pos))
+      --sectorSizes[sectors[pos]];
+    else if (wasIn)
+      removed.push_back(pos);
+    if (!wasIn && contains(pos))
+      added.push_back(pos);
+    sectors[pos] = change.second;
+    if (wasIn)
+      ++sectorSizes[change.second];
+  }
+  batchChanges.clear();
+  // Every connected group of removed positions is removed at once and checked like in remove(). Its remaining
+  // neighbors are searched from together, grouped by sector, until the parts of each sector meet.
+  batchTable.clear();
+  for (Vec2 pos : removed)
+    batchTable.setValue(pos, 0);
+  vector<Vec2> group;
+  vector<Vec2> seeds;
+  for (Vec2 pos : removed)
+    if (!batchTable.getDirtyValue(pos)) {
+      group.clear();
+      seeds.clear();
+      group.push_back(pos);
+      batchTable.setValue(pos, 1);
+      for (int i = 0; i < group.size(); ++i)
+        for (Vec2 v : getNeighbors(group[i]))
+          if (v.inRectangle(bounds) && batchTable.isDirty(v) && !batchTable.getDirtyValue(v)) {
+            batchTable.setValue(v, 1);
+            group.push_back(v);
+          }
+      for (Vec2 v : group) {
+        --sectorSizes[sectors[v]];
+        sectors[v] = -1;
+      }
+      for (Vec2 v : group)
+        for (Vec2 w : getNeighbors(v))
+          if (w.inRectangle(bounds) && contains(w))
+            seeds.push_back(w);
+      sort(seeds.begin(), seeds.end(), [&](Vec2 v, Vec2 w) { return sectors[v] < sectors[w]; });
+      vector<Vec2> sameSector;
+      for (int i : All(seeds)) {
+        sameSector.push_back(seeds[i]);
+        if (i == seeds.size() - 1 || sectors[seeds[i + 1]] != sectors[seeds[i]]) {
+          split(sameSector);
+          sameSector.clear();
+        }
+      }
+    }
+  // Added positions are joined with their neighbors like in add(), one connected group at a time.
+  for (Vec2 pos : added)
+    setSector(pos, tmpSector);
+  batchTable.clear();
+  vector<Vec2> touching;
+  optional<SectorId> largest;
+  auto visit = [&] (Vec2 v) {
+    if (!v.inRectangle(bounds) || !contains(v))
+      return;
+    if (sectors[v] != tmpSector) {
+      touching.push_back(v);
+      if (!largest || sectorSizes[*largest] < sectorSizes[sectors[v]])
+        largest = sectors[v];
+    } else if (!batchTable.isDirty(v)) {
+      batchTable.setValue(v, 1);
+      group.push_back(v);
+    }
+  };
+  for (Vec2 pos : added)
+    if (sectors[pos] == tmpSector && !batchTable.isDirty(pos)) {
+      group.clear();
+      touching.clear();
+      largest = none;
+      visit(pos);
+      for (int i = 0; i < group.size(); ++i) {
+        for (Vec2 dir : Vec2::directions8())
+          visit(group[i] + dir);
+        if (auto con = extraConnections[group[i]])
+          visit(*con);
+      }
+      if (!largest)
+        largest = getNewSector();
+      for (Vec2 v : group)
+        setSector(v, *largest);
+      for (Vec2 v : touching)
+        if (sectors[v] != *largest)
+          join(v, *largest);
+    }
+  CHECK(sectorSizes[tmpSector] == 0);
+}
+
 void Sectors::dump() {
   for (int i : Range(bounds.height())) {
     for (int j : Range(bounds.width()))
@@ -26,20 +26,31 @@ class Sectors {
   bool same(Vec2, Vec2) const;
   bool add(Vec2);
   bool remove(Vec2);
+  /** Starts collecting add() and remove() calls, which are then applied together by commitBatch().
+    Queries other than contains() are unreliable until the batch is committed.*/
+  void beginBatch();
+  void commitBatch();
   void dump();
   bool contains(Vec2) const;
   int getNumSectors() const;
   void addExtraConnection(Vec2, Vec2);
   void removeExtraConnection(Vec2, Vec2);
   const ExtraConnections getExtraConnections() const;
+  optional<Vec2> getExtraConnection(Vec2) const;
 
-  using PosSet = HashSet<Vec2>;
   using SectorId = short;
-  const PosSet& getWholeSector(SectorId) const;
+  vector<Vec2> getWholeSector(SectorId) const;
 
   SectorId getLargest() const;
   optional<SectorId> getSector(Vec2) const;
 
+  /** Changes every time connectivity may have changed. Values are unique across all Sectors objects,
+    so a regenerated Sectors never repeats an old value. */
+  long long getGeneration() const;
+
+  /** Returns the approximate number of bytes used by this object.*/
+  int getMemoryUsage() const;
+
   SERIALIZATION_DECL(Sectors)
 
   private:
@@ -47,10 +58,19 @@ class Sectors {
   void setSector(Vec2, SectorId);
   SectorId getNewSector();
   void join(Vec2, SectorId);
-  vector<Vec2> getDisjoint(Vec2) const;
+  vector<Vec2> getDisjoint(const vector<Vec2>& seeds) const;
+  void split(const vector<Vec2>& seeds);
   Rectangle SERIAL(bounds);
   Table<SectorId> SERIAL(sectors);
-  vector<PosSet> SERIAL(allPos);
+  // Number of positions in every sector.
+  vector<int> sectorSizes;
   ExtraConnections SERIAL(extraConnections);
+  // Holds positions added during a batch. Allocated once and reused, as sector ids are never freed.
+  optional<SectorId> batchSector;
+  bool batching = false;
+  // Every change made during a batch, with the sector the position had before it.
+  vector<pair<Vec2, SectorId>> batchChanges;
+  static long long getNewGeneration();
+  long long generation = getNewGeneration();
 };
 
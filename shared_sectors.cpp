@@ -0,0 +1,100 @@
+/* Copyright (C) 2013-2014 Michal Brzozowski (rusolis@poczta.fm)
+
+   This file is part of KeeperRL.
+
+   KeeperRL is free software; you can redistribute it and/or modify it under the terms of the
+   GNU General Public License as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   KeeperRL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+   even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with this program.
+   If not, see http://www.gnu.org/licenses/ . */
+
+#include "stdafx.h"
+#include "shared_sectors.h"
+
+Sectors* SharedSectors::getMaybe(const MovementType& movement) const {
+  if (auto res = getReferenceMaybe(sectors, movement))
+    return res->get();
+  return nullptr;
+}
+
+Sectors& SharedSectors::add(const MovementType& movement, const Table<bool>& navigable) {
+  CHECK(!sectors.count(movement));
+  auto& bounds = navigable.getBounds();
+  auto isSame = [&] (const Sectors& other) {
+    for (Vec2 v : bounds)
+      if (navigable[v] != other.contains(v))
+        return false;
+    return true;
+  };
+  for (auto other : getDistinct())
+    if (isSame(*other))
+      for (auto& elem : sectors)
+        if (elem.second.get() == other) {
+          sectors.insert(make_pair(movement, elem.second));
+          return *other;
+        }
+  auto newSectors = make_shared<Sectors>(bounds, sectors.empty()
+      ? Sectors::ExtraConnections(bounds)
+      : sectors.begin()->second->getExtraConnections());
+  for (Vec2 v : bounds)
+    if (navigable[v])
+      newSectors->add(v);
+  sectors.insert(make_pair(movement, newSectors));
+  return *newSectors;
+}
+
+void SharedSectors::erase(const MovementType& movement) {
+  sectors.erase(movement);
+}
+
+vector<MovementType> SharedSectors::getMovementTypes() const {
+  return getKeys(sectors);
+}
+
+vector<Sectors*> SharedSectors::getDistinct() const {
+  vector<Sectors*> ret;
+  for (auto& elem : sectors)
+    if (!ret.contains(elem.second.get()))
+      ret.push_back(elem.second.get());
+  return ret;
+}
+
+vector<MovementType> SharedSectors::update(Vec2 coord, function<bool(const MovementType&)> canNavigateFun) {
+  vector<MovementType> ret;
+  for (auto group : getDistinct()) {
+    vector<MovementType> canNavigate;
+    vector<MovementType> cantNavigate;
+    for (auto& elem : sectors)
+      if (elem.second.get() == group)
+        (canNavigateFun(elem.first) ? canNavigate : cantNavigate).push_back(elem.first);
+    if (!canNavigate.empty() && !cantNavigate.empty()) {
+      auto copy = make_shared<Sectors>(*group);
+      for (auto& movement : canNavigate.size() < cantNavigate.size() ? canNavigate : cantNavigate)
+        sectors[movement] = copy;
+    }
+    auto apply = [&] (const vector<MovementType>& movements, bool navigable) {
+      if (!movements.empty()) {
+        auto& groupSectors = *sectors.at(movements[0]);
+        if (navigable ? groupSectors.add(coord) : groupSectors.remove(coord))
+          ret.append(movements);
+      }
+    };
+    apply(canNavigate, true);
+    apply(cantNavigate, false);
+  }
+  return ret;
+}
+
+SharedSectors::Usage SharedSectors::getUsage() const {
+  Usage ret {(int) sectors.size(), 0, 0};
+  for (auto elem : getDistinct()) {
+    ++ret.distinctSectors;
+    ret.memory += elem->getMemoryUsage();
+  }
+  return ret;
+}
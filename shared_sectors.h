@@ -0,0 +1,47 @@
+/* Copyright (C) 2013-2014 Michal Brzozowski (rusolis@poczta.fm)
+
+   This file is part of KeeperRL.
+
+   KeeperRL is free software; you can redistribute it and/or modify it under the terms of the
+   GNU General Public License as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   KeeperRL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+   even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with this program.
+   If not, see http://www.gnu.org/licenses/ . */
+
+#pragma once
+
+#include "util.h"
+#include "movement_type.h"
+#include "sectors.h"
+
+// Sectors of all movement types on a level. Movement types that have identical connectivity share one Sectors
+// object. When a square change affects them differently, the object is copied and the group is split.
+class SharedSectors {
+  public:
+  // Returns nullptr if the movement type wasn't added.
+  Sectors* getMaybe(const MovementType&) const;
+  // Shares the Sectors of another movement type if it has the same navigable squares, otherwise creates new
+  // Sectors with the extra connections of the existing ones.
+  Sectors& add(const MovementType&, const Table<bool>& navigable);
+  void erase(const MovementType&);
+  vector<MovementType> getMovementTypes() const;
+  vector<Sectors*> getDistinct() const;
+  // Updates a square that may have changed for some movement types. Returns the movement types whose
+  // Sectors changed.
+  vector<MovementType> update(Vec2, function<bool(const MovementType&)> canNavigate);
+
+  struct Usage {
+    int movementTypes;
+    int distinctSectors;
+    int memory;
+  };
+  Usage getUsage() const;
+
+  private:
+  HashMap<MovementType, shared_ptr<Sectors>> sectors;
+};
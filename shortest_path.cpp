@@ -21,6 +21,7 @@
 #include "lasting_effect.h"
 #include "furniture.h"
 #include "furniture_usage.h"
+#include "flow_field.h"
 
 SERIALIZE_DEF(ShortestPath, path, target, bounds, reversed)
 SERIALIZATION_CONSTRUCTOR_IMPL(ShortestPath)
@@ -53,8 +54,9 @@ class DistanceTable {
   int counter = 1;
 };
 
-static DistanceTable distanceTable(Level::getMaxBounds());
-static DirtyTable<double> navigationCostCache(Level::getMaxBounds(), 0);
+// Models can be updated on several threads at once, so each thread searches with its own tables.
+static thread_local DistanceTable distanceTable(Level::getMaxBounds());
+static thread_local DirtyTable<double> navigationCostCache(Level::getMaxBounds(), 0);
 
 template <typename Fun>
 static auto getCached(Fun fun) {
@@ -97,6 +99,10 @@ ShortestPath::ShortestPath(Rectangle area, function<double (Vec2)> entryFun, fun
 {
 }
 
+ShortestPath::ShortestPath(Rectangle area, vector<Vec2> p) : path(std::move(p)), target(path[0]), bounds(area),
+    reversed(false) {
+}
+
 struct QueueElem {
   Vec2 pos;
   double value;
@@ -224,6 +230,12 @@ bool ShortestPath::isReversed() const {
   return reversed;
 }
 
+void ShortestPath::splice(int index, const vector<Vec2>& newStart) {
+  CHECK(path[index] == newStart[0]);
+  path.resize(index);
+  append(path, newStart);
+}
+
 const vector<Vec2>& ShortestPath::getPath() const {
   return path;
 }
@@ -253,22 +265,63 @@ Vec2 ShortestPath::getTarget() const {
   return target;
 }
 
-ShortestPath LevelShortestPath::makeShortestPath(Position from, MovementType movementType, Position to, double mult) {
+// Paths between squares at least this far apart are first planned on the level's PathClusters.
+const int hierarchicalMinDistance = 3 * PathClusters::clusterSize;
+
+template <typename EntryFun, typename DirectionsFun>
+static optional<ShortestPath> makeHierarchicalPath(PathClusters& clusters, const Sectors& sectors, Rectangle bounds,
+    Vec2 from, Vec2 to, EntryFun entryFun, DirectionsFun directionsFun) {
   PROFILE;
-  Level* level = from.getLevel();
-  Rectangle bounds = level->getBounds();
-  CHECK(to.isSameLevel(from));
+  auto waypoints = clusters.getWaypoints(sectors, from, to);
+  if (!waypoints)
+    return none;
+  vector<Vec2> path {from};
+  for (int i : Range(1, waypoints->size())) {
+    Vec2 segmentFrom = (*waypoints)[i - 1];
+    Vec2 segmentTo = (*waypoints)[i];
+    auto area = clusters.getClusterBounds(segmentFrom);
+    if (!segmentTo.inRectangle(area)) {
+      path.push_back(segmentTo);
+      continue;
+    }
+    if (segmentFrom == segmentTo)
+      continue;
+    auto lengthFun = [segmentFrom](Vec2 v)->double { return segmentFrom.dist8(v); };
+    ShortestPath segment(ShortestPath::TemplateConstr{}, area, entryFun, lengthFun, directionsFun, segmentTo,
+        segmentFrom);
+    auto& segmentPath = segment.getPath();
+    if (segmentPath.empty() || segmentPath.back() != segmentFrom)
+      return none;
+    for (int j = segmentPath.size() - 2; j >= 0; --j)
+      path.push_back(segmentPath[j]);
+  }
+  return ShortestPath(bounds, path.reverse());
+}
+
+optional<ShortestPath> ShortestPath::makeHierarchical(PathClusters& clusters, const Sectors& sectors, Rectangle area,
+    function<double(Vec2)> entryFun, function<vector<Vec2>(Vec2)> directions, Vec2 target, Vec2 from) {
+  return makeHierarchicalPath(clusters, sectors, area, from, target, entryFun, directions);
+}
+
+static MovementType getOnlyMovement(const MovementType& movementType) {
+  return copyOf(movementType).setCanBuildBridge(false).setDestroyActions({});
+}
+
+static auto getNavigationCostFun(Level* level, const MovementType& movementType, bool includeCreatures = true) {
   auto& sectors = level->getSectors(movementType);
-  auto& movementSectors = level->getSectors(copyOf(movementType).setCanBuildBridge(false).setDestroyActions({}));
-  auto entryFun = [=, &sectors, &movementSectors, fromCoord = from.getCoord()](Vec2 v) {
+  auto& movementSectors = level->getSectors(getOnlyMovement(movementType));
+  auto& navigationCosts = level->getNavigationCosts(movementType);
+  return [=, &sectors, &movementSectors, &navigationCosts](Vec2 v) {
     PROFILE_BLOCK("entry fun");
-    if (fromCoord == v)
-      return 1.0;
     if (!sectors.contains(v))
       return ShortestPath::infinity;
-    return Position(v, level, Position::IsValid{}).getNavigationCost(movementType, movementSectors);
+    return Position(v, level, Position::IsValid{}).getNavigationCost(movementType, movementSectors, navigationCosts,
+        includeCreatures);
   };
-  auto directionsFun = [=] (Vec2 v) {
+}
+
+static auto getDirectionsFun(Level* level) {
+  return [=] (Vec2 v) {
     Position pos(v, level);
     vector<Vec2> ret = Vec2::directions8();
     if (auto f = pos.getFurniture(FurnitureLayer::MIDDLE))
@@ -280,9 +333,42 @@ ShortestPath LevelShortestPath::makeShortestPath(Position from, MovementType mov
                 ret.push_back(otherPos->getCoord() - v);
     return ret;
   };
+}
+
+ShortestPath LevelShortestPath::makeShortestPath(Position from, MovementType movementType, Position to, double mult) {
+  PROFILE;
+  Level* level = from.getLevel();
+  Rectangle bounds = level->getBounds();
+  CHECK(to.isSameLevel(from));
+  auto onlyMovement = getOnlyMovement(movementType);
+  auto navigationCost = getNavigationCostFun(level, movementType);
+  auto entryFun = [=, fromCoord = from.getCoord()](Vec2 v) {
+    if (fromCoord == v)
+      return 1.0;
+    return navigationCost(v);
+  };
+  auto directionsFun = getDirectionsFun(level);
   CHECK(to.getCoord().inRectangle(level->getBounds()));
   CHECK(from.getCoord().inRectangle(level->getBounds()));
   if (mult == 0) {
+    // The shared field ignores creatures, because they move without changing the generations. They are only
+    // avoided when following it.
+    auto staticCost = getNavigationCostFun(level, movementType, false);
+    auto buildFlowField = [&] {
+      navigationCostCache.clear();
+      return FlowField(bounds, to.getCoord(), getCached(staticCost), directionsFun);
+    };
+    if (auto flowField = level->getFlowFields().get({to.getCoord(), movementType},
+        getNavigationGeneration(level, movementType), buildFlowField)) {
+      auto path = flowField->getPath(from.getCoord(), directionsFun,
+          [&](Vec2 v) { return navigationCost(v) - staticCost(v); });
+      if (!path.empty())
+        return ShortestPath(bounds, std::move(path));
+    }
+    if (from.getCoord().dist8(to.getCoord()) >= hierarchicalMinDistance)
+      if (auto path = makeHierarchicalPath(level->getPathClusters(onlyMovement), level->getSectors(onlyMovement),
+          bounds, from.getCoord(), to.getCoord(), entryFun, directionsFun))
+        return std::move(*path);
     auto dist1 = from.getDistanceToNearestPortal().value_or(10000);
     auto lengthFun = [level, from = from.getCoord(), dist1](Vec2 to) {
       PROFILE_BLOCK("length fun");
@@ -312,6 +398,78 @@ LevelShortestPath::LevelShortestPath(Position from, MovementType type, Position
     : path(makeShortestPath(from, type, to, mult)), level(to.getLevel()) {
 }
 
+// Detours are searched towards the square this many moves further along the path, within this margin around it.
+const int repairDistance = 6;
+const int repairMargin = 4;
+
+bool LevelShortestPath::repair(Position from, const MovementType& movementType, Position blocked) {
+  PROFILE;
+  if (!isReachable(from) || isReversed() || !blocked.isSameLevel(from))
+    return false;
+  auto& oldPath = path.getPath();
+  int fromIndex = oldPath.back() == from.getCoord() ? oldPath.size() - 1 : oldPath.size() - 2;
+  int rejoinIndex = max(0, fromIndex - repairDistance);
+  Vec2 rejoin = oldPath[rejoinIndex];
+  if (rejoin == blocked.getCoord())
+    return false;
+  auto area = Rectangle::boundingBox({from.getCoord(), rejoin}).minusMargin(-repairMargin)
+      .intersection(level->getBounds());
+  auto navigationCost = getNavigationCostFun(level, movementType);
+  auto entryFun = [=, fromCoord = from.getCoord(), blockedCoord = blocked.getCoord()](Vec2 v) {
+    if (v == blockedCoord)
+      return ShortestPath::infinity;
+    if (fromCoord == v)
+      return 1.0;
+    return navigationCost(v);
+  };
+  auto lengthFun = [from = from.getCoord()](Vec2 v)->double { return from.dist8(v); };
+  ShortestPath detour(ShortestPath::TemplateConstr{}, area, entryFun, lengthFun, getDirectionsFun(level), rejoin,
+      from.getCoord());
+  auto& detourPath = detour.getPath();
+  if (detourPath.empty() || detourPath.back() != from.getCoord())
+    return false;
+  // A detour much longer than the part of the path it replaces means that the way is blocked for good,
+  // and the whole path should be searched again.
+  if (detourPath.size() > 2 * (fromIndex - rejoinIndex + 1))
+    return false;
+  path.splice(rejoinIndex, detourPath);
+  return true;
+}
+
+LevelShortestPath::LevelShortestPath(ShortestPath path, Level* level) : path(std::move(path)), level(level) {
+}
+
+Table<float> LevelShortestPath::getNavigationCosts(Level* level, const MovementType& movementType) {
+  PROFILE;
+  auto navigationCost = getNavigationCostFun(level, movementType, false);
+  Table<float> ret(level->getBounds());
+  for (Vec2 v : level->getBounds())
+    ret[v] = navigationCost(v);
+  return ret;
+}
+
+LevelShortestPath::NavigationGeneration LevelShortestPath::getNavigationGeneration(Level* level,
+    const MovementType& movementType) {
+  return NavigationGeneration(level->getSectors(movementType).getGeneration(),
+      level->getSectors(getOnlyMovement(movementType)).getGeneration(),
+      level->getNavigationCosts(movementType).getGeneration());
+}
+
+vector<pair<Vec2, float>> LevelShortestPath::getCreatureNavigationCosts(Level* level,
+    const MovementType& movementType) {
+  PROFILE;
+  auto navigationCost = getNavigationCostFun(level, movementType);
+  auto staticCost = getNavigationCostFun(level, movementType, false);
+  vector<pair<Vec2, float>> ret;
+  for (auto c : level->getAllCreatures()) {
+    Vec2 v = c->getPosition().getCoord();
+    float cost = navigationCost(v);
+    if (cost != float(staticCost(v)))
+      ret.push_back(make_pair(v, cost));
+  }
+  return ret;
+}
+
 Level* LevelShortestPath::getLevel() const {
   return level;
 }
@@ -347,84 +505,169 @@ bool LevelShortestPath::isReversed() const {
   return path.isReversed();
 }
 
-Dijkstra::Dijkstra(Rectangle bounds, vector<Vec2> from, int maxDist, function<double(Vec2)> entryFun,
-      vector<Vec2> directions) {
-  distanceTable.clear();
-  auto comparator = [](Vec2 pos1, Vec2 pos2) {
-      double diff = distanceTable.getDistance(pos1) - distanceTable.getDistance(pos2);
-      if (diff > 0 || (diff == 0 && pos1 < pos2))
-        return 1;
-      else
-        return 0;};
-  priority_queue<Vec2, vector<Vec2>, decltype(comparator)> q(comparator) ;
-  for (auto& v : from) {
-    distanceTable.setDistance(v, 0);
-    q.push(v);
+// Priority queue for searches in which no pushed key is smaller than the last popped one. Elements are kept in buckets
+// by the highest bit in which their key differs from the last popped key. Non-negative doubles compare like
+// their bit patterns, so any such distances can be used as keys.
+class RadixHeap {
+  public:
+  void push(double key, Vec2 v) {
+    auto bits = toBits(key);
+    CHECK(bits >= last);
+    buckets[getBucket(bits)].push_back(make_pair(bits, v));
+    ++size;
+  }
+
+  bool empty() const {
+    return size == 0;
+  }
+
+  pair<double, Vec2> pop() {
+    CHECK(!empty());
+    if (buckets[0].empty()) {
+      int index = 1;
+      while (buckets[index].empty())
+        ++index;
+      auto& bucket = buckets[index];
+      last = bucket[0].first;
+      for (auto& elem : bucket)
+        last = min(last, elem.first);
+      for (auto& elem : bucket)
+        buckets[getBucket(elem.first)].push_back(elem);
+      bucket.clear();
+    }
+    auto elem = buckets[0].back();
+    buckets[0].pop_back();
+    --size;
+    return make_pair(fromBits(elem.first), elem.second);
+  }
+
+  void clear() {
+    for (auto& bucket : buckets)
+      bucket.clear();
+    size = 0;
+    last = 0;
+  }
+
+  private:
+  static uint64_t toBits(double key) {
+    CHECK(key >= 0);
+    uint64_t ret;
+    memcpy(&ret, &key, sizeof(key));
+    return ret;
+  }
+
+  static double fromBits(uint64_t bits) {
+    double ret;
+    memcpy(&ret, &bits, sizeof(ret));
+    return ret;
+  }
+
+  int getBucket(uint64_t bits) const {
+    return bits == last ? 0 : 64 - __builtin_clzll(bits ^ last);
   }
+
+  std::array<vector<pair<uint64_t, Vec2>>, 65> buckets;
+  int size = 0;
+  uint64_t last = 0;
+};
+
+class SearchTable {
+  public:
+  DistanceTable distances = DistanceTable(Level::getMaxBounds());
+  vector<Vec2> reached;
+  RadixHeap queue;
+};
+
+// Models can be updated on several threads. The tables are freed when their thread exits.
+static thread_local vector<unique_ptr<SearchTable>> searchTablePool;
+
+static PSearchTable getSearchTable() {
+  SearchTable* ret;
+  if (searchTablePool.empty())
+    ret = new SearchTable();
+  else {
+    ret = searchTablePool.back().release();
+    searchTablePool.pop_back();
+  }
+  ret->distances.clear();
+  ret->reached.clear();
+  ret->queue.clear();
+  return PSearchTable(ret, [](SearchTable* table) { searchTablePool.push_back(unique_ptr<SearchTable>(table)); });
+}
+
+Dijkstra::Dijkstra(Rectangle bounds, vector<Vec2> from, int maxDist, function<double(Vec2)> entryFun,
+      vector<Vec2> directions) : bounds(bounds), table(getSearchTable()) {
+  PROFILE;
+  CHECK(Level::getMaxBounds().contains(bounds));
+  auto& distances = table->distances;
+  auto& q = table->queue;
+  for (auto& v : from)
+    if (distances.getDistance(v) > 0) {
+      distances.setDistance(v, 0);
+      q.push(0, v);
+    }
   while (!q.empty()) {
-    Vec2 pos = q.top();
-    double cdist = distanceTable.getDistance(pos);
-    if (cdist > maxDist)
-      return;
-    q.pop();
-    CHECK(!reachable.count(pos));
-    reachable[pos] = cdist;
+    auto elem = q.pop();
+    Vec2 pos = elem.second;
+    double cdist = elem.first;
+    if (cdist > distances.getDistance(pos))
+      continue;
+    table->reached.push_back(pos);
     for (Vec2 dir : directions) {
       Vec2 next = pos + dir;
       if (next.inRectangle(bounds)) {
-        double ndist = distanceTable.getDistance(next);
+        double ndist = distances.getDistance(next);
         if (cdist < ndist) {
           double dist = cdist + entryFun(next);
           CHECK(dist > cdist) << "Entry fun non positive " << dist - cdist;
           if (dist < ndist && dist <= maxDist) {
-            distanceTable.setDistance(next, dist);
-            q.push(next);
+            distances.setDistance(next, dist);
+            q.push(dist, next);
           }
         }
       }
     }
   }
-
 }
 
 bool Dijkstra::isReachable(Vec2 pos) const {
-  return reachable.count(pos);
+  return pos.inRectangle(bounds) && table->distances.getDistance(pos) < ShortestPath::infinity;
 }
 
 double Dijkstra::getDist(Vec2 v) const {
-  return reachable.at(v);
+  CHECK(isReachable(v));
+  return table->distances.getDistance(v);
 }
 
-const Dijkstra::DistanceMap& Dijkstra::getAllReachable() const {
-  return reachable;
+const vector<Vec2>& Dijkstra::getAllReachable() const {
+  return table->reached;
 }
 
-BfSearch::BfSearch(Rectangle bounds, Vec2 from, function<bool(Vec2)> entryFun, vector<Vec2> directions) {
-  distanceTable.clear();
-  queue<Vec2> q;
-  distanceTable.setDistance(from, 0);
-  q.push(from);
-  while (!q.empty()) {
-    Vec2 pos = q.front();
-    q.pop();
-    CHECK(!reachable.count(pos));
-    reachable.insert(pos);
+BfSearch::BfSearch(Rectangle bounds, Vec2 from, function<bool(Vec2)> entryFun, vector<Vec2> directions)
+    : bounds(bounds), table(getSearchTable()) {
+  PROFILE;
+  CHECK(Level::getMaxBounds().contains(bounds));
+  auto& distances = table->distances;
+  auto& reached = table->reached;
+  distances.setDistance(from, 0);
+  reached.push_back(from);
+  // The reached cells double as the queue.
+  for (int i = 0; i < reached.size(); ++i) {
+    Vec2 pos = reached[i];
     for (Vec2 dir : directions) {
       Vec2 next = pos + dir;
-      if (next.inRectangle(bounds) && distanceTable.getDistance(next) == ShortestPath::infinity && entryFun(next)) {
-        distanceTable.setDistance(next, 0);
-        q.push(next);
+      if (next.inRectangle(bounds) && distances.getDistance(next) == ShortestPath::infinity && entryFun(next)) {
+        distances.setDistance(next, distances.getDistance(pos) + 1);
+        reached.push_back(next);
       }
     }
   }
-
 }
 
 bool BfSearch::isReachable(Vec2 pos) const {
-  return reachable.count(pos);
+  return pos.inRectangle(bounds) && table->distances.getDistance(pos) < ShortestPath::infinity;
 }
 
-const BfSearch::ReachableSet& BfSearch::getAllReachable() const {
-  return reachable;
+const vector<Vec2>& BfSearch::getAllReachable() const {
+  return table->reached;
 }
-
@@ -22,6 +22,8 @@
 
 class Creature;
 class Level;
+class PathClusters;
+class Sectors;
 
 class ShortestPath {
   public:
@@ -47,12 +49,20 @@ class ShortestPath {
       Vec2 target,
       Vec2 from,
       double mult = 0);
+  // Wraps a path found elsewhere, ordered from the target to the start like getPath().
+  ShortestPath(Rectangle area, vector<Vec2> path);
+  // Plans the path on the clusters first and then searches only the clusters it crosses.
+  // Returns none if the clusters don't connect the squares.
+  static optional<ShortestPath> makeHierarchical(PathClusters&, const Sectors&, Rectangle area,
+      function<double(Vec2)> entryFun, function<vector<Vec2>(Vec2)> directions, Vec2 target, Vec2 from);
   bool isReachable(Vec2 pos) const;
   Vec2 getNextMove(Vec2 pos);
   optional<Vec2> getNextNextMove(Vec2 pos);
   Vec2 getTarget() const;
   bool isReversed() const;
   const vector<Vec2>& getPath() const;
+  // Replaces the part of the path from the given index to the start with another one, ordered like getPath().
+  void splice(int index, const vector<Vec2>& newStart);
 
   static const double infinity;
 
@@ -75,6 +85,7 @@ class LevelShortestPath {
   public:
   LevelShortestPath(const Creature* creature, Position target, double mult = 0);
   LevelShortestPath(Position from, MovementType, Position target, double mult = 0);
+  LevelShortestPath(ShortestPath, Level*);
   bool isReachable(Position) const;
   Position getNextMove(Position);
   optional<Position> getNextNextMove(Position);
@@ -82,6 +93,16 @@ class LevelShortestPath {
   bool isReversed() const;
   Level* getLevel() const;
   vector<Position> getPath() const;
+  // Replaces the next few moves with a detour around the blocked square, searching only a small area.
+  // Returns false if there is no short detour, in which case the whole path should be searched again.
+  bool repair(Position from, const MovementType&, Position blocked);
+  // Costs of entering each square of the level, as used by the search, but ignoring creatures.
+  static Table<float> getNavigationCosts(Level*, const MovementType&);
+  using NavigationGeneration = tuple<long long, long long, int>;
+  // Changes whenever getNavigationCosts() may give a different result.
+  static NavigationGeneration getNavigationGeneration(Level*, const MovementType&);
+  // The squares where creatures make the cost higher than getNavigationCosts() says, with their actual costs.
+  static vector<pair<Vec2, float>> getCreatureNavigationCosts(Level*, const MovementType&);
 
   static const double infinity;
 
@@ -93,27 +114,33 @@ class LevelShortestPath {
   Level* SERIAL(level) = nullptr;
 };
 
+// Level-sized tables reused by searches, so that a search doesn't allocate or clear anything once the pool is warm.
+class SearchTable;
+using PSearchTable = unique_ptr<SearchTable, void(*)(SearchTable*)>;
+
 class Dijkstra {
   public:
   Dijkstra(Rectangle bounds, vector<Vec2> from, int maxDist, function<double(Vec2)> entryFun,
       vector<Vec2> directions = Vec2::directions8());
   bool isReachable(Vec2) const;
   double getDist(Vec2) const;
-  using DistanceMap = HashMap<Vec2, double>;
-  const DistanceMap& getAllReachable() const;
+  // In order of increasing distance.
+  const vector<Vec2>& getAllReachable() const;
 
   private:
-  DistanceMap reachable;
+  Rectangle bounds;
+  PSearchTable table;
 };
 
 class BfSearch {
   public:
   BfSearch(Rectangle bounds, Vec2 from, function<bool(Vec2)> entryFun, vector<Vec2> directions = Vec2::directions8());
   bool isReachable(Vec2) const;
-  using ReachableSet = HashSet<Vec2>;
-  const ReachableSet& getAllReachable() const;
+  // In order of increasing number of moves.
+  const vector<Vec2>& getAllReachable() const;
 
   private:
-  ReachableSet reachable;
+  Rectangle bounds;
+  PSearchTable table;
 };
 
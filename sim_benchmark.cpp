@@ -0,0 +1,44 @@
+#include "stdafx.h"
+#include "sim_benchmark.h"
+
+atomic<bool> SimBenchmark::enabled { false };
+atomic<int64_t> SimBenchmark::creatureMoves { 0 };
+array<atomic<int64_t>, EnumInfo<SimTimerId>::size> SimBenchmark::totals {};
+
+void SimBenchmark::start() {
+  for (auto& elem : totals)
+    elem = 0;
+  creatureMoves = 0;
+  enabled = true;
+}
+
+bool SimBenchmark::isEnabled() {
+  return enabled.load(std::memory_order_relaxed);
+}
+
+void SimBenchmark::addTime(SimTimerId id, steady_clock::duration time) {
+  totals[int(id)] += std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+}
+
+void SimBenchmark::addCreatureMove() {
+  if (isEnabled())
+    ++creatureMoves;
+}
+
+int64_t SimBenchmark::getNumCreatureMoves() {
+  return creatureMoves;
+}
+
+steady_clock::duration SimBenchmark::getTotal(SimTimerId id) {
+  return std::chrono::duration_cast<steady_clock::duration>(std::chrono::nanoseconds(totals[int(id)].load()));
+}
+
+SimTimer::SimTimer(SimTimerId id) : id(id) {
+  if (SimBenchmark::isEnabled())
+    startTime = steady_clock::now();
+}
+
+SimTimer::~SimTimer() {
+  if (startTime)
+    SimBenchmark::addTime(id, steady_clock::now() - *startTime);
+}
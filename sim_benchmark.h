@@ -0,0 +1,39 @@
+#pragma once
+
+#include "util.h"
+
+RICH_ENUM(SimTimerId,
+  MODEL_TICK,
+  LEVEL_TICK,
+  COLLECTIVE_TICK,
+  MONSTER_AI_MOVE
+);
+
+// Collects per-subsystem wall-clock totals for the headless simulation benchmark (--bench_sim).
+// When the benchmark isn't running the timers cost a single flag check.
+class SimBenchmark {
+  public:
+  static void start();
+  static bool isEnabled();
+  static void addTime(SimTimerId, steady_clock::duration);
+  static void addCreatureMove();
+  static int64_t getNumCreatureMoves();
+  static steady_clock::duration getTotal(SimTimerId);
+
+  private:
+  static atomic<bool> enabled;
+  static atomic<int64_t> creatureMoves;
+  static array<atomic<int64_t>, EnumInfo<SimTimerId>::size> totals;
+};
+
+class SimTimer {
+  public:
+  SimTimer(SimTimerId);
+  ~SimTimer();
+
+  private:
+  SimTimerId id;
+  optional<steady_clock::time_point> startTime;
+};
+
+#define SIM_TIMER(Id) SimTimer simTimer(SimTimerId::Id)
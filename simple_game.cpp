@@ -12,7 +12,7 @@
 #include "main_loop.h"
 
 static PCreature getCreature(ContentFactory* factory, CreatureId id) {
-  return factory->getCreatures().fromId(id, TribeId::getDarkKeeper());
+  return factory->getCreatures().fromId(Random, id, TribeId::getDarkKeeper());
 }
 
 void SimpleGame::addResourcesForLevel(int level) {
@@ -21,7 +21,7 @@ void SimpleGame::addResourcesForLevel(int level) {
     if (auto drop = factory->furniture.getData(count.type).getItemDrop()) {
       for (int patch : Range(count.countFurther + count.countStartingPos))
         for (int i : Range(Random.get(count.size)))
-          for (auto& item : drop->random(factory, 0))
+          for (auto& item : drop->random(Random, factory, 0))
             ++resources[*item->getResourceId()];
     }
 }
@@ -113,7 +113,7 @@ void SimpleGame::update() {
   std::cout << "Immigrants: ";
   for (int i : All(immigrants))
     if (meetsRequirements(immigrants[i])) {
-      auto c = getCreature(factory, immigrants[i].getId(0));
+      auto c = getCreature(factory, immigrants[i].getId(Random, 0));
       std::cout << i << ". " << c->getName().bare() << "(" << c->getBestAttackValue() << "), ";
     }
   std::cout << "\n";
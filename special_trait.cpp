@@ -47,7 +47,7 @@ void applySpecialTrait(GlobalTime globalTime, SpecialTrait trait, Creature* c, c
       [&] (const ExtraIntrinsicAttack& a) {
         auto attack = IntrinsicAttack(a.item);
         attack.isExtraAttack = true;
-        attack.initializeItem(factory);
+        attack.initializeItem(c->getRandom(), factory);
         c->getBody().addIntrinsicAttack(a.part, std::move(attack));
       },
       [&] (CompanionInfo type) {
@@ -59,13 +59,13 @@ void applySpecialTrait(GlobalTime globalTime, SpecialTrait trait, Creature* c, c
   );
 }
 
-SpecialTrait transformBeforeApplying(SpecialTrait trait) {
+SpecialTrait transformBeforeApplying(RandomGen& random, SpecialTrait trait) {
   return trait.visit<SpecialTrait>(
       [&] (const auto&) {
         return trait;
       },
       [&] (const OneOfTraits& t) {
-        return Random.choose(t.traits);
+        return random.choose(t.traits);
       }
   );
 }
@@ -71,7 +71,7 @@ inline
 
 
 extern void applySpecialTrait(GlobalTime, SpecialTrait, Creature*, const ContentFactory*);
-extern SpecialTrait transformBeforeApplying(SpecialTrait);
+extern SpecialTrait transformBeforeApplying(RandomGen&, SpecialTrait);
 
 struct SpecialTraitInfo {
   double SERIAL(prob);
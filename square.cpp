@@ -86,13 +86,16 @@ void Square::tick(Position pos) {
     inventory->tick(pos, false);
     if (!pos.canEnterEmpty(MovementType(MovementTrait::WALK).setForced()) ||
         (creature && creature->isAffected(LastingEffect::IMMOBILE)))
-      for (auto neighbor : pos.neighbors8(Random))
+      for (auto neighbor : pos.neighbors8(pos.getRandom()))
         if (neighbor.canEnterEmpty({MovementTrait::WALK})) {
           neighbor.dropItems(pos.removeItems(pos.getItems()));
           break;
         }
   }
-  tileGas->tick(pos);
+}
+
+bool Square::isTicking() const {
+  return !inventory->isEmpty();
 }
 
 bool Square::itemLands(vector<Item*> item, const Attack& attack) const {
@@ -110,7 +113,7 @@ void Square::onItemLands(Position pos, vector<PItem> item, const Attack& attack)
   if (creature) {
     auto targetCreature = creature;
     if (auto steed = creature->getSteed())
-      if (Random.roll(2))
+      if (pos.getRandom().roll(2))
         targetCreature = steed;
     item[0]->onHitCreature(targetCreature, attack, item.size());
     if (!item[0]->isDiscarded())
@@ -122,24 +125,16 @@ void Square::onItemLands(Position pos, vector<PItem> item, const Attack& attack)
     pos.dropItems(std::move(item));
 }
 
-void Square::addGas(Position pos, TileGasType type, double amount) {
-  setDirty(pos);
-  if (pos.canSeeThruIgnoringGas(VisionId::NORMAL)) {
-    tileGas->addAmount(pos, type, amount);
-    pos.getLevel()->addTickingSquare(pos.getCoord());
-  }
-}
-
 void Square::addPermanentGas(TileGasType type, double amount) {
   tileGas->addPermanentAmount(type, amount);
 }
 
-double Square::getGasAmount(TileGasType type) const {
-  return tileGas->getAmount(type);
+bool Square::hasGas() const {
+  return !tileGas->isEmpty();
 }
 
-bool Square::hasSunlightBlockingGasAmount() const {
-  return tileGas->hasSunlightBlockingAmount();
+void Square::moveGasTo(GasGrid& grid, Vec2 pos) {
+  tileGas->moveTo(grid, pos);
 }
 
 void Square::getViewIndex(const ContentFactory* factory, ViewIndex& ret, const Creature* viewer) const {
@@ -159,12 +154,6 @@ void Square::getViewIndex(const ContentFactory* factory, ViewIndex& ret, const C
       }
     ret.insert(std::move(obj));
   }
-  CHECK(ret.getGasAmounts().empty());
-  for (auto& type : factory->tileGasTypes) {
-    auto amount = tileGas->getAmount(type.first);
-    if (amount > 0)
-      ret.addGasAmount(type.second.name, type.second.color.transparency(amount * 255));
-  }
   *viewIndex = ret;
 }
 
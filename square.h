@@ -24,6 +24,7 @@ class Creature;
 class Item;
 class ProgressMeter;
 class TileGas;
+class GasGrid;
 class Inventory;
 class Position;
 class ViewIndex;
@@ -42,10 +43,10 @@ class Square {
   /** Returns the entry point details. Returns none if square is not entry point. See setLandingLink().*/
   optional<StairKey> getLandingLink() const;
 
-  void addGas(Position, TileGasType, double amount);
+  /** Used only during level generation. Level::getGas() holds gas once the level is created.*/
   void addPermanentGas(TileGasType, double amount);
-  double getGasAmount(TileGasType) const;
-  bool hasSunlightBlockingGasAmount() const;
+  bool hasGas() const;
+  void moveGasTo(GasGrid&, Vec2);
 
   /** Sets the level this square is on.*/
   void onAddedToLevel(Position) const;
@@ -70,8 +71,10 @@ class Square {
   //@}
 
   /** Triggers all time-dependent processes like burning. Calls tick() for items if present.
-      For this method to be called, the square coordinates must be added with Level::addTickingSquare().*/
+      For this method to be called, the square coordinates must be added with Level::addTickingSquare().
+      The level stops ticking the square once isTicking() returns false.*/
   void tick(Position);
+  bool isTicking() const;
 
   void getViewIndex(const ContentFactory*, ViewIndex&, const Creature* viewer) const;
 
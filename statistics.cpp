@@ -18,7 +18,11 @@
 
 SERIALIZE_DEF(Statistics, count)
 
+// Statistics can be added from several model update threads at once.
+static std::mutex countMutex;
+
 void Statistics::add(StatId id) {
+  std::unique_lock<std::mutex> lock(countMutex);
   ++count[id];
 }
 
@@ -306,7 +306,7 @@ static optional<Position> chooseRandomClose(const Creature* c, const PositionCon
     if (canNavigate(v) && v.dist8(start).value_or(10000) <= minD + margin)
       close.push_back(v);
   if (!close.empty())
-    return Random.choose(close);
+    return c->getRandom().choose(close);
   else
     return none;
 }
@@ -473,7 +473,7 @@ class ArcheryRange : public Task {
   }
 
   virtual MoveInfo getMove(Creature* c) override {
-    if (Random.roll(50))
+    if (c->getRandom().roll(50))
       shootInfo = none;
     if (!shootInfo)
       shootInfo = getShootInfo(c);
@@ -483,7 +483,7 @@ class ArcheryRange : public Task {
     }
     if (c->getPosition() != shootInfo->pos)
       return c->moveTowards(shootInfo->pos, NavigationFlags().requireStepOnTile());
-    if (Random.roll(3))
+    if (c->getRandom().roll(3))
       return c->wait();
     for (auto pos = shootInfo->pos; pos != shootInfo->target; pos = pos.plus(shootInfo->dir)) {
       if (auto other = pos.plus(shootInfo->dir).getCreature())
@@ -521,7 +521,7 @@ class ArcheryRange : public Task {
 
   optional<ShootInfo> getShootInfo(const Creature* c) const {
     auto getDir = [&](Position target) -> optional<ShootInfo> {
-      for (Vec2 dir : Vec2::directions4(Random)) {
+      for (Vec2 dir : Vec2::directions4(c->getRandom())) {
         bool ok = true;
         for (int i : Range(Task::archeryRangeDistance))
           if (target.minus(dir * (i + 1)).stopsProjectiles(c->getVision().getId())) {
@@ -535,11 +535,11 @@ class ArcheryRange : public Task {
       return none;
     };
     HashMap<Position, vector<ShootInfo>> shootPositions;
-    for (auto pos : Random.permutation(targets))
+    for (auto pos : c->getRandom().permutation(targets))
       if (auto dir = getDir(pos))
         shootPositions[dir->pos].push_back(*dir);
     if (auto chosen = chooseRandomClose(c, getKeys(shootPositions), Task::RANDOM_CLOSE, true))
-      return Random.choose(shootPositions.at(*chosen));
+      return c->getRandom().choose(shootPositions.at(*chosen));
     return none;
   }
 };
@@ -711,14 +711,14 @@ class Explore : public Task {
   Explore(Position pos) : position(pos) {}
 
   virtual MoveInfo getMove(Creature* c) override {
-    if (!Random.roll(3))
+    if (!c->getRandom().roll(3))
       return NoMove;
     if (auto action = c->moveTowards(position))
       return action.append([=](Creature* c) {
           if (c->getPosition().dist8(position).value_or(5) < 5)
             setDone();
       });
-    if (Random.roll(3))
+    if (c->getRandom().roll(3))
       setDone();
     return NoMove;
   }
@@ -829,7 +829,7 @@ PTask Task::stealFrom(Collective* collective, CollectiveResourceId id) {
         tasks.push_back(pickUpItem(pos, gold));
     }
   if (!tasks.empty()) {
-    Random.shuffle(tasks.begin(), tasks.end());
+    collective->getRandom().shuffle(tasks.begin(), tasks.end());
     return chain(std::move(tasks));
   } else
     return PTask(nullptr);
@@ -841,7 +841,7 @@ class CampAndSpawnTask : public Task {
   public:
   CampAndSpawnTask(Collective* _target, CreatureList s, int numAtt)
     : target(_target), spawns(s),
-      campPos(Random.permutation(target->getTerritory().getStandardExtended())), numAttacks(numAtt) {}
+      campPos(_target->getRandom().permutation(target->getTerritory().getStandardExtended())), numAttacks(numAtt) {}
 
   void updateTeams() {
     for (auto member : copyOf(attackTeam))
@@ -870,12 +870,12 @@ class CampAndSpawnTask : public Task {
           setDone();
           return c->wait();
         }
-        attackCountdown = Random.get(30, 60);
+        attackCountdown = c->getRandom().get(30, 60);
       }
       if (*attackCountdown > 0)
         --*attackCountdown;
       else {
-        auto team = spawns.generate(Random, &c->getGame()->getContentFactory()->getCreatures(), c->getTribeId(),
+        auto team = spawns.generate(c->getRandom(), &c->getGame()->getContentFactory()->getCreatures(), c->getTribeId(),
             MonsterAIFactory::singleTask(Task::attackCreatures(target->getLeaders())));
         for (Creature* summon : Effect::summonCreatures(c->getPosition(), std::move(team)))
           attackTeam.push_back(summon);
@@ -995,8 +995,8 @@ class Copulate : public Task {
       return NoMove;
     }
     if (c->getPosition().dist8(target->getPosition()) == 1) {
-      if (Random.roll(2))
-        for (Vec2 v : Vec2::directions8(Random))
+      if (c->getRandom().roll(2))
+        for (Vec2 v : Vec2::directions8(c->getRandom()))
           if (v.dist8(c->getPosition().getDir(target->getPosition())) == 1)
             if (auto action = c->move(v))
               return action;
@@ -1086,7 +1086,7 @@ class Eat : public Task {
     if (!!position && !c->canNavigateTo(*position))
       position = none;
     if (!position) {
-      for (Position v : Random.permutation(positions))
+      for (Position v : c->getRandom().permutation(positions))
         if (!rejectedPosition.count(v) && c->canNavigateTo(v) && (!position ||
               position->dist8(c->getPosition()).value_or(10000) > v.dist8(c->getPosition()).value_or(10000)))
           position = v;
@@ -1102,7 +1102,7 @@ class Eat : public Task {
       return c->eat(chicken).append([=] (Creature* c) {
         setDone();
       });
-    for (Position pos : c->getPosition().neighbors8(Random)) {
+    for (Position pos : c->getPosition().neighbors8(c->getRandom())) {
       Item* chicken = getDeadChicken(pos);
       if (chicken)
         if (auto move = c->move(pos))
@@ -1203,7 +1203,7 @@ class Dance : public Task {
   virtual MoveInfo getMove(Creature* c) override {
     setDone();
     if (auto target = collective->getDancing().getTarget(c)) {
-      return c->moveTowards(*target).append([=] (Creature* c) { if (Random.roll(10)) c->addFX({FXName::MUSIC});});
+      return c->moveTowards(*target).append([=] (Creature* c) { if (c->getRandom().roll(10)) c->addFX({FXName::MUSIC});});
     }
     return NoMove;
   }
@@ -1232,19 +1232,19 @@ class StayIn : public Task {
   virtual MoveInfo getMove(Creature* c) override {
     PROFILE_BLOCK("StayIn::getMove");
     auto pos = c->getPosition();
-    if (Random.roll(15) && target.contains(pos)) {
+    if (c->getRandom().roll(15) && target.contains(pos)) {
       setDone();
-      if (Random.roll(15))
-        if (auto move = c->move(pos.plus(Vec2(Random.choose<Dir>()))))
+      if (c->getRandom().roll(15))
+        if (auto move = c->move(pos.plus(Vec2(c->getRandom().choose<Dir>()))))
           return move;
-      if (Random.roll(100))
-        if (auto move = c->moveTowards(Random.choose(target)))
+      if (c->getRandom().roll(100))
+        if (auto move = c->moveTowards(c->getRandom().choose(target)))
           return move;
       return c->wait();
     }
     if (!currentTarget)
       for (int i : Range(100)) {
-        currentTarget = Random.choose(target);
+        currentTarget = c->getRandom().choose(target);
         if (currentTarget->canEnter(c))
           break;
         else
@@ -1359,8 +1359,8 @@ class Follow : public Task {
     if (target && target != c && !target->isDead()) {
       Position targetPos = target->getPosition();
       if (targetPos.dist8(c->getPosition()).value_or(3) < 3) {
-        if (Random.roll(15))
-          if (auto move = c->move(c->getPosition().plus(Vec2(Random.choose<Dir>()))))
+        if (c->getRandom().roll(15))
+          if (auto move = c->move(c->getPosition().plus(Vec2(c->getRandom().choose<Dir>()))))
             return move;
         return NoMove;
       }
@@ -1755,7 +1755,7 @@ class Spider : public Task {
     if (!c->getPosition().getFurniture(FurnitureLayer::MIDDLE))
       c->getPosition().addFurniture(origin.getGame()->getContentFactory()->furniture.getFurniture(
           FurnitureType("SPIDER_WEB"), c->getTribeId()));
-    for (auto& pos : Random.permutation(webPositions))
+    for (auto& pos : c->getRandom().permutation(webPositions))
       if (auto victim = pos.getCreature())
         if (victim->isAffected(LastingEffect::ENTANGLED) && victim->isEnemy(c)) {
           attackPosition = pos;
@@ -1807,8 +1807,8 @@ class WithTeam : public Task {
       if (targetPos.dist8(c->getPosition()).value_or(11) < 10) {
         if (auto move = task->getMove(c))
           return move;
-        if (Random.roll(15))
-          if (auto move = c->move(c->getPosition().plus(Vec2(Random.choose<Dir>()))))
+        if (c->getRandom().roll(15))
+          if (auto move = c->move(c->getPosition().plus(Vec2(c->getRandom().choose<Dir>()))))
             return move;
         return NoMove;
       }
@@ -3,6 +3,7 @@
 #include "position.h"
 #include "movement_type.h"
 #include "position_map.h"
+#include "level.h"
 
 SERIALIZE_DEF(Territory, allSquares, allSquaresVec, centralPoint)
 
@@ -11,11 +12,17 @@ void Territory::clearCache() {
   extendedCache2.clear();
 }
 
+void Territory::setOwner(Collective* c) {
+  owner = c;
+}
+
 void Territory::insert(Position pos) {
   if (!allSquares.count(pos)) {
     allSquaresVec.push_back(pos);
     allSquares.insert(pos);
     clearCache();
+    if (owner)
+      pos.getLevel()->addTerritoryClaim(pos.getCoord(), owner);
   }
 }
 
@@ -23,6 +30,8 @@ void Territory::remove(Position pos) {
   allSquaresVec.removeElement(pos);
   allSquares.erase(pos);
   clearCache();
+  if (owner)
+    pos.getLevel()->removeTerritoryClaim(pos.getCoord(), owner);
 }
 
 void Territory::setCentralPoint(Position pos) {
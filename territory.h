@@ -5,6 +5,8 @@
 
 class Territory {
   public:
+  /** Claims inserted and removed from now on are reported to the level's territory table. */
+  void setOwner(Collective*);
   void insert(Position);
   void remove(Position);
   void setCentralPoint(Position);
@@ -29,6 +31,7 @@ class Territory {
   PositionSet SERIAL(allSquares);
   vector<Position> SERIAL(allSquaresVec);
   optional<Position> SERIAL(centralPoint);
+  Collective* owner = nullptr;
   mutable map<pair<int, int>, vector<Position>> extendedCache;
   mutable map<int, vector<Position>> extendedCache2;
 };
@@ -23,6 +23,7 @@
 #include "level_maker.h"
 #include "test.h"
 #include "sectors.h"
+#include "shared_sectors.h"
 #include "minion_equipment.h"
 #include "item_factory.h"
 #include "item_type.h"
@@ -48,6 +49,18 @@
 #include "biome_id.h"
 #include "item_types.h"
 #include "creature_attributes.h"
+#include "time_queue.h"
+#include "timing_wheel.h"
+#include "gas_grid.h"
+#include "path_clusters.h"
+#include "flow_field.h"
+#include "path_service.h"
+#include "navigation_cost_grid.h"
+#include "ticking_squares.h"
+#include "field_of_view.h"
+#include "effect.h"
+#include "effect_type.h"
+#include "equipment.h"
 
 class Test {
   public:
@@ -57,27 +70,74 @@ class Test {
   }
 
   void testTimeQueue() {
-   /* CreatureAttributes attr = CATTR(c.name = ""; c.speed = 5; c.size = CreatureSize::SMALL; c.strength = 1; c.dexterity = 3; c.humanoid = false; c.weight = 0.1;);
-    PCreature b(new Creature(ViewObject(ViewId("jackal"), ViewLayer::CREATURE, ""), nullptr, attr));
-    PCreature a(new Creature(ViewObject(ViewId("player"), ViewLayer::CREATURE, ""), nullptr, attr));
-    PCreature c(new Creature(ViewObject(ViewId("jackal"), ViewLayer::CREATURE, ""), nullptr, attr));
-    Creature* rb = b.get(), *ra = a.get(), *rc = c.get();
-    a->setTime(1);
-    b->setTime(1.33);
-    c->setTime(1.66);
+    PCreature a = CreatureFactory::getHumanForTests();
+    PCreature b = CreatureFactory::getHumanForTests();
+    PCreature c = CreatureFactory::getHumanForTests();
+    Creature* ra = a.get(), *rb = b.get(), *rc = c.get();
     TimeQueue q;
-    q.addCreature(move(a));
-    q.addCreature(move(b));
-    q.addCreature(move(c));
-    CHECK(q.getNextCreature() == ra);
-    ra->setTime(2);
-    CHECK(q.getNextCreature() == rb);
-    rb->setTime(2);
-    CHECK(q.getNextCreature() == rc);
-    rc->setTime(3);
-    CHECK(q.getNextCreature() == rb);
-    rb->setTime(3);
-    CHECK(q.getNextCreature() == ra);*/
+    q.addCreature(std::move(a), 1_local);
+    q.addCreature(std::move(b), 1_local);
+    q.addCreature(std::move(c), 2_local);
+    CHECK(q.getNextCreature(100) == ra);
+    CHECK(q.compareOrder(ra, rb));
+    q.postponeMove(ra);
+    CHECK(q.getNextCreature(100) == rb);
+    q.moveNow(ra);
+    CHECK(q.getNextCreature(100) == ra);
+    q.increaseTime(ra, 2_visible);
+    CHECK(q.getNextCreature(100) == rb);
+    q.makeExtraMove(rb);
+    CHECK(q.hasExtraMove(rb));
+    CHECK(q.getNextCreature(100) == rb);
+    CHECK(q.getNextCreature(1) == nullptr);
+    q.increaseTime(rb, 1_visible);
+    CHECK(!q.hasExtraMove(rb));
+    CHECK(q.getNextCreature(100) == rc);
+    CHECK(q.compareOrder(rc, rb));
+    q.removeCreature(rc);
+    CHECK(q.getNextCreature(100) == rb);
+    CHECK(q.getTime(rb) == 2_local);
+    CHECK(q.getTime(ra) == 3_local);
+    CHECK(!q.compareOrder(rb, ra));
+  }
+
+  void testTimingWheel() {
+    TimingWheel<int> w(4);
+    w.insert(1, 1);
+    w.insert(2, 5);
+    w.insert(3, 1);
+    w.insert(4, 3);
+    CHECK(w.advance() == vector<int>({1, 3}));
+    CHECK(w.advance().empty());
+    CHECK(w.advance() == vector<int>({4}));
+    w.insert(5, 4);
+    CHECK(w.advance() == vector<int>({5}));
+    CHECK(w.advance() == vector<int>({2}));
+    CHECK(w.getTime() == 5);
+    for (int i : Range(20))
+      CHECK(w.advance().empty());
+  }
+
+  void testGasGrid() {
+    auto type = TileGasType("POISON_GAS");
+    GasGrid grid(Rectangle(10, 10));
+    grid.addPermanentAmount(type, Vec2(0, 0), 0.5);
+    CHECK(grid.getActiveTypes().empty());
+    CHECK(grid.addAmount(type, Vec2(3, 5), 1));
+    CHECK(grid.hasSunlightBlockingAmount(Vec2(3, 5)));
+    auto canSpreadTo = [](Vec2 v) { return v.x != 5; };
+    auto updates = grid.tick(type, 0.1, 1, canSpreadTo);
+    CHECK(grid.getAmount(type, Vec2(3, 5)) < 1);
+    CHECK(grid.getAmount(type, Vec2(4, 5)) > grid.getAmount(type, Vec2(4, 6)));
+    CHECK(grid.getAmount(type, Vec2(4, 6)) > 0);
+    CHECK(!!updates.size());
+    for (int i : Range(100))
+      grid.tick(type, 0.1, 0.9, canSpreadTo);
+    for (int y : Range(10))
+      CHECKEQ(grid.getAmount(type, Vec2(5, y)), 0);
+    CHECK(grid.getActiveTypes().empty());
+    CHECKEQ(grid.getAmount(type, Vec2(3, 5)), 0);
+    CHECKEQ(grid.getAmount(type, Vec2(0, 0)), 0.5);
   }
 
   void testRectangleIterator() {
@@ -192,6 +252,17 @@ class Test {
     CHECK(!path.isReachable(Vec2(1, 0)));
   }
 
+  void testShortestPathSplice() {
+    ShortestPath path(Rectangle(5, 5), [](Vec2) { return 1; }, [] (Vec2 to) { return Vec2(0, 2).dist4(to); },
+        Vec2::directions4(), Vec2(4, 2), Vec2(0, 2));
+    CHECK(path.getPath() == vector<Vec2>({Vec2(4, 2), Vec2(3, 2), Vec2(2, 2), Vec2(1, 2), Vec2(0, 2)}));
+    path.splice(1, {Vec2(3, 2), Vec2(3, 3), Vec2(2, 3), Vec2(1, 3), Vec2(0, 3), Vec2(0, 2)});
+    vector<Vec2> res {Vec2(0, 2)};
+    while (res.back() != Vec2(4, 2))
+      res.push_back(path.getNextMove(res.back()));
+    CHECK(res == vector<Vec2>({Vec2(0, 2), Vec2(0, 3), Vec2(1, 3), Vec2(2, 3), Vec2(3, 3), Vec2(3, 2), Vec2(4, 2)}));
+  }
+
   void testShortestPathReverse() {
     vector<vector<double> > table { { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}, { 1, 1, 1, ShortestPath::infinity, ShortestPath::infinity, 1, 1, 1, 1, 1, 1}, { 1, 1, 1, ShortestPath::infinity, ShortestPath::infinity, 1, 1, 1, 1, 1, 1}};
     ShortestPath path(Rectangle(11, 3),
@@ -206,6 +277,29 @@ class Test {
     CHECK(res == expected);*/
   }
 
+  void testDijkstra() {
+    Rectangle bounds(10, 10);
+    auto entryFun = [](Vec2 v) { return v.x == 5 && v.y > 0 ? ShortestPath::infinity : 0.5 + 0.25 * (v.y % 2); };
+    Dijkstra dijkstra(bounds, {Vec2(0, 0), Vec2(0, 0)}, 5, entryFun);
+    CHECKEQ(dijkstra.getDist(Vec2(0, 0)), 0);
+    CHECKEQ(dijkstra.getDist(Vec2(1, 1)), 0.75);
+    CHECKEQ(dijkstra.getDist(Vec2(5, 0)), 2.5);
+    CHECK(!dijkstra.isReachable(Vec2(5, 1)));
+    CHECK(!dijkstra.isReachable(Vec2(9, 9)));
+    CHECK(!dijkstra.isReachable(Vec2(-1, 0)));
+    Dijkstra dijkstra2(bounds, {Vec2(9, 9)}, 100, entryFun);
+    CHECK(dijkstra2.isReachable(Vec2(0, 0)));
+    CHECKEQ(dijkstra.getAllReachable().front(), Vec2(0, 0));
+    for (int i : Range(1, dijkstra.getAllReachable().size())) {
+      auto& reached = dijkstra.getAllReachable();
+      CHECK(dijkstra.getDist(reached[i - 1]) <= dijkstra.getDist(reached[i]));
+    }
+    BfSearch search(bounds, Vec2(0, 0), [](Vec2 v) { return v.x != 5 || v.y == 9; });
+    CHECK(search.isReachable(Vec2(9, 0)));
+    CHECK(!search.isReachable(Vec2(5, 0)));
+    CHECKEQ(search.getAllReachable().size(), 91);
+  }
+
   void testRange() {
     vector<int> a;
     vector<int> b {0,1,2,3,4,5,6};
@@ -505,6 +599,89 @@ class Test {
     INFO << s.getNumSectors() << " sectors";
   }
 
+  void testSectorsBatch() {
+    Rectangle bounds(100, 100);
+    Table<optional<Vec2>> portals(bounds);
+    for (int i : Range(10)) {
+      Vec2 v = bounds.random(Random);
+      Vec2 w = bounds.random(Random);
+      if (v != w && !portals[v] && !portals[w]) {
+        portals[v] = w;
+        portals[w] = v;
+      }
+    }
+    Sectors s(bounds, portals);
+    Sectors batched(bounds, portals);
+    batched.beginBatch();
+    for (Vec2 v : bounds)
+      if (!Random.roll(3)) {
+        s.add(v);
+        batched.add(v);
+      }
+    batched.commitBatch();
+    for (int i : Range(20)) {
+      batched.beginBatch();
+      for (int j : Range(500)) {
+        Vec2 v = bounds.random(Random);
+        if (Random.roll(2)) {
+          CHECK(s.remove(v) == batched.remove(v));
+        } else
+          CHECK(s.add(v) == batched.add(v));
+      }
+      batched.commitBatch();
+      CHECKEQ(s.getNumSectors(), batched.getNumSectors());
+      HashMap<Sectors::SectorId, Sectors::SectorId> ids;
+      for (Vec2 pos : bounds) {
+        CHECK(s.contains(pos) == batched.contains(pos));
+        if (auto id = s.getSector(pos)) {
+          if (auto other = getValueMaybe(ids, *id))
+            CHECK(*other == *batched.getSector(pos));
+          else
+            ids[*id] = *batched.getSector(pos);
+        }
+        for (Vec2 v : pos.neighbors8())
+          if (v.inRectangle(bounds))
+            CHECK(s.same(pos, v) == batched.same(pos, v));
+      }
+    }
+  }
+
+  void testSharedSectors() {
+    Rectangle bounds(7, 7);
+    // A wall with a door splits the area in two.
+    Table<bool> navigable(bounds, true);
+    for (int y : Range(7))
+      navigable[Vec2(3, y)] = y == 3;
+    MovementType walk(MovementTrait::WALK);
+    MovementType fly(MovementTrait::FLY);
+    MovementType swim(MovementTrait::SWIM);
+    SharedSectors sectors;
+    sectors.add(walk, navigable);
+    sectors.add(fly, navigable);
+    CHECK(sectors.getMaybe(walk) == sectors.getMaybe(fly));
+    sectors.add(swim, Table<bool>(bounds, false));
+    CHECK(sectors.getMaybe(walk) != sectors.getMaybe(swim));
+    CHECKEQ(sectors.getUsage().movementTypes, 3);
+    CHECKEQ(sectors.getUsage().distinctSectors, 2);
+    // The door is closed, but flyers can still pass above it.
+    auto changed = sectors.update(Vec2(3, 3), [&](const MovementType& m) { return m == fly; });
+    CHECK(changed == vector<MovementType>({walk}));
+    CHECK(sectors.getMaybe(walk) != sectors.getMaybe(fly));
+    CHECK(!sectors.getMaybe(walk)->same(Vec2(0, 0), Vec2(6, 6)));
+    CHECK(sectors.getMaybe(fly)->same(Vec2(0, 0), Vec2(6, 6)));
+    CHECKEQ(sectors.getUsage().movementTypes, 3);
+    CHECKEQ(sectors.getUsage().distinctSectors, 3);
+    // Both diverged groups follow later changes.
+    changed = sectors.update(Vec2(3, 0), [&](const MovementType& m) { return !(m == swim); });
+    CHECKEQ(changed.size(), 2);
+    CHECK(sectors.getMaybe(walk)->same(Vec2(0, 0), Vec2(6, 6)));
+    CHECK(sectors.getMaybe(fly)->same(Vec2(0, 0), Vec2(6, 6)));
+    CHECK(!sectors.getMaybe(swim)->contains(Vec2(3, 0)));
+    sectors.erase(fly);
+    CHECKEQ(sectors.getUsage().movementTypes, 2);
+    CHECKEQ(sectors.getUsage().distinctSectors, 2);
+  }
+
   void testSectorsWithPortals() {
     Sectors s(Rectangle(7, 7), Table<optional<Vec2>>(7, 7));
     s.add(Vec2(2, 1));
@@ -540,6 +717,188 @@ class Test {
     CHECK(!s.same(Vec2(0, 0), Vec2(5, 5)));
   }
 
+  void testPathClusters() {
+    Rectangle bounds(70, 40);
+    Sectors s(bounds, Table<optional<Vec2>>(bounds));
+    PathClusters clusters(bounds);
+    for (Vec2 v : bounds)
+      if (v.x != 32 || v.y == 37)
+        s.add(v);
+    auto checkWaypoints = [&](Vec2 from, Vec2 to) {
+      auto waypoints = clusters.getWaypoints(s, from, to);
+      CHECK(!!waypoints);
+      CHECK(waypoints->front() == from && waypoints->back() == to);
+      for (int i : Range(1, waypoints->size())) {
+        Vec2 v = (*waypoints)[i - 1];
+        Vec2 w = (*waypoints)[i];
+        CHECK(w.inRectangle(clusters.getClusterBounds(v)) || v.dist8(w) == 1 || s.getExtraConnection(v) == w);
+      }
+      return *waypoints;
+    };
+    CHECK(checkWaypoints(Vec2(2, 2), Vec2(67, 2)).contains(Vec2(32, 37)));
+    checkWaypoints(Vec2(2, 2), Vec2(5, 5));
+    s.remove(Vec2(32, 37));
+    clusters.invalidate(Vec2(32, 37));
+    CHECK(!clusters.getWaypoints(s, Vec2(2, 2), Vec2(67, 2)));
+    s.addExtraConnection(Vec2(10, 10), Vec2(60, 10));
+    clusters.invalidate(Vec2(10, 10));
+    clusters.invalidate(Vec2(60, 10));
+    CHECK(checkWaypoints(Vec2(2, 2), Vec2(67, 2)).contains(Vec2(60, 10)));
+  }
+
+  void testPathService() {
+    Rectangle bounds(30, 30);
+    Table<float> costs(bounds);
+    for (Vec2 v : bounds)
+      costs[v] = Random.roll(5) ? ShortestPath::infinity : 3 + Random.get(4);
+    PathService::Snapshot snapshot{costs, Table<optional<Vec2>>(bounds), {}, {}};
+    PathService::Search search{Table<float>(bounds), Table<int>(bounds, 0)};
+    auto getCost = [&](const vector<Vec2>& path) {
+      double ret = 0;
+      for (int i : Range(1, path.size()))
+        ret += i == path.size() - 1 ? 1.0 : snapshot.costs[path[i]];
+      return ret;
+    };
+    auto compare = [&] {
+      for (int i : Range(100)) {
+        Vec2 from = bounds.random(Random);
+        Vec2 target = bounds.random(Random);
+        if (from == target || snapshot.costs[target] == ShortestPath::infinity)
+          continue;
+        ShortestPath expected(bounds, [&](Vec2 v) { return v == from ? 1.0 : snapshot.costs[v]; },
+            [&](Vec2 v) { return 2 * (from.dist8(v) + 0.01 * from.distD(v)); }, Vec2::directions8(), target, from);
+        auto path = search.find(snapshot, from, target);
+        CHECKEQ(path.empty(), !expected.isReachable(from));
+        if (!path.empty()) {
+          CHECK(path.front() == target && path.back() == from);
+          CHECKEQ(getCost(path), getCost(expected.getPath()));
+        }
+      }
+    };
+    compare();
+    // Creatures raise the costs of different squares every turn, and the previous ones must be restored.
+    auto getCreatureCosts = [&] {
+      vector<pair<Vec2, float>> ret;
+      for (int i : Range(50))
+        ret.push_back(make_pair(bounds.random(Random), 20));
+      return ret;
+    };
+    for (int turn : Range(2)) {
+      auto creatureCosts = getCreatureCosts();
+      snapshot.setCreatureCosts(creatureCosts);
+      Table<bool> raised(bounds, false);
+      for (auto& elem : creatureCosts)
+        raised[elem.first] = true;
+      for (Vec2 v : bounds)
+        CHECKEQ(snapshot.costs[v], raised[v] ? 20 : costs[v]);
+      compare();
+    }
+    snapshot.setCreatureCosts({});
+    for (Vec2 v : bounds)
+      CHECKEQ(snapshot.costs[v], costs[v]);
+  }
+
+  void testFlowField() {
+    Rectangle bounds(10, 10);
+    auto entryFun = [](Vec2 v) { return v.x == 5 && v.y > 0 ? ShortestPath::infinity : 1.0; };
+    auto directions = [](Vec2) { return Vec2::directions8(); };
+    FlowField field(bounds, Vec2(9, 9), entryFun, directions);
+    CHECKEQ(field.getDistance(Vec2(9, 9)), 0);
+    CHECKEQ(field.getDistance(Vec2(9, 0)), 9);
+    CHECKEQ(field.getDistance(Vec2(0, 9)), 18);
+    CHECK(!field.isReachable(Vec2(5, 5)));
+    auto path = field.getPath(Vec2(0, 9), directions);
+    CHECKEQ(path.size(), 19);
+    CHECK(path.front() == Vec2(9, 9) && path.back() == Vec2(0, 9));
+    CHECK(path.contains(Vec2(5, 0)));
+    FlowField open(bounds, Vec2(9, 0), [](Vec2) { return 1.0; }, directions);
+    auto detour = open.getPath(Vec2(0, 0), directions, [](Vec2 v) { return v == Vec2(5, 0) ? 4.0 : 0.0; });
+    CHECKEQ(detour.size(), 10);
+    CHECK(!detour.contains(Vec2(5, 0)));
+    FlowFieldCache cache;
+    int numBuilt = 0;
+    auto build = [&] { ++numBuilt; return FlowField(bounds, Vec2(9, 9), entryFun, directions); };
+    FlowFieldCache::Key key(Vec2(9, 9), MovementType(MovementTrait::WALK));
+    FlowFieldCache::Generation generation(1, 1, 0);
+    CHECK(!cache.get(key, generation, build));
+    CHECK(!!cache.get(key, generation, build));
+    CHECK(!!cache.get(key, generation, build));
+    CHECKEQ(numBuilt, 1);
+    CHECK(!cache.get(key, FlowFieldCache::Generation(2, 1, 0), build));
+    CHECK(!!cache.get(key, FlowFieldCache::Generation(2, 1, 0), build));
+    CHECKEQ(numBuilt, 2);
+  }
+
+  void testFlowFieldCacheCostChange() {
+    // Damaging furniture changes the cost of destroying it, but not the sectors.
+    Rectangle bounds(10, 10);
+    Table<double> destroyCost(bounds, 1);
+    for (int y : Range(9))
+      destroyCost[Vec2(5, y)] = 100;
+    NavigationCostGrid costs(bounds);
+    auto entryFun = [&](Vec2 v) { return costs.get(v, [&] { return destroyCost[v]; }); };
+    auto directions = [](Vec2) { return Vec2::directions8(); };
+    FlowFieldCache cache;
+    int numBuilt = 0;
+    auto build = [&] { ++numBuilt; return FlowField(bounds, Vec2(9, 0), entryFun, directions); };
+    FlowFieldCache::Key key(Vec2(9, 0), MovementType(MovementTrait::WALK));
+    auto getGeneration = [&] { return FlowFieldCache::Generation(1, 1, costs.getGeneration()); };
+    CHECK(!cache.get(key, getGeneration(), build));
+    auto field = cache.get(key, getGeneration(), build);
+    CHECK(field->getPath(Vec2(0, 0), directions).contains(Vec2(5, 9)));
+    destroyCost[Vec2(5, 0)] = 1;
+    costs.invalidate(Vec2(5, 0));
+    field = cache.get(key, getGeneration(), build);
+    CHECK(!field);
+    field = cache.get(key, getGeneration(), build);
+    CHECKEQ(numBuilt, 2);
+    CHECK(field->getPath(Vec2(0, 0), directions).contains(Vec2(5, 0)));
+  }
+
+  void testTickingSquaresSaved() {
+    Rectangle bounds(10, 10);
+    TickingSquares squares(bounds);
+    squares.add(Vec2(5, 5));
+    squares.tick([](Vec2) { return true; });
+    // Added after the last tick, like a square that gas spreads to just before saving.
+    squares.add(Vec2(1, 1));
+    stringstream stream;
+    {
+      OutputArchive output(stream);
+      output(squares.getAll());
+    }
+    set<Vec2> loadedSet;
+    InputArchive input(stream);
+    input(loadedSet);
+    TickingSquares loaded(bounds);
+    for (auto v : loadedSet)
+      loaded.add(v);
+    vector<Vec2> ticked;
+    loaded.tick([&](Vec2 v) { ticked.push_back(v); return false; });
+    CHECK(ticked == vector<Vec2>({Vec2(1, 1), Vec2(5, 5)}));
+  }
+
+  void testFieldOfViewKernels() {
+    Rectangle bounds(3, 5, 83, 75);
+    Table<bool> blocking(bounds.minusMargin(-1), true);
+    for (Vec2 v : bounds)
+      blocking[v] = Random.roll(4);
+    FieldOfView::BlockingBits bits(blocking);
+    FieldOfView::Visibility scalar, bitboard;
+    for (Vec2 v : bounds) {
+      scalar.computeScalar(bounds, blocking, v.x, v.y);
+      bitboard.compute(bounds, bits, v.x, v.y);
+      auto& tiles1 = scalar.getVisibleTiles();
+      auto& tiles2 = bitboard.getVisibleTiles();
+      CHECKEQ(tiles1.size(), tiles2.size());
+      for (int i : All(tiles1))
+        CHECK(tiles1[i].x == tiles2[i].x && tiles1[i].y == tiles2[i].y) << v << " " << i;
+      Vec2 changed = bounds.random(Random);
+      blocking[changed] = !blocking[changed];
+      bits.set(changed, blocking[changed]);
+    }
+  }
+
   void testReverse() {
     vector<int> v1 {1, 2, 3, 4};
     vector<int> v2 {4, 3, 2, 1};
@@ -600,9 +959,9 @@ class Test {
 
   void testMinionEquipment1() {
     auto contentFactory = getContentFactory();
-    PItem bow1 = ItemType(CustomItemId("Bow")).get(&contentFactory);
-    PItem bow2 = ItemType(CustomItemId("Bow")).get(&contentFactory);
-    PItem bow3 = ItemType(CustomItemId("Bow")).get(&contentFactory);
+    PItem bow1 = ItemType(CustomItemId("Bow")).get(Random, &contentFactory);
+    PItem bow2 = ItemType(CustomItemId("Bow")).get(Random, &contentFactory);
+    PItem bow3 = ItemType(CustomItemId("Bow")).get(Random, &contentFactory);
     PCreature human = CreatureFactory::getHumanForTests();
     MinionEquipment equipment;
     CHECK(equipment.needsItem(human.get(), bow1.get(), false));
@@ -630,10 +989,25 @@ class Test {
     CHECK(equipment.getItemsOwnedBy(human.get()).contains(bow1.get()));
   }
 
+  void testEnhanceEquippedArmor() {
+    auto contentFactory = getContentFactory();
+    PCreature human = CreatureFactory::getHumanForTests();
+    PItem armor = ItemType(CustomItemId("LeatherArmor")).get(Random, &contentFactory);
+    Item* ref = armor.get();
+    auto& equipment = human->getEquipment();
+    equipment.addItem(std::move(armor), human.get(), &contentFactory);
+    equipment.equip(ref, ref->getEquipmentSlot(), human.get(), &contentFactory);
+    int defense = human->getAttr(AttrType("DEFENSE"));
+    CHECK(Effect(Effects::Enhance{Effects::EnhanceType::ARMOR, 2}).applyToCreature(human.get()));
+    CHECKEQ(human->getAttr(AttrType("DEFENSE")), defense + 2);
+    CHECK(Effect(Effects::Enhance{Effects::EnhanceType::ARMOR, -1}).applyToCreature(human.get()));
+    CHECKEQ(human->getAttr(AttrType("DEFENSE")), defense + 1);
+  }
+
   void testMinionEquipmentItemDestroyed() {
     auto contentFactory = getContentFactory();
-    PItem sword = ItemType(CustomItemId("Sword")).get(&contentFactory);
-    PItem sword2 = ItemType(CustomItemId("Sword")).get(&contentFactory);
+    PItem sword = ItemType(CustomItemId("Sword")).get(Random, &contentFactory);
+    PItem sword2 = ItemType(CustomItemId("Sword")).get(Random, &contentFactory);
     sword2->addModifier(AttrType("DAMAGE"), -5);
     PCreature human = CreatureFactory::getHumanForTests();
     MinionEquipment equipment;
@@ -647,8 +1021,8 @@ class Test {
 
   void testMinionEquipmentUpdateItems() {
     auto contentFactory = getContentFactory();
-    PItem sword = ItemType(CustomItemId("Sword")).get(&contentFactory);
-    PItem sword2 = ItemType(CustomItemId("Sword")).get(&contentFactory);
+    PItem sword = ItemType(CustomItemId("Sword")).get(Random, &contentFactory);
+    PItem sword2 = ItemType(CustomItemId("Sword")).get(Random, &contentFactory);
     sword2->addModifier(AttrType("DAMAGE"), -5);
     PCreature human = CreatureFactory::getHumanForTests();
     PCreature human2 = CreatureFactory::getHumanForTests();
@@ -665,8 +1039,8 @@ class Test {
 
   void testMinionEquipmentUpdateOwners() {
     auto contentFactory = getContentFactory();
-    PItem sword1 = ItemType(CustomItemId("Sword")).get(&contentFactory);
-    PItem sword2 = ItemType(CustomItemId("Sword")).get(&contentFactory);
+    PItem sword1 = ItemType(CustomItemId("Sword")).get(Random, &contentFactory);
+    PItem sword2 = ItemType(CustomItemId("Sword")).get(Random, &contentFactory);
     PCreature human1 = CreatureFactory::getHumanForTests();
     PCreature human2 = CreatureFactory::getHumanForTests();
     MinionEquipment equipment;
@@ -688,9 +1062,9 @@ class Test {
 
   void testMinionEquipmentAutoAssign() {
     auto contentFactory = getContentFactory();
-    PItem sword1 = ItemType(CustomItemId("Sword")).get(&contentFactory);
-    PItem sword2 = ItemType(CustomItemId("Sword")).get(&contentFactory);
-    PItem sword3 = ItemType(CustomItemId("Sword")).get(&contentFactory);
+    PItem sword1 = ItemType(CustomItemId("Sword")).get(Random, &contentFactory);
+    PItem sword2 = ItemType(CustomItemId("Sword")).get(Random, &contentFactory);
+    PItem sword3 = ItemType(CustomItemId("Sword")).get(Random, &contentFactory);
     sword1->addModifier(AttrType("DAMAGE"), 12);
     PCreature human1 = CreatureFactory::getHumanForTests();
     PCreature human2 = CreatureFactory::getHumanForTests();
@@ -709,8 +1083,8 @@ class Test {
     CHECK(equipment.isOwner(sword1.get(), human2.get()));
     CHECKEQ(equipment.getItemsOwnedBy(human2.get()), makeVec(sword1.get()));
     CHECK(!equipment.getOwner(sword2.get()));
-    PItem bow = ItemType(CustomItemId("Bow")).get(&contentFactory);
-    PItem bow2 = ItemType(CustomItemId("Bow")).get(&contentFactory);
+    PItem bow = ItemType(CustomItemId("Bow")).get(Random, &contentFactory);
+    PItem bow2 = ItemType(CustomItemId("Bow")).get(Random, &contentFactory);
     bow2->addModifier(AttrType("DAMAGE"), 30);
     CHECK(equipment.getItemsOwnedBy(human1.get()).size() == 0);
     equipment.autoAssign(human1.get(), {bow.get()});
@@ -731,8 +1105,8 @@ class Test {
 
   void testMinionEquipmentLocking() {
     auto contentFactory = getContentFactory();
-    PItem sword1 = ItemType(CustomItemId("Sword")).get(&contentFactory);
-    PItem sword2 = ItemType(CustomItemId("Sword")).get(&contentFactory);
+    PItem sword1 = ItemType(CustomItemId("Sword")).get(Random, &contentFactory);
+    PItem sword2 = ItemType(CustomItemId("Sword")).get(Random, &contentFactory);
     sword1->addModifier(AttrType("DAMAGE"), 12);
     PCreature human1 = CreatureFactory::getHumanForTests();
     MinionEquipment equipment;
@@ -757,8 +1131,8 @@ class Test {
 
   void testEquipmentSlotLocking() {
     auto contentFactory = getContentFactory();
-    PItem sword1 = ItemType(CustomItemId("Sword")).get(&contentFactory);
-    PItem sword2 = ItemType(CustomItemId("Sword")).get(&contentFactory);
+    PItem sword1 = ItemType(CustomItemId("Sword")).get(Random, &contentFactory);
+    PItem sword2 = ItemType(CustomItemId("Sword")).get(Random, &contentFactory);
     sword1->addModifier(AttrType("DAMAGE"), 12);
     PCreature human1 = CreatureFactory::getHumanForTests();
     human1->getAttributes().increaseBaseAttr(AttrType("MULTI_WEAPON"), 50);
@@ -777,10 +1151,10 @@ class Test {
 
   void testMinionEquipment123() {
     auto contentFactory = getContentFactory();
-    PItem sword = ItemType(CustomItemId("Sword")).get(&contentFactory);
-    PItem boots = ItemType(CustomItemId("LeatherBoots")).get(&contentFactory);
-    PItem gloves = ItemType(CustomItemId("LeatherGloves")).get(&contentFactory);
-    PItem helmet = ItemType(CustomItemId("LeatherHelm")).get(&contentFactory);
+    PItem sword = ItemType(CustomItemId("Sword")).get(Random, &contentFactory);
+    PItem boots = ItemType(CustomItemId("LeatherBoots")).get(Random, &contentFactory);
+    PItem gloves = ItemType(CustomItemId("LeatherGloves")).get(Random, &contentFactory);
+    PItem helmet = ItemType(CustomItemId("LeatherHelm")).get(Random, &contentFactory);
     vector<Item*> items = {sword.get(), boots.get(), gloves.get(), helmet.get()};
     PCreature human = CreatureFactory::getHumanForTests();
     MinionEquipment equipment;
@@ -1154,7 +1528,7 @@ class Test {
   struct MatchingTest {
     MatchingTest() {
       auto contentFactory = getContentFactory();
-      auto model = Model::create(&contentFactory, none, BiomeId("GRASSLAND"));
+      auto model = Model::create(&contentFactory, Random, none, BiomeId("GRASSLAND"));
       LevelBuilder builder(nullptr, Random, &contentFactory, 10, 10, false, none);
       PLevelMaker levelMaker = LevelMaker::emptyLevel(FurnitureType("MOUNTAIN"), true);
       level = model->buildMainLevel(&contentFactory, std::move(builder), std::move(levelMaker));
@@ -1298,6 +1672,8 @@ class Test {
 void testAll() {
   Test().testStringConvertion();
   Test().testTimeQueue();
+  Test().testTimingWheel();
+  Test().testGasGrid();
   Test().testRectangleIterator();
   Test().testValueCheck();
   Test().testSplit();
@@ -1305,6 +1681,7 @@ void testAll() {
   Test().testShortestPath();
   Test().testAStar();
   Test().testShortestPath2();
+  Test().testShortestPathSplice();
   Test().testShortestPathReverse();
   Test().testRange();
   Test().testRange2();
@@ -1325,13 +1702,23 @@ void testAll() {
   Test().testSectors1();
   Test().testSectors2();
   Test().testSectors3();
+  Test().testSectorsBatch();
   Test().testSectorsWithPortals();
+  Test().testSharedSectors();
+  Test().testPathClusters();
+  Test().testDijkstra();
+  Test().testPathService();
+  Test().testFlowField();
+  Test().testFlowFieldCacheCostChange();
+  Test().testFieldOfViewKernels();
+  Test().testTickingSquaresSaved();
   Test().testReverse();
   Test().testReverse2();
   Test().testReverse3();
   Test().testOwnerPointer();
   Test().testMinionEquipment1();
   Test().testMinionEquipmentItemDestroyed();
+  Test().testEnhanceEquippedArmor();
   Test().testMinionEquipmentUpdateItems();
   Test().testMinionEquipmentUpdateOwners();
   Test().testMinionEquipmentAutoAssign();
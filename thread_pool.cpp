@@ -0,0 +1,103 @@
+/* Copyright (C) 2013-2014 Michal Brzozowski (rusolis@poczta.fm)
+
+   This file is part of KeeperRL.
+
+   KeeperRL is free software; you can redistribute it and/or modify it under the terms of the
+   GNU General Public License as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   KeeperRL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+   even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with this program.
+   If not, see http://www.gnu.org/licenses/ . */
+
+#include "stdafx.h"
+#include "util.h"
+#include "thread_pool.h"
+
+struct ThreadPool::Job {
+  function<void(int)> task;
+  int numTasks;
+  atomic<int> nextTask {0};
+  atomic<int> numFinished {0};
+};
+
+ThreadPool& ThreadPool::get() {
+  static ThreadPool pool(max(1u, std::thread::hardware_concurrency()) - 1);
+  return pool;
+}
+
+ThreadPool::ThreadPool(int numWorkers) {
+  for (int i : Range(numWorkers))
+    workers.push_back(makeThread([this] { workerLoop(); }));
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::unique_lock<std::mutex> lock(mut);
+    finishing = true;
+  }
+  jobAdded.notify_all();
+  for (auto& t : workers)
+    t.join();
+}
+
+int ThreadPool::getConcurrency() const {
+  return workers.size() + 1;
+}
+
+void ThreadPool::runTasks(Job& job) {
+  for (int index = job.nextTask++; index < job.numTasks; index = job.nextTask++) {
+    job.task(index);
+    ++job.numFinished;
+  }
+}
+
+void ThreadPool::workerLoop() {
+  while (true) {
+    shared_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> lock(mut);
+      jobAdded.wait(lock, [this] { return finishing || !jobs.empty(); });
+      if (finishing)
+        return;
+      job = jobs.front();
+      // Every task of the job is taken once its counter runs out, so it can leave the queue.
+      if (job->nextTask >= job->numTasks) {
+        jobs.pop_front();
+        continue;
+      }
+    }
+    runTasks(*job);
+    std::unique_lock<std::mutex> lock(mut);
+    if (job->numFinished == job->numTasks)
+      jobFinished.notify_all();
+  }
+}
+
+void ThreadPool::run(int numTasks, function<void(int)> task) {
+  if (numTasks <= 0)
+    return;
+  if (numTasks == 1 || workers.empty()) {
+    for (int i : Range(numTasks))
+      task(i);
+    return;
+  }
+  auto job = make_shared<Job>();
+  job->task = std::move(task);
+  job->numTasks = numTasks;
+  {
+    std::unique_lock<std::mutex> lock(mut);
+    jobs.push_back(job);
+  }
+  jobAdded.notify_all();
+  // The calling thread works on its own job, so nested jobs finish even when all workers are busy.
+  runTasks(*job);
+  std::unique_lock<std::mutex> lock(mut);
+  jobFinished.wait(lock, [&] { return job->numFinished == job->numTasks; });
+  auto it = std::find(jobs.begin(), jobs.end(), job);
+  if (it != jobs.end())
+    jobs.erase(it);
+}
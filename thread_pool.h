@@ -0,0 +1,43 @@
+/* Copyright (C) 2013-2014 Michal Brzozowski (rusolis@poczta.fm)
+
+   This file is part of KeeperRL.
+
+   KeeperRL is free software; you can redistribute it and/or modify it under the terms of the
+   GNU General Public License as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   KeeperRL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+   even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with this program.
+   If not, see http://www.gnu.org/licenses/ . */
+
+#pragma once
+
+#include "util.h"
+
+// Worker threads that live for the whole run of the program, so that parallel work done every turn doesn't pay for
+// creating threads. Jobs can be started from several threads at once, and from inside other jobs.
+class ThreadPool {
+  public:
+  static ThreadPool& get();
+  // Calls task(0) ... task(numTasks - 1) on the pool's threads and on the calling thread, and returns once all of
+  // them are done.
+  void run(int numTasks, function<void(int)> task);
+  // The number of tasks that can run at once, including the calling thread.
+  int getConcurrency() const;
+  ~ThreadPool();
+
+  private:
+  ThreadPool(int numWorkers);
+  struct Job;
+  void workerLoop();
+  static void runTasks(Job&);
+  std::mutex mut;
+  std::condition_variable jobAdded;
+  std::condition_variable jobFinished;
+  deque<shared_ptr<Job>> jobs;
+  vector<thread> workers;
+  bool finishing = false;
+};
@@ -0,0 +1,65 @@
+/* Copyright (C) 2013-2014 Michal Brzozowski (rusolis@poczta.fm)
+
+   This file is part of KeeperRL.
+
+   KeeperRL is free software; you can redistribute it and/or modify it under the terms of the
+   GNU General Public License as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   KeeperRL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+   even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with this program.
+   If not, see http://www.gnu.org/licenses/ . */
+
+#pragma once
+
+#include "util.h"
+
+// Squares of a level that need to be ticked. Squares added between ticks wait in a separate list and are merged in,
+// in sorted order, at the start of the next tick.
+class TickingSquares {
+  public:
+  TickingSquares(Rectangle bounds) : contains(bounds, false) {}
+
+  void add(Vec2 v) {
+    if (!contains[v]) {
+      contains[v] = true;
+      added.push_back(v);
+    }
+  }
+
+  // Calls tick() on every square in sorted order and keeps only those for which it returns true.
+  template <typename Fun>
+  void tick(Fun tick) {
+    if (!added.empty()) {
+      std::sort(added.begin(), added.end());
+      auto oldSize = squares.size();
+      append(squares, added);
+      std::inplace_merge(squares.begin(), squares.begin() + oldSize, squares.end());
+      added.clear();
+    }
+    int kept = 0;
+    for (int i : All(squares)) {
+      auto v = squares[i];
+      if (tick(v))
+        squares[kept++] = v;
+      else
+        contains[v] = false;
+    }
+    squares.resize(kept);
+  }
+
+  // Includes the squares added since the last tick.
+  set<Vec2> getAll() const {
+    set<Vec2> ret(squares.begin(), squares.end());
+    ret.insert(added.begin(), added.end());
+    return ret;
+  }
+
+  private:
+  vector<Vec2> squares;
+  vector<Vec2> added;
+  Table<bool> contains;
+};
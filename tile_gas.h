@@ -19,16 +19,15 @@
 #include "position.h"
 #include "tile_gas_type.h"
 
-class Level;
+class GasGrid;
 
+// Gas amounts stored in a Square. The Level simulates gas in its GasGrid, so this only holds permanent gas
+// added during level generation and gas from older saves, until the Level moves it into the grid.
 class TileGas {
   public:
-  void addAmount(Position, TileGasType, double amount);
   void addPermanentAmount(TileGasType, double amount);
-  void tick(Position);
-  double getAmount(TileGasType) const;
-  static double getFogVisionCutoff();
-  bool hasSunlightBlockingAmount() const;
+  bool isEmpty() const;
+  void moveTo(GasGrid&, Vec2);
 
   template <class Archive>
   void serialize(Archive& ar, const unsigned int version);
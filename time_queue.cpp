@@ -19,134 +19,204 @@
 #include "creature.h"
 #include "view_object.h"
 
-template <class Archive> 
-void TimeQueue::serialize(Archive& ar, const unsigned int version) { 
+template <class Archive>
+void TimeQueue::serialize(Archive& ar, const unsigned int version) {
+  EntityMap<Creature, ExtendedTime> SERIAL(timeMap);
+  map<ExtendedTime, SerialQueue> SERIAL(queue);
+  if (Archive::is_saving::value)
+    for (auto& bucket : buckets) {
+      auto& q = queue[bucket.time];
+      for (auto c : bucket.players.getAll())
+        q.players.push_back(c);
+      for (auto c : bucket.nonPlayers.getAll())
+        q.nonPlayers.push_back(c);
+      for (auto c : concat(bucket.players.getAll(), bucket.nonPlayers.getAll())) {
+        auto& entry = entries.getOrFail(c);
+        timeMap.set(c, entry.time);
+        q.orderMap.set(c, entry.order);
+      }
+    }
   ar(creatures, timeMap, queue);
+  if (Archive::is_loading::value)
+    for (auto& elem : queue) {
+      for (auto c : elem.second.players)
+        if (c)
+          entries.set(c, Entry{elem.first, getBucket(elem.first).players.pushBack(c), true});
+      for (auto c : elem.second.nonPlayers)
+        if (c)
+          entries.set(c, Entry{elem.first, getBucket(elem.first).nonPlayers.pushBack(c), false});
+    }
 }
 
 SERIALIZABLE(TimeQueue);
 
 void TimeQueue::addCreature(PCreature c, LocalTime time) {
-  timeMap.set(c.get(), time);
-  queue[time].push(c.get());
+  push(c.get(), time, entries.getOrInit(c.get()));
   creatures.push_back(std::move(c));
 }
 
 LocalTime TimeQueue::getTime(const Creature* c) {
-  return timeMap.getOrFail(c).time;
+  return entries.getOrFail(c).time.time;
 }
 
-static void clearNull(deque<Creature*>& q) {
-  while (!q.empty() && q.back() == nullptr)
-    q.pop_back();
-  while (!q.empty() && q.front() == nullptr)
-    q.pop_front();
+TimeQueue::Line::Line(int firstOrder) : firstOrder(firstOrder), baseOrder(firstOrder) {}
+
+void TimeQueue::Line::clearNull() {
+  while (elems.size() > head && elems.back() == nullptr)
+    elems.pop_back();
+  while (head < elems.size() && elems[head] == nullptr)
+    ++head;
+  if (head == elems.size()) {
+    elems.clear();
+    head = 0;
+    baseOrder = firstOrder;
+  }
 }
 
-void TimeQueue::Queue::clearNull() {
-  ::clearNull(players);
-  ::clearNull(nonPlayers);
+int TimeQueue::Line::pushBack(Creature* c) {
+  clearNull();
+  elems.push_back(c);
+  return baseOrder + elems.size() - 1;
 }
 
-void TimeQueue::Queue::push(Creature* c) {
+int TimeQueue::Line::pushFront(Creature* c) {
   clearNull();
-  if (c->isPlayer()) {
-    int order = players.empty() ? 0 : orderMap.getOrFail(players.back()) + 1;
-    orderMap.set(c, order);
-    players.push_back(c);
-  } else {
-    int order = nonPlayers.empty() ? 1000000000 : orderMap.getOrFail(nonPlayers.back()) + 1;
-    orderMap.set(c, order);
-    nonPlayers.push_back(c);
-  }
+  if (elems.empty())
+    return pushBack(c);
+  if (head == 0) {
+    elems.push_front(c);
+    --baseOrder;
+  } else
+    elems[--head] = c;
+  return baseOrder + head;
+}
+
+void TimeQueue::Line::erase(int order) {
+  int index = order - baseOrder;
+  CHECK(index >= head && index < elems.size() && elems[index] != nullptr);
+  elems[index] = nullptr;
 }
 
-void TimeQueue::Queue::pushFront(Creature* c) {
+bool TimeQueue::Line::empty() {
   clearNull();
-  if (c->isPlayer()) {
-    int order = players.empty() ? 0 : orderMap.getOrFail(players.front()) - 1;
-    orderMap.set(c, order);
-    players.push_front(c);
-  } else {
-    int order = nonPlayers.empty() ? 1000000000 : orderMap.getOrFail(nonPlayers.front()) - 1;
-    orderMap.set(c, order);
-    nonPlayers.push_front(c);
-  }
+  return elems.empty();
 }
 
-bool TimeQueue::Queue::empty() {
+Creature* TimeQueue::Line::front() {
   clearNull();
+  return elems[head];
+}
+
+vector<Creature*> TimeQueue::Line::getAll() const {
+  vector<Creature*> ret;
+  for (int i = head; i < elems.size(); ++i)
+    if (elems[i])
+      ret.push_back(elems[i]);
+  return ret;
+}
+
+TimeQueue::Bucket::Bucket() : players(0), nonPlayers(1000000000) {}
+
+bool TimeQueue::Bucket::empty() {
   return players.empty() && nonPlayers.empty();
 }
 
-Creature* TimeQueue::Queue::front() {
-  clearNull();
+Creature* TimeQueue::Bucket::front() {
   if (!players.empty())
     return players.front();
   else
     return nonPlayers.front();
 }
 
-void TimeQueue::Queue::popFront() {
-  if (!players.empty())
-    return players.pop_front();
-  else
-    return nonPlayers.pop_front();
+int TimeQueue::findBucket(ExtendedTime time) const {
+  return std::lower_bound(buckets.begin(), buckets.end(), time,
+      [](const Bucket& b, ExtendedTime t) { return t < b.time; }) - buckets.begin();
 }
 
-void TimeQueue::Queue::erase(Creature* c) {
-  auto eraseFrom = [&c] (deque<Creature*>& queue) {
-    for (int i : All(queue))
-      if (queue[i] == c) {
-        queue[i] = nullptr;
-        return true;
-      }
-    return false;
-  };
-  CHECK(eraseFrom(players) || eraseFrom(nonPlayers));
+TimeQueue::Bucket& TimeQueue::getBucket(ExtendedTime time) {
+  int index = findBucket(time);
+  if (index < buckets.size() && buckets[index].time == time)
+    return buckets[index];
+  if (!freeBuckets.empty()) {
+    buckets.insert(index, std::move(freeBuckets.back()));
+    freeBuckets.pop_back();
+  } else
+    buckets.insert(index, Bucket());
+  buckets[index].time = time;
+  return buckets[index];
+}
+
+TimeQueue::Bucket& TimeQueue::getExistingBucket(ExtendedTime time) {
+  int index = findBucket(time);
+  CHECK(index < buckets.size() && buckets[index].time == time);
+  return buckets[index];
+}
+
+void TimeQueue::push(Creature* c, ExtendedTime time, Entry& entry) {
+  auto& bucket = getBucket(time);
+  entry.time = time;
+  entry.player = c->isPlayer();
+  entry.order = entry.player ? bucket.players.pushBack(c) : bucket.nonPlayers.pushBack(c);
+}
+
+void TimeQueue::pushFront(Creature* c, ExtendedTime time, Entry& entry) {
+  auto& bucket = getBucket(time);
+  entry.time = time;
+  entry.player = c->isPlayer();
+  entry.order = entry.player ? bucket.players.pushFront(c) : bucket.nonPlayers.pushFront(c);
+}
+
+void TimeQueue::erase(const Entry& entry) {
+  auto& bucket = getExistingBucket(entry.time);
+  if (entry.player)
+    bucket.players.erase(entry.order);
+  else
+    bucket.nonPlayers.erase(entry.order);
 }
 
 void TimeQueue::increaseTime(Creature* c, TimeInterval diff) {
-  auto& time = timeMap.getOrFail(c);
-  queue.at(time).erase(c);
+  auto& entry = entries.getOrFail(c);
+  erase(entry);
+  auto time = entry.time;
   time.time += diff;
   time.extraTurn = false;
-  queue[time].push(c);
+  push(c, time, entry);
 }
 
 void TimeQueue::makeExtraMove(Creature* c) {
-  auto& time = timeMap.getOrFail(c);
-  queue.at(time).erase(c);
+  auto& entry = entries.getOrFail(c);
+  erase(entry);
+  auto time = entry.time;
   if (!time.extraTurn)
     time.extraTurn = true;
   else {
     time.time += 1_visible;
     time.extraTurn = false;
   }
-  queue[time].push(c);
+  push(c, time, entry);
 }
 
 bool TimeQueue::hasExtraMove(Creature* c) {
-  return timeMap.getOrFail(c).extraTurn;
+  return entries.getOrFail(c).time.extraTurn;
 }
 
 void TimeQueue::postponeMove(Creature* c) {
   CHECK(contains(c));
-  auto time = timeMap.getOrFail(c);
-  queue.at(time).erase(c);
-  queue.at(time).push(c);
+  auto& entry = entries.getOrFail(c);
+  erase(entry);
+  push(c, entry.time, entry);
 }
 
 void TimeQueue::moveNow(Creature* c) {
   CHECK(contains(c));
-  auto time = timeMap.getOrFail(c);
-  queue.at(time).erase(c);
-  queue.at(time).pushFront(c);
+  auto& entry = entries.getOrFail(c);
+  erase(entry);
+  pushFront(c, entry.time, entry);
 }
 
 bool TimeQueue::willMoveThisTurn(const Creature* c) {
-  auto hisTime = timeMap.getOrFail(c);
-  auto curTime = queue.begin()->first;
+  auto hisTime = entries.getOrFail(c).time;
+  auto curTime = buckets.back().time;
   return hisTime.time == curTime.time && (!hisTime.extraTurn || curTime.extraTurn);
 }
 
@@ -157,21 +227,17 @@ bool TimeQueue::compareOrder(const Creature* c1, const Creature* c2) {
     return false;
   if (!willMoveThisTurn(c1))
     return c1->getLastMoveCounter() < c2->getLastMoveCounter();
-  auto time1 = timeMap.getOrFail(c1);
-  auto time2 = timeMap.getOrFail(c2);
-  if (time1 < time2)
+  auto& entry1 = entries.getOrFail(c1);
+  auto& entry2 = entries.getOrFail(c2);
+  if (entry1.time < entry2.time)
     return true;
-  if (time2 < time1)
+  if (entry2.time < entry1.time)
     return false;
-  auto& orderMap = queue.at(time1).orderMap;
-  return orderMap.getOrFail(c1) < orderMap.getOrFail(c2);
+  return entry1.order < entry2.order;
 }
 
 bool TimeQueue::contains(Creature* c) const {
-  for (auto& creature : creatures)
-    if (creature.get() == c)
-      return true;
-  return false;
+  return entries.hasKey(c);
 }
 
 TimeQueue::TimeQueue() {}
@@ -179,7 +245,8 @@ TimeQueue::TimeQueue() {}
 PCreature TimeQueue::removeCreature(Creature* cRef) {
   for (int i : All(creatures))
     if (creatures[i].get() == cRef) {
-      queue.at(timeMap.getOrFail(cRef)).erase(cRef);
+      erase(entries.getOrFail(cRef));
+      entries.erase(cRef);
       PCreature ret = std::move(creatures[i]);
       creatures.removeIndexPreserveOrder(i);
       return ret;
@@ -196,21 +263,19 @@ Creature* TimeQueue::getNextCreature(double maxTime) {
   if (creatures.empty())
     return nullptr;
   while (1) {
-    CHECK(!queue.empty());
-    if (!queue.begin()->second.empty())
+    CHECK(!buckets.empty());
+    if (!buckets.back().empty())
       break;
-    queue.erase(queue.begin());
+    freeBuckets.push_back(std::move(buckets.back()));
+    buckets.pop_back();
   }
-  auto nowTime = queue.begin()->first;
-  if (nowTime.getDouble() > maxTime)
+  auto& q = buckets.back();
+  if (q.time.getDouble() > maxTime)
     return nullptr;
-  auto& q = queue.begin()->second;
-  if (!nowTime.extraTurn) {
-    auto nextQueue = ++queue.begin();
-    if (nextQueue != queue.end()) {
-      if (nextQueue->first.time == nowTime.time && !nextQueue->second.empty() && nextQueue->second.front()->isPlayer())
-        return nextQueue->second.front();
-    }
+  if (!q.time.extraTurn && buckets.size() > 1) {
+    auto& nextQueue = buckets[buckets.size() - 2];
+    if (nextQueue.time.time == q.time.time && !nextQueue.empty() && nextQueue.front()->isPlayer())
+      return nextQueue.front();
   }
   return q.front();
 }
@@ -229,3 +294,7 @@ double TimeQueue::ExtendedTime::getDouble() const {
 bool TimeQueue::ExtendedTime::operator < (TimeQueue::ExtendedTime o) const {
   return time < o.time || (time == o.time && !extraTurn && o.extraTurn);
 }
+
+bool TimeQueue::ExtendedTime::operator == (TimeQueue::ExtendedTime o) const {
+  return time == o.time && extraTurn == o.extraTurn;
+}
@@ -46,31 +46,64 @@ class TimeQueue {
   bool contains(Creature*) const;
 
   vector<PCreature> SERIAL(creatures);
-  struct Queue {
-    void push(Creature*);
-    void pushFront(Creature*);
-    bool empty();
-    Creature* front();
-    void popFront();
-    void erase(Creature*);
-    deque<Creature*> SERIAL(players);
-    deque<Creature*> SERIAL(nonPlayers);
-    EntityMap<Creature, int> SERIAL(orderMap);
-    SERIALIZE_ALL(players, nonPlayers, orderMap)
-
-    private:
-    void clearNull();
-  };
   struct ExtendedTime {
     ExtendedTime();
     ExtendedTime(LocalTime);
     double getDouble() const;
     bool operator < (ExtendedTime) const;
+    bool operator == (ExtendedTime) const;
     LocalTime SERIAL(time);
     bool SERIAL(extraTurn) = false;
     SERIALIZE_ALL(time, extraTurn)
   };
-  map<ExtendedTime, Queue> SERIAL(queue);
-  EntityMap<Creature, ExtendedTime> SERIAL(timeMap);
-};
+  // Creatures waiting for their move, in order. Removed creatures leave a null that is skipped lazily,
+  // so that every creature's order number maps directly to its index.
+  struct Line {
+    Line(int firstOrder);
+    int pushBack(Creature*);
+    int pushFront(Creature*);
+    void erase(int order);
+    bool empty();
+    Creature* front();
+    vector<Creature*> getAll() const;
 
+    private:
+    void clearNull();
+    vector<Creature*> elems;
+    int head = 0;
+    int firstOrder;
+    int baseOrder;
+  };
+  // All creatures that move at a given time. Players go first.
+  struct Bucket {
+    Bucket();
+    bool empty();
+    Creature* front();
+    ExtendedTime time;
+    Line players;
+    Line nonPlayers;
+  };
+  struct Entry {
+    ExtendedTime SERIAL(time);
+    int SERIAL(order);
+    bool SERIAL(player);
+    SERIALIZE_ALL(time, order, player)
+  };
+  // Layout of the queue as it used to be stored, kept for save compatibility.
+  struct SerialQueue {
+    deque<Creature*> SERIAL(players);
+    deque<Creature*> SERIAL(nonPlayers);
+    EntityMap<Creature, int> SERIAL(orderMap);
+    SERIALIZE_ALL(players, nonPlayers, orderMap)
+  };
+  int findBucket(ExtendedTime) const;
+  Bucket& getBucket(ExtendedTime);
+  Bucket& getExistingBucket(ExtendedTime);
+  void push(Creature*, ExtendedTime, Entry&);
+  void pushFront(Creature*, ExtendedTime, Entry&);
+  void erase(const Entry&);
+  // Sorted by time in descending order, so that the earliest bucket is at the back.
+  vector<Bucket> buckets;
+  vector<Bucket> freeBuckets;
+  EntityMap<Creature, Entry> entries;
+};
@@ -0,0 +1,59 @@
+/* Copyright (C) 2013-2014 Michal Brzozowski (rusolis@poczta.fm)
+
+   This file is part of KeeperRL.
+
+   KeeperRL is free software; you can redistribute it and/or modify it under the terms of the
+   GNU General Public License as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   KeeperRL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+   even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with this program.
+   If not, see http://www.gnu.org/licenses/ . */
+
+#pragma once
+
+#include "util.h"
+
+// Schedules elements at integer turns. Each slot holds the elements due at turns equal to its index modulo
+// the number of slots, so advancing one turn only visits elements of a single slot.
+template <typename T>
+class TimingWheel {
+  public:
+  TimingWheel(int numSlots = 256) : slots(numSlots) {}
+
+  int getTime() const {
+    return currentTime;
+  }
+
+  void insert(T elem, int time) {
+    CHECK(time > currentTime);
+    slots[time % slots.size()].push_back(make_pair(time, std::move(elem)));
+  }
+
+  // Moves to the next turn and returns the elements scheduled for it, in order of insertion.
+  vector<T> advance() {
+    ++currentTime;
+    vector<T> ret;
+    auto& slot = slots[currentTime % slots.size()];
+    int kept = 0;
+    for (int i : All(slot))
+      if (slot[i].first == currentTime)
+        ret.push_back(std::move(slot[i].second));
+      else
+        slot[kept++] = std::move(slot[i]);
+    slot.resize(kept);
+    return ret;
+  }
+
+  void clear() {
+    for (auto& slot : slots)
+      slot.clear();
+  }
+
+  private:
+  vector<vector<pair<int, T>>> slots;
+  int currentTime = 0;
+};
@@ -17,6 +17,7 @@
 
 #include "tribe.h"
 #include "creature.h"
+#include "game.h"
 
 template <class Archive> 
 void Tribe::serialize(Archive& ar, const unsigned int version) {
@@ -65,6 +66,10 @@ void Tribe::onMemberKilled(Creature* member, Creature* attacker) {
   if (attacker == nullptr)
     return;
   if (diplomatic) {
+    // Tribes are shared by all models, so they are only changed after a parallel model update.
+    if (auto game = member->getGame())
+      if (game->deferIfParallel([=] { onMemberKilled(member, attacker); }))
+        return;
     initStanding(attacker);
     standing.getOrFail(attacker) -= killPenalty * getMultiplier(member);
   }
@@ -84,6 +89,9 @@ const TribeSet& Tribe::getFriendlyTribes() const {
 
 void Tribe::onItemsStolen(Creature* attacker) {
   if (diplomatic) {
+    if (auto game = attacker->getGame())
+      if (game->deferIfParallel([=] { onItemsStolen(attacker); }))
+        return;
     initStanding(attacker);
     standing.getOrFail(attacker) -= thiefPenalty;
     addEnemy(attacker->getTribe());
@@ -36,9 +36,24 @@ void UniqueEntity<T>::clearOffset() {
 template<typename T>
 long long UniqueEntity<T>::offset = 0;
 
+// Ids can be created from several model update threads at once.
+static std::mutex idGenerationMutex;
+
+// Ids have their own generator, so that creating entities doesn't change the global or model random sequences.
+// It's seeded from the system, because ids from different game sessions mustn't collide.
+static RandomGen& getIdGenerator() {
+  static RandomGen* generator = [] {
+    auto ret = new RandomGen();
+    ret->init(int(std::random_device()()));
+    return ret;
+  }();
+  return *generator;
+}
+
 template<typename T>
 UniqueEntity<T>::Id::Id() {
-  key = Random.getLL();
+  std::unique_lock<std::mutex> lock(idGenerationMutex);
+  key = getIdGenerator().getLL();
   hash = int(key);
 }
 
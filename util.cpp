@@ -27,6 +27,23 @@ void RandomGen::init(int seed) {
   generator.seed(seed);
 }
 
+template <class Archive>
+void RandomGen::serialize(Archive& ar, const unsigned int) {
+  string state;
+  if (Archive::is_saving::value) {
+    std::stringstream ss;
+    ss << generator;
+    state = ss.str();
+  }
+  ar(state);
+  if (Archive::is_loading::value) {
+    std::stringstream ss(state);
+    ss >> generator;
+  }
+}
+
+SERIALIZABLE(RandomGen);
+
 int RandomGen::get(int max) {
   return get(0, max);
 }
@@ -707,6 +707,8 @@ class RandomGen {
   RandomGen();
   RandomGen(RandomGen&) = delete;
   void init(int seed);
+  template <class Archive>
+  void serialize(Archive&, const unsigned int);
   int get(int max);
   long long getLL();
   int get(int min, int max);
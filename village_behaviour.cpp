@@ -56,7 +56,7 @@ PTask VillageBehaviour::getAttackTask(VillageControl* self) const {
           return Task::killFighters(enemy, 1000);
       },
       [&](CampAndSpawn t) {
-        return Task::campAndSpawn(enemy, t, Random.get(3, 7));
+        return Task::campAndSpawn(enemy, t, self->collective->getRandom().get(3, 7));
       },
       [&](HalloweenKids) {
         FATAL << "Not handled";
@@ -66,7 +66,7 @@ PTask VillageBehaviour::getAttackTask(VillageControl* self) const {
   return Task::chain(
       std::move(task),
       Task::transferTo(self->collective->getModel()),
-      Task::goTo(Random.choose(self->collective->getTerritory().getAll()))
+      Task::goTo(self->collective->getRandom().choose(self->collective->getTerritory().getAll()))
   );
 }
 
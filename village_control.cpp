@@ -195,7 +195,7 @@ void VillageControl::launchAttack(vector<Creature*> attackers, bool duel) {
   int hisGold = enemy->numResource(CollectiveResourceId("GOLD"));
   if (!duel && behaviour->ransom && hisGold >= behaviour->ransom->second)
     ransom = max<int>(behaviour->ransom->second,
-        (Random.getDouble(behaviour->ransom->first * 0.6, behaviour->ransom->first)) * hisGold);
+        (collective->getRandom().getDouble(behaviour->ransom->first * 0.6, behaviour->ransom->first)) * hisGold);
   TeamId team = collective->getTeams().create(attackers);
   if (behaviour->isAttackBehaviourNonChasing())
     collective->getTeams().setTeamOrder(team, TeamOrder::FLEE, true);
@@ -219,7 +219,7 @@ void VillageControl::launchAttack(vector<Creature*> attackers, bool duel) {
 bool VillageControl::considerVillainAmbush(const vector<Creature*>& travellers) {
   if (!behaviour)
     return false;
-  if (Random.chance(behaviour->ambushChance)) {
+  if (collective->getRandom().chance(behaviour->ambushChance)) {
     auto attackers = getAttackers();
     if (!attackers.empty()) {
       const int maxDist = 3;
@@ -250,7 +250,7 @@ bool VillageControl::considerVillainAmbush(const vector<Creature*>& travellers)
       });
       if (goodPos.size() < attackers.size())
         return false;
-      goodPos = Random.permutation(std::move(goodPos));
+      goodPos = collective->getRandom().permutation(std::move(goodPos));
       vector<Position> targets;
       for (Creature* c : attackers) {
         bool found = false;
@@ -270,7 +270,7 @@ bool VillageControl::considerVillainAmbush(const vector<Creature*>& travellers)
         if (c->isAffected(LastingEffect::RIDER))
           if (auto steed = collective->getSteedOrRider(c))
             c->forceMount(steed);
-        Random.choose(travellers)->addCombatIntent(c, Creature::CombatIntentInfo::Type::CHASE);
+        collective->getRandom().choose(travellers)->addCombatIntent(c, Creature::CombatIntentInfo::Type::CHASE);
         if (c->getPosition().getModel() == collective->getModel())
           c->getPosition().moveCreature(targets[i]);
         else
@@ -317,7 +317,7 @@ void VillageControl::considerCancellingAttack() {
           for (Creature* c : members)
             collective->setTask(c, Task::chain(
                 Task::transferTo(collective->getModel()),
-                Task::goTo(Random.choose(collective->getTerritory().getAll()))
+                Task::goTo(collective->getRandom().choose(collective->getTerritory().getAll()))
             ));
           collective->getTeams().setTeamOrder(team, TeamOrder::FLEE, true);
           if (auto& name = collective->getName())
@@ -365,7 +365,7 @@ void VillageControl::acceptImmigration() {
 void VillageControl::healAllCreatures() {
   PROFILE;
   const double freq = 0.1;
-  if (Random.chance(freq))
+  if (collective->getRandom().chance(freq))
     for (auto c : collective->getCreatures())
       c->heal(0.002 / freq);
 }
@@ -390,8 +390,8 @@ vector<Creature*> VillageControl::getAttackers() const {
   vector<Creature*> allMembers = collective->getCreatures();
   if (fighters.size() >= behaviour->minTeamSize &&
       allMembers.size() >= behaviour->minPopulation + behaviour->minTeamSize)
-    return Random.permutation(fighters).getPrefix(
-          Random.get(behaviour->minTeamSize, min(fighters.size(), allMembers.size() - behaviour->minPopulation) + 1));
+    return collective->getRandom().permutation(fighters).getPrefix(
+          collective->getRandom().get(behaviour->minTeamSize, min(fighters.size(), allMembers.size() - behaviour->minPopulation) + 1));
   return {};
 }
 
@@ -414,7 +414,7 @@ void VillageControl::update(bool currentlyActive) {
     for (auto c : getCreatures())
       if (collective->getModel() == c->getPosition().getModel() &&
           !collective->getTerritory().contains(c->getPosition()))
-        for (auto pos : Random.permutation(collective->getTerritory().getAll()))
+        for (auto pos : collective->getRandom().permutation(collective->getTerritory().getAll()))
           if (pos.canEnter(c)) {
             c->getPosition().moveCreature(pos);
             break;
@@ -444,13 +444,13 @@ void VillageControl::update(bool currentlyActive) {
             c->getPosition().moveCreature(pos, true);
             break;
           }
-  if (isEnemy() && canPerformAttack() && Random.chance(updateFreq) && behaviour) {
+  if (isEnemy() && canPerformAttack() && collective->getRandom().chance(updateFreq) && behaviour) {
     auto enemy = getEnemyCollective();
     maxEnemyPower = max(maxEnemyPower, enemy->getDangerLevel());
     double prob = behaviour->getAttackProbability(this) / updateFreq;
-    if (Random.chance(prob)) {
+    if (collective->getRandom().chance(prob)) {
       bool duel = !collective->getLeaders().empty() && enemy->getLeaders().size() == 1 &&
-          Random.chance(behaviour->duelChance);
+          collective->getRandom().chance(behaviour->duelChance);
       auto attackers = getAttackers();
       if (!attackers.empty()) {
         if (duel && !attackers.contains(collective->getLeaders()[0]))
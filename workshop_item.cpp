@@ -16,7 +16,7 @@ WorkshopItem WorkshopItemCfg::get(WorkshopType type, const ContentFactory* facto
   PROFILE;
   // for some reason removing this line causes a linker error, probably a compiler bug
   auto t = tech;
-  PItem elem = item.get(factory);
+  PItem elem = item.get(Random, factory);
   auto& workshopInfo = factory->workshopInfo.at(type);
   if (auto& prefix = workshopInfo.prefix)
     elem->applyPrefix(*prefix, factory);
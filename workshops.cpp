@@ -117,7 +117,7 @@ PItem Workshops::Type::addWork(Collective* collective, double amount, int skillA
         workDone -= product.state - 1;
       if (product.state >= 1) {
         auto factory = collective->getGame()->getContentFactory();
-        auto ret = product.item.type.get(factory);
+        auto ret = product.item.type.get(collective->getRandom(), factory);
         if (prefix)
           ret->applyPrefix(*prefix, factory);
         ret->upgrade(std::move(product.runes), factory);